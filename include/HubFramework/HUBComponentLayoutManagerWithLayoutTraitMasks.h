@@ -0,0 +1,103 @@
+/*
+ *  Copyright (c) 2016 Spotify AB.
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ */
+
+#import "HUBComponentLayoutManager.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Extended component layout manager protocol that adds the ability to compute margins using layout trait bitmasks
+ *
+ *  Conform to this protocol in your application's component layout manager to avoid the cost of looking up layout traits
+ *  in sets when computing layouts. The Hub Framework converts the layout traits of each component into a bitmask once per
+ *  layout computation, and then calls the methods of this protocol instead of the ones taking sets of layout traits.
+ *
+ *  The methods taking sets of layout traits are still called whenever any of the involved components has a custom layout
+ *  trait (one that isn't built into the Hub Framework), since those can't be represented in a bitmask. For more info,
+ *  see `HUBComponentLayoutManager` and `HUBComponentLayoutTraitMask`.
+ */
+@protocol HUBComponentLayoutManagerWithLayoutTraitMasks <HUBComponentLayoutManager>
+
+/**
+ *  Return the margin to use between a component with a layout trait mask and a content edge
+ *
+ *  @param layoutTraitMask The layout trait mask of the component to compute a margin for
+ *  @param contentEdge The content edge to compute the margin to
+ *
+ *  The mask variant of `-marginBetweenComponentWithLayoutTraits:andContentEdge:`.
+ */
+- (CGFloat)marginBetweenComponentWithLayoutTraitMask:(HUBComponentLayoutTraitMask)layoutTraitMask
+                                      andContentEdge:(HUBComponentLayoutContentEdge)contentEdge;
+
+/**
+ *  Return the vertical margin to use between a body component and a header component
+ *
+ *  @param layoutTraitMask The layout trait mask of the body component
+ *  @param headerLayoutTraitMask The layout trait mask of the header component
+ *
+ *  The mask variant of `-verticalMarginBetweenComponentWithLayoutTraits:andHeaderComponentWithLayoutTraits:`.
+ */
+- (CGFloat)verticalMarginBetweenComponentWithLayoutTraitMask:(HUBComponentLayoutTraitMask)layoutTraitMask
+                       andHeaderComponentWithLayoutTraitMask:(HUBComponentLayoutTraitMask)headerLayoutTraitMask;
+
+/**
+ *  Return the horizontal margin to use between two body components
+ *
+ *  @param layoutTraitMask The layout trait mask of the component to determine the margin for
+ *  @param precedingComponentLayoutTraitMask The layout trait mask of the component that precedes the current one horizontally
+ *
+ *  The mask variant of `-horizontalMarginForComponentWithLayoutTraits:precedingComponentLayoutTraits:`.
+ */
+- (CGFloat)horizontalMarginForComponentWithLayoutTraitMask:(HUBComponentLayoutTraitMask)layoutTraitMask
+                         precedingComponentLayoutTraitMask:(HUBComponentLayoutTraitMask)precedingComponentLayoutTraitMask;
+
+/**
+ *  Return the vertical margin to use between two body components
+ *
+ *  @param layoutTraitMask The layout trait mask of the component to determine the margin for
+ *  @param precedingComponentLayoutTraitMask The layout trait mask of the component that precedes the current one vertically
+ *
+ *  The mask variant of `-verticalMarginForComponentWithLayoutTraits:precedingComponentLayoutTraits:`.
+ */
+- (CGFloat)verticalMarginForComponentWithLayoutTraitMask:(HUBComponentLayoutTraitMask)layoutTraitMask
+                       precedingComponentLayoutTraitMask:(HUBComponentLayoutTraitMask)precedingComponentLayoutTraitMask;
+
+/**
+ *  Calculate the horizontal offset for a row of components represented by their layout trait masks
+ *
+ *  @param layoutTraitMasks A C array of the layout trait masks of all components on the row, in order
+ *  @param count The number of masks in the array
+ *  @param firstComponentLeadingOffsetX The leading horizontal offset of the first component in the sequence
+ *  @param lastComponentTrailingOffsetX The trailing horizontal offset of the last component in the sequence
+ *
+ *  The mask variant of `-horizontalOffsetForComponentsWithLayoutTraits:firstComponentLeadingHorizontalOffset:lastComponentTrailingHorizontalOffset:`.
+ *  The array is only valid for the duration of the call.
+ *
+ *  @return The value by which the horizontal origins of all components should be adjusted
+ */
+- (CGFloat)horizontalOffsetForComponentsWithLayoutTraitMasks:(const HUBComponentLayoutTraitMask *)layoutTraitMasks
+                                                       count:(NSUInteger)count
+                       firstComponentLeadingHorizontalOffset:(CGFloat)firstComponentLeadingOffsetX
+                       lastComponentTrailingHorizontalOffset:(CGFloat)lastComponentTrailingOffsetX;
+
+@end
+
+NS_ASSUME_NONNULL_END
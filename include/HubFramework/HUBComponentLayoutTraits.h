@@ -53,4 +53,59 @@ static HUBComponentLayoutTrait const HUBComponentLayoutTraitCentered = @"centere
 /// Layout trait for components which are stackable on top of each other, without any margin in between, regardless of the layout traits the preceding component has
 static HUBComponentLayoutTrait const HUBComponentLayoutTraitAlwaysStackUpwards = @"alwaysStackUpwards";
 
+/**
+ *  Bitmask representation of a set of layout traits
+ *
+ *  Each built-in layout trait is represented by a bit, making it cheap to check whether a set of layout traits contains
+ *  a given trait. Custom layout traits declared by an application can't be represented this way, so any set containing
+ *  such traits has the `HUBComponentLayoutTraitMaskCustom` bit set. Use `HUBComponentLayoutTraitMaskFromLayoutTraits()`
+ *  to convert a set of layout traits into a mask.
+ */
+typedef NS_OPTIONS(NSUInteger, HUBComponentLayoutTraitMask) {
+    /// No layout traits
+    HUBComponentLayoutTraitMaskNone = 0,
+    /// Mask bit for `HUBComponentLayoutTraitCompactWidth`
+    HUBComponentLayoutTraitMaskCompactWidth = 1 << 0,
+    /// Mask bit for `HUBComponentLayoutTraitFullWidth`
+    HUBComponentLayoutTraitMaskFullWidth = 1 << 1,
+    /// Mask bit for `HUBComponentLayoutTraitStackable`
+    HUBComponentLayoutTraitMaskStackable = 1 << 2,
+    /// Mask bit for `HUBComponentLayoutTraitCentered`
+    HUBComponentLayoutTraitMaskCentered = 1 << 3,
+    /// Mask bit for `HUBComponentLayoutTraitAlwaysStackUpwards`
+    HUBComponentLayoutTraitMaskAlwaysStackUpwards = 1 << 4,
+    /// Mask bit set if the layout traits contain any trait that isn't built into the Hub Framework
+    HUBComponentLayoutTraitMaskCustom = 1 << 5
+};
+
+/**
+ *  Convert a set of layout traits into a bitmask
+ *
+ *  @param layoutTraits The set of layout traits to convert
+ *
+ *  Any traits that aren't built into the Hub Framework are represented by the `HUBComponentLayoutTraitMaskCustom` bit.
+ */
+static inline HUBComponentLayoutTraitMask HUBComponentLayoutTraitMaskFromLayoutTraits(NSSet<HUBComponentLayoutTrait> *layoutTraits)
+{
+    HUBComponentLayoutTraitMask mask = HUBComponentLayoutTraitMaskNone;
+    
+    for (HUBComponentLayoutTrait const layoutTrait in layoutTraits) {
+        if ([layoutTrait isEqualToString:HUBComponentLayoutTraitCompactWidth]) {
+            mask |= HUBComponentLayoutTraitMaskCompactWidth;
+        } else if ([layoutTrait isEqualToString:HUBComponentLayoutTraitFullWidth]) {
+            mask |= HUBComponentLayoutTraitMaskFullWidth;
+        } else if ([layoutTrait isEqualToString:HUBComponentLayoutTraitStackable]) {
+            mask |= HUBComponentLayoutTraitMaskStackable;
+        } else if ([layoutTrait isEqualToString:HUBComponentLayoutTraitCentered]) {
+            mask |= HUBComponentLayoutTraitMaskCentered;
+        } else if ([layoutTrait isEqualToString:HUBComponentLayoutTraitAlwaysStackUpwards]) {
+            mask |= HUBComponentLayoutTraitMaskAlwaysStackUpwards;
+        } else {
+            mask |= HUBComponentLayoutTraitMaskCustom;
+        }
+    }
+    
+    return mask;
+}
+
 NS_ASSUME_NONNULL_END
@@ -119,4 +119,38 @@ NS_ASSUME_NONNULL_BEGIN
 
 @end
 
+/**
+ *  Extended Hub component protocol that adds the ability to update child components in place
+ *
+ *  Use this protocol if your component has children and is able to apply changes to them incrementally,
+ *  for example by performing batch updates on a nested collection view. When a new view model is rendered
+ *  and the only changes to a component's model were made to its children, the Hub Framework will send
+ *  this protocol's method instead of reconfiguring the component, so that only the changed children need
+ *  to be updated. Components that don't conform to this protocol are always reconfigured.
+ */
+@protocol HUBComponentWithChildUpdates <HUBComponentWithChildren>
+
+/**
+ *  Update the component's view for a set of changes to its children
+ *
+ *  @param model The new model of the component. Its properties are equal to those of the model that the component is
+ *         currently configured with, except for its children.
+ *  @param insertedChildIndexes The indexes of any children that were inserted, in the new model's `children` array
+ *  @param deletedChildIndexes The indexes of any children that were deleted, in the previous model's `children` array
+ *  @param reloadedChildIndexes The indexes of any children that were modified, in the previous model's `children` array
+ *  @param movedChildIndexes The indexes of any children that were moved without being modified, mapping their index in
+ *         the previous model's `children` array to their index in the new model's one
+ *
+ *  The indexes follow the same semantics as the ones used by `UICollectionView` batch updates, so they may be applied
+ *  directly to a nested collection view. Any child components that were created through the `childDelegate` for
+ *  unchanged children remain valid, while children that were deleted or reloaded should be recreated as needed.
+ */
+- (void)updateViewForChildChangesInModel:(id<HUBComponentModel>)model
+                    insertedChildIndexes:(NSIndexSet *)insertedChildIndexes
+                     deletedChildIndexes:(NSIndexSet *)deletedChildIndexes
+                    reloadedChildIndexes:(NSIndexSet *)reloadedChildIndexes
+                       movedChildIndexes:(NSDictionary<NSNumber *, NSNumber *> *)movedChildIndexes;
+
+@end
+
 NS_ASSUME_NONNULL_END
@@ -0,0 +1,42 @@
+/*
+ *  Copyright (c) 2016 Spotify AB.
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ */
+
+#import "HUBComponent.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Extended Hub component protocol that declares that the layout of a component depends on the content offset
+ *
+ *  The Hub Framework doesn't invalidate the layout of a view when the user scrolls vertically, since the frames of
+ *  components don't change when scrolling. While a view contains a component conforming to this protocol, the layout
+ *  is instead invalidated on every content offset change, so that the component can be laid out again as the user
+ *  scrolls.
+ *
+ *  Only conform to this protocol if your component really needs it, since invalidating the layout while scrolling has
+ *  a performance cost. To simply be notified of content offset changes, conform to `HUBComponentContentOffsetObserver`
+ *  instead. See `HUBComponent` for more info.
+ */
+@protocol HUBComponentWithContentOffsetDependentLayout <HUBComponent>
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,38 @@
+/*
+ *  Copyright (c) 2016 Spotify AB.
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ */
+
+#import "HUBComponent.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Extended Hub component protocol that opts a component out of having its preferred view sizes cached
+ *
+ *  The Hub Framework caches the sizes returned from `-preferredViewSizeForDisplayingModel:containerViewSize:`,
+ *  based on the component, the content of the model and the size of the container view. Conform to this protocol
+ *  if the preferred view size of your component also depends on other state (such as user settings), to make the
+ *  Hub Framework ask for its preferred view size every time a layout is computed. See `HUBComponent` for more info.
+ */
+@protocol HUBComponentWithDynamicSize <HUBComponent>
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,43 @@
+/*
+ *  Copyright (c) 2016 Spotify AB.
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ */
+
+#import "HUBComponent.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Extended Hub component protocol that declares that the size calculation of a component is thread safe
+ *
+ *  The Hub Framework computes the layout of a view on the main queue by default. When all components used by a view
+ *  conform to this protocol, the layout may instead be computed on a background queue when a view model is rendered
+ *  using batch updates, keeping the main queue free while components are measured.
+ *
+ *  Conform to this protocol if your component's implementation of `-preferredViewSizeForDisplayingModel:containerViewSize:`
+ *  and `layoutTraits` is safe to call from any queue, which means that it shouldn't use any UIKit objects that are only
+ *  safe to use on the main queue, such as the component's view. Note that the component layout manager used by the
+ *  application is then also called from a background queue, so it needs to be thread safe too. Components conforming to
+ *  `HUBComponentWithChildren` always have their layout computed on the main queue. See `HUBComponent` for more info.
+ */
+@protocol HUBComponentWithThreadSafeSize <HUBComponent>
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -75,6 +75,9 @@
 #import "HUBComponentWithRestorableUIState.h"
 #import "HUBComponentWithSelectionState.h"
 #import "HUBComponentContentOffsetObserver.h"
+#import "HUBComponentWithDynamicSize.h"
+#import "HUBComponentWithThreadSafeSize.h"
+#import "HUBComponentWithContentOffsetDependentLayout.h"
 #import "HUBComponentViewObserver.h"
 #import "HUBComponentActionObserver.h"
 #import "HUBComponentActionPerformer.h"
@@ -90,6 +93,7 @@
 #import "HUBComponentTargetBuilder.h"
 #import "HUBComponentRegistry.h"
 #import "HUBComponentLayoutManager.h"
+#import "HUBComponentLayoutManagerWithLayoutTraitMasks.h"
 #import "HUBComponentLayoutTraits.h"
 #import "HUBComponentCategories.h"
 #import "HUBComponentFallbackHandler.h"
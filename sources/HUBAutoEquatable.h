@@ -26,10 +26,16 @@ NS_ASSUME_NONNULL_BEGIN
 /**
  *  Abstract base class for types that are automatically checked for equality
  *
- *  This class implements `-isEqual:` using reflection and KVC, and determines whether
- *  two instances of the same class are equal by inspecting each individual key/value
- *  and checking them for equality. Two objects are only considered equal if all their
- *  key/value pairs are equal.
+ *  This class implements `-isEqual:` using reflection, and determines whether two
+ *  instances of the same class are equal by inspecting each individual property and
+ *  checking them for equality. Two objects are only considered equal if all their
+ *  properties are equal. The getters and types of the properties are resolved once
+ *  per class, so that scalar properties can be compared without boxing them.
+ *
+ *  The hash of an instance is consistent with its equality, and covers the same properties,
+ *  including the contents of any collections. It's computed the first time it's requested and
+ *  then cached, which lets `-isEqual:` detect most unequal objects without comparing each
+ *  property. Subclasses must therefore be immutable once they've been hashed or compared.
  *
  *  This class should be used as a superclass only for classes that rely on correctness
  *  and completeness for their equality checks, such as component models. Since the way
@@ -46,6 +52,26 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (nullable NSSet<NSString *> *)ignoredAutoEquatablePropertyNames;
 
+/**
+ *  Return any property names that are compared first when performing automatic equality checks
+ *
+ *  The default implementation of this method returns `nil`, which compares scalar properties
+ *  first and collections last. Override in subclasses that have properties which are both
+ *  cheap to compare and likely to differ, so that unequal objects are detected early.
+ */
++ (nullable NSArray<NSString *> *)prioritizedAutoEquatablePropertyNames;
+
+/**
+ *  Return whether this object is equal to another one, without comparing a set of properties
+ *
+ *  @param object The object to compare this object to
+ *  @param propertyNames The names of any properties that should not be compared, in addition
+ *         to the ones returned from `+ignoredAutoEquatablePropertyNames`
+ *
+ *  This can be used to determine whether two objects only differ in certain properties.
+ */
+- (BOOL)isEqual:(id)object ignoringPropertyNames:(NSSet<NSString *> *)propertyNames;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -21,17 +21,31 @@
 
 #import "HUBAutoEquatable.h"
 
-#import <objc/runtime.h>
+#import <stdatomic.h>
 
-#import "HUBUtilities.h"
+#import "HUBAutoEquatableComparator.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
-typedef BOOL(^HUBAutoEquatableComparisonBlock)(NSObject *, NSObject *);
-typedef NSDictionary<NSString *, HUBAutoEquatableComparisonBlock> HUBAutoEquatableComparisonMap;
-typedef NSMutableDictionary<NSString *, HUBAutoEquatableComparisonBlock> HUBAutoEquatableMutableComparisonMap;
+/**
+ *  The comparators that have been created so far, keyed by class
+ *
+ *  The dictionary is an immutable snapshot that is replaced whenever a comparator is added, so
+ *  that it can be read from any thread without taking a lock. Only creating a comparator, which
+ *  happens once per class, is synchronized.
+ */
+static _Atomic(CFDictionaryRef) HUBAutoEquatableComparatorsForClasses = NULL;
 
 @implementation HUBAutoEquatable
+{
+    /**
+     *  The lazily computed hash of this object, or 0 if it hasn't been computed yet
+     *
+     *  Models are hashed from any thread, for example while being diffed in the background. Threads racing to compute the
+     *  hash all compute the same value, so relaxed atomic accesses are enough to make sure that it's never torn.
+     */
+    _Atomic(NSUInteger) _cachedHash;
+}
 
 #pragma mark - Class methods
 
@@ -40,73 +54,104 @@ typedef NSMutableDictionary<NSString *, HUBAutoEquatableComparisonBlock> HUBAuto
     return nil;
 }
 
++ (nullable NSArray<NSString *> *)prioritizedAutoEquatablePropertyNames
+{
+    return nil;
+}
+
+#pragma mark - API
+
+- (BOOL)isEqual:(id)object ignoringPropertyNames:(NSSet<NSString *> *)propertyNames
+{
+    if (![object isKindOfClass:[self class]]) {
+        return NO;
+    }
+    
+    return [[self getOrCreateComparator] isObject:self equalToObject:object ignoringPropertyNames:propertyNames];
+}
+
 #pragma mark - NSObject
 
 - (BOOL)isEqual:(id)object
 {
+    if (object == self) {
+        return YES;
+    }
+    
     if (![object isKindOfClass:[self class]]) {
         return NO;
     }
     
-    HUBAutoEquatableComparisonMap * const comparisonMap = [self getOrCreateComparisonMap];
+    // Objects of the same class with different hashes can't be equal, so the deep comparison can be skipped
+    if ([object class] == [self class] && [object hash] != self.hash) {
+        return NO;
+    }
     
-    for (NSString * const propertyName in comparisonMap) {
-        if (!comparisonMap[propertyName](self, object)) {
-            return NO;
-        }
+    return [[self getOrCreateComparator] isObject:self equalToObject:object ignoringPropertyNames:nil];
+}
+
+- (NSUInteger)hash
+{
+    NSUInteger hash = atomic_load_explicit(&_cachedHash, memory_order_relaxed);
+    
+    if (hash == 0) {
+        // Zero is reserved for hashes that haven't been computed yet
+        hash = MAX([[self getOrCreateComparator] hashForObject:self], (NSUInteger)1);
+        atomic_store_explicit(&_cachedHash, hash, memory_order_relaxed);
     }
     
-    return YES;
+    return hash;
 }
 
 #pragma mark - Private utilities
 
-- (HUBAutoEquatableComparisonMap *)getOrCreateComparisonMap
+- (HUBAutoEquatableComparator *)getOrCreateComparator
 {
-    static NSMutableDictionary<NSString *, HUBAutoEquatableComparisonMap *> *comparisonMapsForClassNames = nil;
+    Class const objectClass = [self class];
+    CFDictionaryRef const comparators = atomic_load_explicit(&HUBAutoEquatableComparatorsForClasses, memory_order_acquire);
     
-    if (comparisonMapsForClassNames == nil) {
-        comparisonMapsForClassNames = [NSMutableDictionary new];
+    if (comparators != NULL) {
+        HUBAutoEquatableComparator * const comparator = (__bridge HUBAutoEquatableComparator *)CFDictionaryGetValue(comparators, (__bridge const void *)objectClass);
+        
+        if (comparator != nil) {
+            return comparator;
+        }
     }
     
-    NSString * const className = NSStringFromClass([self class]);
-    
-    HUBAutoEquatableComparisonMap *comparisonMap = comparisonMapsForClassNames[className];
-    
-    if (comparisonMap == nil) {
-        NSSet<NSString *> * const ignoredPropertyNames = [[self class] ignoredAutoEquatablePropertyNames];
-        HUBAutoEquatableMutableComparisonMap * const mutableComparisonMap = [HUBAutoEquatableMutableComparisonMap new];
-        
-        unsigned int propertyCount;
-        objc_property_t *propertyList = class_copyPropertyList([self class], &propertyCount);
+    return [HUBAutoEquatable createComparatorForClass:objectClass];
+}
+
++ (HUBAutoEquatableComparator *)createComparatorForClass:(Class)objectClass
+{
+    @synchronized ([HUBAutoEquatable class]) {
+        CFDictionaryRef const comparators = atomic_load_explicit(&HUBAutoEquatableComparatorsForClasses, memory_order_acquire);
         
-        for (unsigned int i = 0; i < propertyCount; i++) {
-            const objc_property_t property = propertyList[i];
-            const char * propertyNameCString = property_getName(property);
-            NSString * const propertyName = [NSString stringWithUTF8String:propertyNameCString];
+        // Another thread may have created the comparator while this one was waiting for the lock
+        if (comparators != NULL) {
+            HUBAutoEquatableComparator * const comparator = (__bridge HUBAutoEquatableComparator *)CFDictionaryGetValue(comparators, (__bridge const void *)objectClass);
             
-            if (protocol_getProperty(@protocol(NSObject), propertyNameCString, YES, YES) != NULL) {
-                continue;
+            if (comparator != nil) {
+                return comparator;
             }
-            
-            if ([ignoredPropertyNames containsObject:propertyName]) {
-                continue;
-            }
-            
-            mutableComparisonMap[propertyName] = ^(NSObject * const objectA, NSObject * const objectB) {
-                return HUBPropertyIsEqual(objectA, objectB, propertyName);
-            };
-        }
-
-        if (propertyList) {
-            free(propertyList);
         }
         
-        comparisonMap = mutableComparisonMap;
-        comparisonMapsForClassNames[className] = comparisonMap;
+        HUBAutoEquatableComparator * const comparator = [[HUBAutoEquatableComparator alloc] initWithClass:objectClass
+                                                                                     ignoredPropertyNames:[objectClass ignoredAutoEquatablePropertyNames]
+                                                                                 prioritizedPropertyNames:[objectClass prioritizedAutoEquatablePropertyNames]];
+        
+        // Classes are never deallocated, so they're used as keys without being retained
+        CFMutableDictionaryRef const updatedComparators = (comparators != NULL)
+            ? CFDictionaryCreateMutableCopy(kCFAllocatorDefault, 0, comparators)
+            : CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+        
+        CFDictionarySetValue(updatedComparators, (__bridge const void *)objectClass, (__bridge const void *)comparator);
+        
+        // The previous snapshot is never released, since other threads may still be reading from it without a lock.
+        // This only leaks a small dictionary per auto equatable class.
+        atomic_store_explicit(&HUBAutoEquatableComparatorsForClasses, updatedComparators, memory_order_release);
+        
+        return comparator;
     }
-    
-    return comparisonMap;
 }
 
 @end
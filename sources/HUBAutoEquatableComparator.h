@@ -0,0 +1,70 @@
+/*
+ *  Copyright (c) 2016 Spotify AB.
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ */
+
+#import "HUBHeaderMacros.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Class that compares the properties of two instances of a given class for equality
+ *
+ *  A comparator resolves the getter implementation and type of each property of its class once, when it's created, so
+ *  that comparisons can call the getters directly and compare scalar values without boxing them through KVC. Properties
+ *  are compared in order of how cheap they are to compare, so that unequal objects are detected as early as possible.
+ *
+ *  This class is used by `HUBAutoEquatable`, which creates one comparator per class.
+ */
+@interface HUBAutoEquatableComparator : NSObject
+
+/**
+ *  Initialize an instance of this class with a class to compare instances of
+ *
+ *  @param objectClass The class to compare instances of. All properties declared by the class are compared, except the
+ *         ones declared by the `NSObject` protocol.
+ *  @param ignoredPropertyNames The names of any properties that should not be compared.
+ *  @param prioritizedPropertyNames The names of any properties that should be compared before all others, in order.
+ */
+- (instancetype)initWithClass:(Class)objectClass
+         ignoredPropertyNames:(nullable NSSet<NSString *> *)ignoredPropertyNames
+     prioritizedPropertyNames:(nullable NSArray<NSString *> *)prioritizedPropertyNames HUB_DESIGNATED_INITIALIZER;
+
+/**
+ *  Return whether two objects are equal
+ *
+ *  @param objectA The first object, which must be an instance of the comparator's class
+ *  @param objectB The second object, which must be an instance of the comparator's class or one of its subclasses
+ *  @param ignoredPropertyNames The names of any properties that should not be compared in this comparison
+ */
+- (BOOL)isObject:(id)objectA equalToObject:(id)objectB ignoringPropertyNames:(nullable NSSet<NSString *> *)ignoredPropertyNames;
+
+/**
+ *  Return a hash of the compared properties of an object
+ *
+ *  @param object The object to hash, which must be an instance of the comparator's class
+ *
+ *  Objects that are equal according to this comparator always have the same hash. The values of collection properties
+ *  are hashed by their contents, so the hash is expensive to compute for objects with large collections.
+ */
+- (NSUInteger)hashForObject:(id)object;
+
+@end
+
+NS_ASSUME_NONNULL_END
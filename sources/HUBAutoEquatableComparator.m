@@ -0,0 +1,434 @@
+/*
+ *  Copyright (c) 2016 Spotify AB.
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ */
+
+#import "HUBAutoEquatableComparator.h"
+
+#import <objc/runtime.h>
+
+#import "HUBUtilities.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// The ways in which the values of a property can be compared
+typedef NS_ENUM(NSUInteger, HUBAutoEquatablePropertyKind) {
+    /// The property is an object, compared using `-isEqual:`
+    HUBAutoEquatablePropertyKindObject,
+    /// The property is a 1 byte integer, such as a `BOOL`
+    HUBAutoEquatablePropertyKindInteger8,
+    /// The property is a 2 byte integer
+    HUBAutoEquatablePropertyKindInteger16,
+    /// The property is a 4 byte integer
+    HUBAutoEquatablePropertyKindInteger32,
+    /// The property is an 8 byte integer, such as an `NSUInteger` on 64 bit platforms
+    HUBAutoEquatablePropertyKindInteger64,
+    /// The property is a `float`
+    HUBAutoEquatablePropertyKindFloat,
+    /// The property is a `double`
+    HUBAutoEquatablePropertyKindDouble,
+    /// The property can't be read directly, for example because it's a struct, so KVC is used to compare it
+    HUBAutoEquatablePropertyKindKeyValueCoding
+};
+
+/// The cost of comparing a property, used to compare the cheapest properties first
+typedef NS_ENUM(NSUInteger, HUBAutoEquatablePropertyCost) {
+    HUBAutoEquatablePropertyCostScalar,
+    HUBAutoEquatablePropertyCostValueObject,
+    HUBAutoEquatablePropertyCostObject,
+    HUBAutoEquatablePropertyCostCollection,
+    HUBAutoEquatablePropertyCostKeyValueCoding
+};
+
+/// A property that has been resolved for comparison
+typedef struct {
+    __unsafe_unretained NSString *name;
+    SEL getter;
+    IMP implementation;
+    HUBAutoEquatablePropertyKind kind;
+    NSUInteger cost;
+} HUBAutoEquatableProperty;
+
+static HUBAutoEquatablePropertyKind HUBAutoEquatablePropertyKindForTypeEncoding(const char *typeEncoding) {
+    switch (typeEncoding[0]) {
+        case _C_ID:
+            return HUBAutoEquatablePropertyKindObject;
+        case _C_FLT:
+            return HUBAutoEquatablePropertyKindFloat;
+        case _C_DBL:
+            return HUBAutoEquatablePropertyKindDouble;
+        case _C_CHR:
+        case _C_UCHR:
+        case _C_BOOL:
+        case _C_SHT:
+        case _C_USHT:
+        case _C_INT:
+        case _C_UINT:
+        case _C_LNG:
+        case _C_ULNG:
+        case _C_LNG_LNG:
+        case _C_ULNG_LNG: {
+            NSUInteger size = 0;
+            NSGetSizeAndAlignment(typeEncoding, &size, NULL);
+
+            switch (size) {
+                case 1:
+                    return HUBAutoEquatablePropertyKindInteger8;
+                case 2:
+                    return HUBAutoEquatablePropertyKindInteger16;
+                case 4:
+                    return HUBAutoEquatablePropertyKindInteger32;
+                case 8:
+                    return HUBAutoEquatablePropertyKindInteger64;
+                default:
+                    return HUBAutoEquatablePropertyKindKeyValueCoding;
+            }
+        }
+        default:
+            return HUBAutoEquatablePropertyKindKeyValueCoding;
+    }
+}
+
+static HUBAutoEquatablePropertyCost HUBAutoEquatablePropertyCostForTypeEncoding(const char *typeEncoding, HUBAutoEquatablePropertyKind kind) {
+    if (kind == HUBAutoEquatablePropertyKindKeyValueCoding) {
+        return HUBAutoEquatablePropertyCostKeyValueCoding;
+    }
+
+    if (kind != HUBAutoEquatablePropertyKindObject) {
+        return HUBAutoEquatablePropertyCostScalar;
+    }
+
+    // Object properties are encoded as @"ClassName", or @"<ProtocolName>" for protocol types
+    NSString * const encoding = [NSString stringWithUTF8String:typeEncoding];
+
+    if (encoding.length < 4 || [encoding characterAtIndex:2] == '<') {
+        return HUBAutoEquatablePropertyCostObject;
+    }
+
+    Class const valueClass = NSClassFromString([encoding substringWithRange:NSMakeRange(2, encoding.length - 3)]);
+
+    if ([valueClass isSubclassOfClass:[NSArray class]]
+        || [valueClass isSubclassOfClass:[NSDictionary class]]
+        || [valueClass isSubclassOfClass:[NSSet class]]) {
+        return HUBAutoEquatablePropertyCostCollection;
+    }
+
+    if ([valueClass isSubclassOfClass:[NSString class]]
+        || [valueClass isSubclassOfClass:[NSNumber class]]
+        || [valueClass isSubclassOfClass:[NSURL class]]
+        || [valueClass isSubclassOfClass:[NSDate class]]) {
+        return HUBAutoEquatablePropertyCostValueObject;
+    }
+
+    return HUBAutoEquatablePropertyCostObject;
+}
+
+static BOOL HUBAutoEquatablePropertyIsEqual(const HUBAutoEquatableProperty *property, id objectA, id objectB) {
+    SEL const getter = property->getter;
+
+    switch (property->kind) {
+        case HUBAutoEquatablePropertyKindObject: {
+            id (* const getValue)(id, SEL) = (id (*)(id, SEL))property->implementation;
+            id const valueA = getValue(objectA, getter);
+            id const valueB = getValue(objectB, getter);
+            return valueA == valueB || [valueA isEqual:valueB];
+        }
+        case HUBAutoEquatablePropertyKindInteger8: {
+            int8_t (* const getValue)(id, SEL) = (int8_t (*)(id, SEL))property->implementation;
+            return getValue(objectA, getter) == getValue(objectB, getter);
+        }
+        case HUBAutoEquatablePropertyKindInteger16: {
+            int16_t (* const getValue)(id, SEL) = (int16_t (*)(id, SEL))property->implementation;
+            return getValue(objectA, getter) == getValue(objectB, getter);
+        }
+        case HUBAutoEquatablePropertyKindInteger32: {
+            int32_t (* const getValue)(id, SEL) = (int32_t (*)(id, SEL))property->implementation;
+            return getValue(objectA, getter) == getValue(objectB, getter);
+        }
+        case HUBAutoEquatablePropertyKindInteger64: {
+            int64_t (* const getValue)(id, SEL) = (int64_t (*)(id, SEL))property->implementation;
+            return getValue(objectA, getter) == getValue(objectB, getter);
+        }
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wfloat-equal"
+        case HUBAutoEquatablePropertyKindFloat: {
+            float (* const getValue)(id, SEL) = (float (*)(id, SEL))property->implementation;
+            return getValue(objectA, getter) == getValue(objectB, getter);
+        }
+        case HUBAutoEquatablePropertyKindDouble: {
+            double (* const getValue)(id, SEL) = (double (*)(id, SEL))property->implementation;
+            return getValue(objectA, getter) == getValue(objectB, getter);
+        }
+#pragma clang diagnostic pop
+        case HUBAutoEquatablePropertyKindKeyValueCoding:
+            return HUBPropertyIsEqual(objectA, objectB, property->name);
+    }
+}
+
+/// Mix the bits of a hash value, so that combining hashes of similar values doesn't produce collisions
+static inline uint64_t HUBAutoEquatableMixHash(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+/**
+ *  Return a hash of a property value that is consistent with `-isEqual:`
+ *
+ *  Foundation collections only hash their count, so they are hashed by their contents instead. Dictionaries and sets
+ *  combine the hashes of their entries in an order independent way, since they are equal regardless of order.
+ */
+static uint64_t HUBAutoEquatableValueHash(id _Nullable value) {
+    if (value == nil) {
+        return 0;
+    }
+
+    if ([value isKindOfClass:[NSArray class]]) {
+        uint64_t hash = [(NSArray *)value count];
+
+        for (id const element in (NSArray *)value) {
+            hash = hash * 31 + HUBAutoEquatableValueHash(element);
+        }
+
+        return hash;
+    }
+
+    if ([value isKindOfClass:[NSDictionary class]]) {
+        NSDictionary * const dictionary = value;
+        __block uint64_t hash = dictionary.count;
+
+        [dictionary enumerateKeysAndObjectsUsingBlock:^(id key, id object, BOOL *stop) {
+            hash += HUBAutoEquatableMixHash(HUBAutoEquatableMixHash([key hash]) ^ HUBAutoEquatableValueHash(object));
+        }];
+
+        return hash;
+    }
+
+    if ([value isKindOfClass:[NSSet class]]) {
+        uint64_t hash = [(NSSet *)value count];
+
+        for (id const element in (NSSet *)value) {
+            hash += HUBAutoEquatableMixHash(HUBAutoEquatableValueHash(element));
+        }
+
+        return hash;
+    }
+
+    return [value hash];
+}
+
+static uint64_t HUBAutoEquatablePropertyHash(const HUBAutoEquatableProperty *property, id object) {
+    SEL const getter = property->getter;
+
+    switch (property->kind) {
+        case HUBAutoEquatablePropertyKindObject: {
+            id (* const getValue)(id, SEL) = (id (*)(id, SEL))property->implementation;
+            return HUBAutoEquatableValueHash(getValue(object, getter));
+        }
+        case HUBAutoEquatablePropertyKindInteger8: {
+            int8_t (* const getValue)(id, SEL) = (int8_t (*)(id, SEL))property->implementation;
+            return (uint64_t)getValue(object, getter);
+        }
+        case HUBAutoEquatablePropertyKindInteger16: {
+            int16_t (* const getValue)(id, SEL) = (int16_t (*)(id, SEL))property->implementation;
+            return (uint64_t)getValue(object, getter);
+        }
+        case HUBAutoEquatablePropertyKindInteger32: {
+            int32_t (* const getValue)(id, SEL) = (int32_t (*)(id, SEL))property->implementation;
+            return (uint64_t)getValue(object, getter);
+        }
+        case HUBAutoEquatablePropertyKindInteger64: {
+            int64_t (* const getValue)(id, SEL) = (int64_t (*)(id, SEL))property->implementation;
+            return (uint64_t)getValue(object, getter);
+        }
+        case HUBAutoEquatablePropertyKindFloat: {
+            float (* const getValue)(id, SEL) = (float (*)(id, SEL))property->implementation;
+            return @(getValue(object, getter)).hash;
+        }
+        case HUBAutoEquatablePropertyKindDouble: {
+            double (* const getValue)(id, SEL) = (double (*)(id, SEL))property->implementation;
+            return @(getValue(object, getter)).hash;
+        }
+        case HUBAutoEquatablePropertyKindKeyValueCoding:
+            return HUBAutoEquatableValueHash([object valueForKey:property->name]);
+    }
+}
+
+@interface HUBAutoEquatableComparator ()
+
+@property (nonatomic, strong, readonly) Class objectClass;
+@property (nonatomic, copy, readonly) NSArray<NSString *> *propertyNames;
+@property (nonatomic, assign, readonly) HUBAutoEquatableProperty *properties;
+@property (nonatomic, assign, readonly) NSUInteger propertyCount;
+
+@end
+
+@implementation HUBAutoEquatableComparator
+
+#pragma mark - Initializer
+
+- (instancetype)initWithClass:(Class)objectClass
+         ignoredPropertyNames:(nullable NSSet<NSString *> *)ignoredPropertyNames
+     prioritizedPropertyNames:(nullable NSArray<NSString *> *)prioritizedPropertyNames
+{
+    self = [super init];
+
+    if (self) {
+        unsigned int propertyCount;
+        objc_property_t * const propertyList = class_copyPropertyList(objectClass, &propertyCount);
+        NSMutableArray<NSString *> * const propertyNames = [NSMutableArray arrayWithCapacity:propertyCount];
+
+        _objectClass = objectClass;
+        _properties = calloc(MAX(propertyCount, 1u), sizeof(HUBAutoEquatableProperty));
+        NSAssert(_properties != NULL, @"Unable to allocate memory.");
+
+        for (unsigned int i = 0; i < propertyCount; i++) {
+            const objc_property_t property = propertyList[i];
+            const char * propertyNameCString = property_getName(property);
+            NSString * const propertyName = [NSString stringWithUTF8String:propertyNameCString];
+
+            if (protocol_getProperty(@protocol(NSObject), propertyNameCString, YES, YES) != NULL) {
+                continue;
+            }
+
+            if ([ignoredPropertyNames containsObject:propertyName]) {
+                continue;
+            }
+
+            [propertyNames addObject:propertyName];
+
+            HUBAutoEquatableProperty resolvedProperty = {
+                .name = propertyName,
+                .getter = NSSelectorFromString(propertyName),
+                .implementation = NULL,
+                .kind = HUBAutoEquatablePropertyKindKeyValueCoding,
+                .cost = HUBAutoEquatablePropertyCostKeyValueCoding
+            };
+
+            char * const customGetterName = property_copyAttributeValue(property, "G");
+
+            if (customGetterName != NULL) {
+                resolvedProperty.getter = sel_registerName(customGetterName);
+                free(customGetterName);
+            }
+
+            char * const typeEncoding = property_copyAttributeValue(property, "T");
+            Method const getterMethod = class_getInstanceMethod(objectClass, resolvedProperty.getter);
+
+            if (typeEncoding != NULL && getterMethod != NULL) {
+                resolvedProperty.implementation = method_getImplementation(getterMethod);
+                resolvedProperty.kind = HUBAutoEquatablePropertyKindForTypeEncoding(typeEncoding);
+                resolvedProperty.cost = HUBAutoEquatablePropertyCostForTypeEncoding(typeEncoding, resolvedProperty.kind);
+            }
+
+            if (typeEncoding != NULL) {
+                free(typeEncoding);
+            }
+
+            NSUInteger const priority = [prioritizedPropertyNames indexOfObject:propertyName];
+
+            if (priority == NSNotFound) {
+                resolvedProperty.cost += prioritizedPropertyNames.count;
+            } else {
+                resolvedProperty.cost = priority;
+            }
+
+            // Insert the property after all properties that are as cheap or cheaper to compare
+            NSUInteger insertionIndex = _propertyCount;
+
+            while (insertionIndex > 0 && _properties[insertionIndex - 1].cost > resolvedProperty.cost) {
+                _properties[insertionIndex] = _properties[insertionIndex - 1];
+                insertionIndex--;
+            }
+
+            _properties[insertionIndex] = resolvedProperty;
+            _propertyCount++;
+        }
+
+        if (propertyList) {
+            free(propertyList);
+        }
+
+        // The resolved properties don't retain their names, so they're kept alive here
+        _propertyNames = [propertyNames copy];
+    }
+
+    return self;
+}
+
+#pragma mark - API
+
+- (BOOL)isObject:(id)objectA equalToObject:(id)objectB ignoringPropertyNames:(nullable NSSet<NSString *> *)ignoredPropertyNames
+{
+    Class const objectClass = self.objectClass;
+    const HUBAutoEquatableProperty * const properties = self.properties;
+    NSUInteger const propertyCount = self.propertyCount;
+
+    // A subclass may override getters, so the resolved implementations can only be used for instances of the same class
+    BOOL const canUseImplementations = ([objectA class] == objectClass && [objectB class] == objectClass);
+
+    for (NSUInteger index = 0; index < propertyCount; index++) {
+        const HUBAutoEquatableProperty * const property = &properties[index];
+
+        if ([ignoredPropertyNames containsObject:property->name]) {
+            continue;
+        }
+
+        if (!canUseImplementations) {
+            if (!HUBPropertyIsEqual(objectA, objectB, property->name)) {
+                return NO;
+            }
+
+            continue;
+        }
+
+        if (!HUBAutoEquatablePropertyIsEqual(property, objectA, objectB)) {
+            return NO;
+        }
+    }
+
+    return YES;
+}
+
+- (NSUInteger)hashForObject:(id)object
+{
+    NSAssert([object class] == self.objectClass, @"Attempted to hash an object of another class than the comparator's: %@", object);
+
+    const HUBAutoEquatableProperty * const properties = self.properties;
+    NSUInteger const propertyCount = self.propertyCount;
+    uint64_t hash = propertyCount;
+
+    for (NSUInteger index = 0; index < propertyCount; index++) {
+        hash = hash * 31 + HUBAutoEquatableMixHash(HUBAutoEquatablePropertyHash(&properties[index], object));
+    }
+
+    return (NSUInteger)hash;
+}
+
+#pragma mark - NSObject
+
+- (void)dealloc
+{
+    free(_properties);
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -26,12 +26,37 @@
 @protocol HUBComponentLayoutManager;
 @protocol HUBComponentRegistry;
 @class HUBViewModelDiff;
+@class HUBCollectionViewLayoutCalculator;
+@class HUBCollectionViewLayoutSnapshot;
 
 NS_ASSUME_NONNULL_BEGIN
 
 /// Layout object used by collection views within the Hub Framework
 @interface HUBCollectionViewLayout : UICollectionViewLayout
 
+/**
+ *  Whether this layout only measures the components that are close to the visible part of the collection view
+ *
+ *  When enabled, components further away than the height of the collection view from its visible part are given the
+ *  size that was first measured for their component identifier, instead of being measured. As the user scrolls, the
+ *  components coming close to the visible part are measured, and the content offset is adjusted to keep the visible
+ *  content in place. This makes the cost of computing a layout for very long view models depend mostly on the size of
+ *  the collection view, rather than on the number of components. Default is `NO`.
+ */
+@property (nonatomic, assign, getter=isVirtualized) BOOL virtualized;
+
+/**
+ *  Whether this layout should be invalidated every time the content offset of the collection view changes
+ *
+ *  By default, the layout is only invalidated by bounds changes that change the width of the collection view, or that
+ *  bring components with estimated sizes close to the visible area, so that vertical scrolling doesn't cause any layout
+ *  work. Enable this if the layout of any component, for example a header component, depends on the content offset.
+ *
+ *  Regardless of this property, the layout is also invalidated on every content offset change while the view model it
+ *  was last computed for contains any component conforming to `HUBComponentWithContentOffsetDependentLayout`.
+ */
+@property (nonatomic, assign) BOOL invalidatesLayoutOnContentOffsetChange;
+
 /**
  *  Initialize an instance of this class with its required dependencies
  *
@@ -53,6 +78,84 @@ NS_ASSUME_NONNULL_BEGIN
                                 diff:(nullable HUBViewModelDiff *)diff
                      addHeaderMargin:(BOOL)addHeaderMargin;
 
+/**
+ *  Create a calculator that can compute this layout on a background queue
+ *
+ *  @param collectionViewSize The size of the collection view that will use this layout
+ *  @param viewModel The view model to compute the layout with
+ *  @param previousViewModel The view model that the diff passed to the calculator will be computed from, if any
+ *  @param addHeaderMargin Whether margin should be added to account for any header component
+ *
+ *  This method must be called on the main queue, since it creates any components needed for the view model. It returns
+ *  nil if any of those components doesn't conform to `HUBComponentWithThreadSafeSize`, or if any of them conforms to
+ *  `HUBComponentWithChildren`, in which case the layout has to be computed on the main queue. The returned calculator
+ *  may then be used on any queue, and the resulting snapshot committed to this layout using `applySnapshot:diff:`.
+ */
+- (nullable HUBCollectionViewLayoutCalculator *)backgroundCalculatorForCollectionViewSize:(CGSize)collectionViewSize
+                                                                                viewModel:(id<HUBViewModel>)viewModel
+                                                                        previousViewModel:(nullable id<HUBViewModel>)previousViewModel
+                                                                          addHeaderMargin:(BOOL)addHeaderMargin;
+
+/**
+ *  Commit a computed layout snapshot to this layout
+ *
+ *  @param snapshot The snapshot to commit, which will be used to answer all layout queries from now on
+ *  @param diff The diff between the view model of the previously committed snapshot and the one of the new snapshot
+ *
+ *  This method must be called on the main queue, at the same point as where `computeForCollectionViewSize:...` would
+ *  otherwise have been called (for example within a batch update).
+ */
+- (void)applySnapshot:(HUBCollectionViewLayoutSnapshot *)snapshot diff:(nullable HUBViewModelDiff *)diff;
+
+/**
+ *  Precompute this layout for other collection view sizes, using the view model that it was last computed for
+ *
+ *  @param collectionViewSizes The sizes to precompute the layout for, as `CGSize` values
+ *
+ *  The layouts are computed in the background if all components support it, and otherwise on the main queue, one at a
+ *  time, whenever its run loop is about to become idle outside of scrolling. Since frames only depend on the width of
+ *  the collection view, one layout is precomputed per width. When `computeForCollectionViewSize:...` is later called
+ *  with the same view model for a size with the same width as one of the sizes, the precomputed layout is committed
+ *  instead of computing a new one, assuming that the preferred view sizes of components don't depend on the height of
+ *  their container. Precomputed layouts are discarded once the layout is computed for another view model.
+ */
+- (void)precomputeForCollectionViewSizes:(NSArray<NSValue *> *)collectionViewSizes;
+
+/**
+ *  Precompute this layout for the sizes that its collection view is likely to be resized to
+ *
+ *  The likely sizes are the rotated size of the collection view, its size when as wide as the screen, and on iPad, its
+ *  size in split view next to an equally sized app. See `precomputeForCollectionViewSizes:` for more information.
+ */
+- (void)precomputeForLikelyCollectionViewSizes;
+
+/**
+ *  Cancel all precomputations of this layout that are waiting for the main run loop to become idle
+ *
+ *  Call this when a new view model is about to be rendered, since layouts precomputed for the current view model will
+ *  be discarded once the new one is rendered anyway.
+ */
+- (void)cancelPendingPrecomputations;
+
+/**
+ *  Remove all cached preferred component view sizes, along with any layouts computed using them
+ *
+ *  The next time this layout is computed, all components are asked for their preferred view sizes again. This is done
+ *  automatically when the preferred content size category changes, and should be done whenever anything else that
+ *  components base their preferred view sizes on changes.
+ */
+- (void)removeCachedComponentSizes;
+
+/**
+ *  Notify this layout that the trait collection of its collection view changed
+ *
+ *  @param previousTraitCollection The trait collection that the collection view had before the change
+ *
+ *  Cached preferred component view sizes are removed if any trait that they are likely to depend on changed. Call
+ *  this from `traitCollectionDidChange:` of the view controller that owns the collection view.
+ */
+- (void)collectionViewTraitCollectionDidChange:(nullable UITraitCollection *)previousTraitCollection;
+
 @end
 
 NS_ASSUME_NONNULL_END
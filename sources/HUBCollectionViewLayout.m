@@ -21,13 +21,18 @@
 
 #import "HUBCollectionViewLayout.h"
 
+#import "HUBCollectionViewLayoutCalculator.h"
+#import "HUBCollectionViewLayoutSnapshot.h"
+#import "HUBCollectionViewLayoutInvalidationContext.h"
 #import "HUBViewModel.h"
 #import "HUBComponentModel.h"
 #import "HUBComponentRegistry.h"
 #import "HUBComponent.h"
 #import "HUBComponentWithChildren.h"
+#import "HUBComponentWithThreadSafeSize.h"
+#import "HUBComponentWithContentOffsetDependentLayout.h"
+#import "HUBComponentSizeCache.h"
 #import "HUBIdentifier.h"
-#import "HUBComponentLayoutManager.h"
 #import "HUBViewModelDiff.h"
 #import "HUBUtilities.h"
 
@@ -35,17 +40,34 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+/// The maximum number of preferred component view sizes that a layout caches
+static NSUInteger const HUBCollectionViewLayoutSizeCacheCountLimit = 1000;
+
+/// The distance from the visible part of the collection view that a virtualized layout measures components within, in collection view heights
+static CGFloat const HUBCollectionViewLayoutVirtualizedMeasuringDistance = 1;
+
+/// The width of the divider between two apps in split view on iPad
+static CGFloat const HUBCollectionViewLayoutSplitViewDividerWidth = 10;
+
+/// The order of the run loop observer that precomputes layouts, making it run after Core Animation has committed a frame
+static CFIndex const HUBCollectionViewLayoutPrecomputationObserverOrder = 2000001;
+
 @interface HUBCollectionViewLayout () <HUBComponentChildDelegate>
 
-@property (nonatomic, strong, nullable) id<HUBViewModel> viewModel;
 @property (nonatomic, strong, readonly) id<HUBComponentRegistry> componentRegistry;
 @property (nonatomic, strong, readonly) id<HUBComponentLayoutManager> componentLayoutManager;
 @property (nonatomic, strong, readonly) NSMutableDictionary<HUBIdentifier *, id<HUBComponent>> *componentCache;
-@property (nonatomic, strong, readonly) NSMutableDictionary<NSIndexPath *, UICollectionViewLayoutAttributes *> *layoutAttributesByIndexPath;
-@property (nonatomic, strong, nullable) NSMutableDictionary<NSIndexPath *, UICollectionViewLayoutAttributes *> *previousLayoutAttributesByIndexPath;
+@property (nonatomic, strong, readonly) HUBComponentSizeCache *sizeCache;
+@property (nonatomic, strong, readonly) NSPointerArray *layoutAttributesByItem;
+@property (nonatomic, strong, nullable) HUBCollectionViewLayoutSnapshot *snapshot;
+@property (nonatomic, strong, nullable) HUBCollectionViewLayoutSnapshot *previousSnapshot;
 @property (nonatomic, strong, nullable) HUBViewModelDiff *lastViewModelDiff;
-
-@property (nonatomic) CGSize contentSize;
+@property (nonatomic, strong, readonly) NSMutableDictionary<NSNumber *, HUBCollectionViewLayoutSnapshot *> *precomputedSnapshots;
+@property (nonatomic, strong, readonly) NSMutableArray<NSValue *> *pendingPrecomputationSizes;
+@property (nonatomic, assign, nullable) CFRunLoopObserverRef precomputationObserver;
+@property (nonatomic, assign) NSUInteger componentSizesGeneration;
+@property (nonatomic, assign) BOOL snapshotHasStaleComponentSizes;
+@property (nonatomic, assign) BOOL snapshotContainsContentOffsetDependentComponents;
 
 @end
 
@@ -60,120 +82,191 @@ NS_ASSUME_NONNULL_BEGIN
         _componentRegistry = componentRegistry;
         _componentLayoutManager = componentLayoutManager;
         _componentCache = [NSMutableDictionary new];
-        _layoutAttributesByIndexPath = [NSMutableDictionary new];
+        _sizeCache = [[HUBComponentSizeCache alloc] initWithCountLimit:HUBCollectionViewLayoutSizeCacheCountLimit];
+        _layoutAttributesByItem = [NSPointerArray strongObjectsPointerArray];
+        _precomputedSnapshots = [NSMutableDictionary new];
+        _pendingPrecomputationSizes = [NSMutableArray new];
+        
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(handleContentSizeCategoryDidChangeNotification:)
+                                                     name:UIContentSizeCategoryDidChangeNotification
+                                                   object:nil];
     }
     
     return self;
 }
 
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+    [self removePrecomputationObserver];
+}
+
 - (void)computeForCollectionViewSize:(CGSize)collectionViewSize
                            viewModel:(id<HUBViewModel>)viewModel
                                 diff:(nullable HUBViewModelDiff *)diff
                      addHeaderMargin:(BOOL)addHeaderMargin
 {
-    self.lastViewModelDiff = diff;
-    self.viewModel = viewModel;
-
-    self.previousLayoutAttributesByIndexPath = [self.layoutAttributesByIndexPath copy];
+    HUBCollectionViewLayoutSnapshot * const precomputedSnapshot = [self precomputedSnapshotForCollectionViewSize:collectionViewSize
+                                                                                                       viewModel:viewModel
+                                                                                                 addHeaderMargin:addHeaderMargin];
+    
+    if (precomputedSnapshot != nil) {
+        [self applySnapshot:precomputedSnapshot diff:diff];
+        return;
+    }
+    
+    HUBCollectionViewLayoutCalculator * const calculator = [self calculatorForCollectionViewSize:collectionViewSize
+                                                                                       viewModel:viewModel
+                                                                                previousSnapshot:self.snapshot
+                                                                                 addHeaderMargin:addHeaderMargin
+                                                                                   measuringRect:[self measuringRectForCollectionViewSize:collectionViewSize]];
+    
+    [self applySnapshot:[calculator computeSnapshotWithDiff:diff] diff:diff];
+}
 
-    [self.layoutAttributesByIndexPath removeAllObjects];
+- (nullable HUBCollectionViewLayoutCalculator *)backgroundCalculatorForCollectionViewSize:(CGSize)collectionViewSize
+                                                                                viewModel:(id<HUBViewModel>)viewModel
+                                                                        previousViewModel:(nullable id<HUBViewModel>)previousViewModel
+                                                                          addHeaderMargin:(BOOL)addHeaderMargin
+{
+    NSMutableArray<id<HUBComponentModel>> * const componentModels = [viewModel.bodyComponentModels mutableCopy];
     
-    BOOL componentIsInTopRow = YES;
-    NSMutableArray<id<HUBComponent>> * const componentsOnCurrentRow = [NSMutableArray new];
-    CGFloat currentRowMaxY = 0;
-    CGPoint currentPoint = CGPointZero;
-    CGPoint firstComponentOnCurrentRowOrigin = CGPointZero;
-    NSUInteger const allComponentsCount = self.viewModel.bodyComponentModels.count;
-    CGFloat maxBottomRowComponentHeight = 0;
-    CGFloat maxBottomRowHeightWithMargins = 0;
+    if (viewModel.headerComponentModel != nil) {
+        [componentModels addObject:viewModel.headerComponentModel];
+    }
     
-    for (NSUInteger componentIndex = 0; componentIndex < allComponentsCount; componentIndex++) {
-        id<HUBComponentModel> const componentModel = self.viewModel.bodyComponentModels[componentIndex];
+    for (id<HUBComponentModel> const componentModel in componentModels) {
         id<HUBComponent> const component = [self componentForModel:componentModel];
-        NSSet<HUBComponentLayoutTrait> * const componentLayoutTraits = component.layoutTraits;
-        BOOL isLastComponent = (componentIndex == allComponentsCount - 1);
-
-        CGRect componentViewFrame = [self defaultViewFrameForComponent:component
-                                                                 model:componentModel
-                                                          currentPoint:currentPoint
-                                                    collectionViewSize:collectionViewSize];
-
-        UIEdgeInsets margins = [self defaultMarginsForComponent:component
-                                                     isInTopRow:componentIsInTopRow
-                                         componentsOnCurrentRow:componentsOnCurrentRow
-                                             collectionViewSize:collectionViewSize
-                                                addHeaderMargin:addHeaderMargin];
-
-        componentViewFrame.origin.x = currentPoint.x + margins.left;
-
-        BOOL couldFitOnTheRow = CGRectGetMaxX(componentViewFrame) + margins.right <= collectionViewSize.width;
         
-        if (couldFitOnTheRow == NO) {
-            [self updateLayoutAttributesForComponentsIfNeeded:componentsOnCurrentRow
-                                           lastComponentIndex:(NSInteger)componentIndex - 1
-                                              firstComponentX:firstComponentOnCurrentRowOrigin.x
-                                               lastComponentX:currentPoint.x
-                                                     rowWidth:collectionViewSize.width];
-
-            if (componentsOnCurrentRow.count > 0) {
-                margins.top = 0;
-                
-                for (id<HUBComponent> const verticallyPrecedingComponent in componentsOnCurrentRow) {
-                    CGFloat const marginToComponent = [self.componentLayoutManager verticalMarginForComponentWithLayoutTraits:componentLayoutTraits
-                                                                                               precedingComponentLayoutTraits:verticallyPrecedingComponent.layoutTraits];
-                    
-                    if (marginToComponent > margins.top) {
-                        margins.top = marginToComponent;
-                    }
-                }
-            }
-            
-            componentViewFrame.origin.x = [self.componentLayoutManager marginBetweenComponentWithLayoutTraits:componentLayoutTraits
-                                                                                               andContentEdge:HUBComponentLayoutContentEdgeLeft];
-            
-            componentViewFrame.origin.y = currentRowMaxY + margins.top;
-            componentIsInTopRow = NO;
-            [componentsOnCurrentRow removeAllObjects];
-            currentPoint.y = CGRectGetMinY(componentViewFrame);
-            currentRowMaxY = CGRectGetMaxY(componentViewFrame) + margins.bottom;
-        } else {
-            componentViewFrame.origin.y = currentPoint.y + margins.top;
+        if (!HUBConformsToProtocol(component, @protocol(HUBComponentWithThreadSafeSize))) {
+            return nil;
         }
         
-        componentViewFrame = [self horizontallyAdjustComponentViewFrame:componentViewFrame
-                                                  forCollectionViewSize:collectionViewSize
-                                                                margins:margins];
-        
-        currentPoint.x = CGRectGetMaxX(componentViewFrame);
-        currentRowMaxY = HUBCGFloatMax(currentRowMaxY, CGRectGetMaxY(componentViewFrame));
+        // Components with children resolve their child components through this layout, on the main queue
+        if (HUBConformsToProtocol(component, @protocol(HUBComponentWithChildren))) {
+            return nil;
+        }
+    }
+    
+    // The current snapshot can only be used as a base if the diff will be computed against its view model
+    HUBCollectionViewLayoutSnapshot * const snapshot = self.snapshot;
+    HUBCollectionViewLayoutSnapshot * const previousSnapshot = (snapshot.viewModel == previousViewModel) ? snapshot : nil;
+    
+    return [self calculatorForCollectionViewSize:collectionViewSize
+                                       viewModel:viewModel
+                                previousSnapshot:previousSnapshot
+                                 addHeaderMargin:addHeaderMargin
+                                   measuringRect:[self measuringRectForCollectionViewSize:collectionViewSize]];
+}
+
+- (void)applySnapshot:(HUBCollectionViewLayoutSnapshot *)snapshot diff:(nullable HUBViewModelDiff *)diff
+{
+    HUBCollectionViewLayoutSnapshot * const currentSnapshot = self.snapshot;
+    
+    if (currentSnapshot.viewModel != snapshot.viewModel) {
+        [self.precomputedSnapshots removeAllObjects];
+        [self cancelPendingPrecomputations];
+    } else if (currentSnapshot != nil && !HUBCGFloatIsZero(currentSnapshot.collectionViewSize.width - snapshot.collectionViewSize.width)) {
+        // Keep the layout for the current width, in case the collection view is resized back, for example when rotating
+        self.precomputedSnapshots[@(currentSnapshot.collectionViewSize.width)] = currentSnapshot;
+    }
+    
+    self.previousSnapshot = currentSnapshot;
+    self.lastViewModelDiff = diff;
+    [self commitSnapshot:snapshot];
+}
+
+- (void)precomputeForCollectionViewSizes:(NSArray<NSValue *> *)collectionViewSizes
+{
+    HUBCollectionViewLayoutSnapshot * const snapshot = self.snapshot;
+    
+    if (snapshot == nil) {
+        return;
+    }
+    
+    NSMutableSet<NSNumber *> * const collectionViewWidths = [NSMutableSet setWithObject:@(snapshot.collectionViewSize.width)];
+    [collectionViewWidths addObjectsFromArray:self.precomputedSnapshots.allKeys];
+    
+    for (NSValue * const pendingCollectionViewSizeValue in self.pendingPrecomputationSizes) {
+        [collectionViewWidths addObject:@(pendingCollectionViewSizeValue.CGSizeValue.width)];
+    }
+    
+    for (NSValue * const collectionViewSizeValue in collectionViewSizes) {
+        CGSize const collectionViewSize = collectionViewSizeValue.CGSizeValue;
         
-        [self registerComponentViewFrame:componentViewFrame forIndex:componentIndex];
+        if (collectionViewSize.width <= 0 || collectionViewSize.height <= 0) {
+            continue;
+        }
         
-        [componentsOnCurrentRow addObject:component];
-
-        if (componentsOnCurrentRow.count == 1) {
-            firstComponentOnCurrentRowOrigin = componentViewFrame.origin;
+        // Layouts only depend on the width, so a single layout is precomputed per width
+        if ([collectionViewWidths containsObject:@(collectionViewSize.width)]) {
+            continue;
         }
+        
+        [collectionViewWidths addObject:@(collectionViewSize.width)];
+        [self precomputeForCollectionViewSize:collectionViewSize viewModel:snapshot.viewModel addHeaderMargin:snapshot.addHeaderMargin];
+    }
+}
 
-        if (isLastComponent) {
-            // We center components if needed when we go to a new row. If it is the last row we need to center it here
-            [self updateLayoutAttributesForComponentsIfNeeded:componentsOnCurrentRow
-                                           lastComponentIndex:(NSInteger)componentIndex
-                                              firstComponentX:firstComponentOnCurrentRowOrigin.x
-                                               lastComponentX:currentPoint.x
-                                                     rowWidth:collectionViewSize.width];
-        }
+- (void)precomputeForLikelyCollectionViewSizes
+{
+    UICollectionView * const collectionView = self.collectionView;
+    
+    if (collectionView == nil) {
+        return;
     }
+    
+    CGSize const collectionViewSize = collectionView.frame.size;
+    CGSize const screenSize = (collectionView.window.screen ?: [UIScreen mainScreen]).bounds.size;
+    
+    NSMutableArray<NSValue *> * const collectionViewSizes = [NSMutableArray new];
+    [collectionViewSizes addObject:[NSValue valueWithCGSize:CGSizeMake(collectionViewSize.height, collectionViewSize.width)]];
+    [collectionViewSizes addObject:[NSValue valueWithCGSize:CGSizeMake(screenSize.width, collectionViewSize.height)]];
+    
+    // Split view is only available in landscape for two equally sized apps
+    if (collectionView.traitCollection.userInterfaceIdiom == UIUserInterfaceIdiomPad && screenSize.width > screenSize.height) {
+        CGFloat const splitViewWidth = HUBCGFloatFloor((screenSize.width - HUBCollectionViewLayoutSplitViewDividerWidth) / 2);
+        [collectionViewSizes addObject:[NSValue valueWithCGSize:CGSizeMake(splitViewWidth, collectionViewSize.height)]];
+    }
+    
+    [self precomputeForCollectionViewSizes:collectionViewSizes];
+}
+
+- (void)cancelPendingPrecomputations
+{
+    [self.pendingPrecomputationSizes removeAllObjects];
+    [self removePrecomputationObserver];
+}
 
-    self.contentSize = [self contentSizeForContentHeight:currentRowMaxY
-                                     bottomRowComponents:componentsOnCurrentRow
-                                     minimumBottomMargin:maxBottomRowHeightWithMargins - maxBottomRowComponentHeight
-                                      collectionViewSize:collectionViewSize];
+- (void)removeCachedComponentSizes
+{
+    [self.sizeCache removeAllSizes];
+    [self.precomputedSnapshots removeAllObjects];
+    self.componentSizesGeneration++;
+    self.snapshotHasStaleComponentSizes = (self.snapshot != nil);
+}
+
+- (void)collectionViewTraitCollectionDidChange:(nullable UITraitCollection *)previousTraitCollection
+{
+    UITraitCollection * const traitCollection = self.collectionView.traitCollection;
+    
+    if (previousTraitCollection == nil || traitCollection == nil) {
+        return;
+    }
+    
+    // Components commonly round their sizes to whole pixels
+    if (!HUBCGFloatIsZero(previousTraitCollection.displayScale - traitCollection.displayScale)) {
+        [self removeCachedComponentSizes];
+    }
 }
 
 - (CGPoint)targetContentOffsetForProposedContentOffset:(CGPoint)proposedContentOffset
 {
-    if (self.previousLayoutAttributesByIndexPath == nil || self.lastViewModelDiff == nil) {
+    HUBCollectionViewLayoutSnapshot * const snapshot = self.snapshot;
+    HUBCollectionViewLayoutSnapshot * const previousSnapshot = self.previousSnapshot;
+    
+    if (snapshot == nil || previousSnapshot == nil || self.lastViewModelDiff == nil) {
         return proposedContentOffset;
     }
 
@@ -191,15 +284,28 @@ NS_ASSUME_NONNULL_BEGIN
     
     for (NSIndexPath *indexPath in self.lastViewModelDiff.insertedBodyComponentIndexPaths) {
         if (indexPath.item < topmostVisibleIndex) {
-            UICollectionViewLayoutAttributes *attributes = self.layoutAttributesByIndexPath[indexPath];
-            offset.y += CGRectGetHeight(attributes.frame);
+            offset.y += CGRectGetHeight([snapshot frameForComponentAtIndex:(NSUInteger)indexPath.item]);
         }
     }
     
     for (NSIndexPath *indexPath in self.lastViewModelDiff.deletedBodyComponentIndexPaths) {
         if (indexPath.item <= topmostVisibleIndex) {
-            UICollectionViewLayoutAttributes *attributes = self.previousLayoutAttributesByIndexPath[indexPath];
-            offset.y -= CGRectGetHeight(attributes.frame);
+            offset.y -= CGRectGetHeight([previousSnapshot frameForComponentAtIndex:(NSUInteger)indexPath.item]);
+        }
+    }
+
+    // A moved component affects the offset just like a deletion from its old position and an insertion at its new one.
+    NSDictionary<NSIndexPath *, NSIndexPath *> * const moves = self.lastViewModelDiff.movedBodyComponentIndexPaths;
+    
+    for (NSIndexPath *fromIndexPath in moves) {
+        NSIndexPath * const toIndexPath = moves[fromIndexPath];
+        
+        if (fromIndexPath.item <= topmostVisibleIndex) {
+            offset.y -= CGRectGetHeight([previousSnapshot frameForComponentAtIndex:(NSUInteger)fromIndexPath.item]);
+        }
+        
+        if (toIndexPath.item < topmostVisibleIndex) {
+            offset.y += CGRectGetHeight([snapshot frameForComponentAtIndex:(NSUInteger)toIndexPath.item]);
         }
     }
     
@@ -207,10 +313,10 @@ NS_ASSUME_NONNULL_BEGIN
     CGFloat const minContentOffset = -self.collectionView.contentInset.top;
     offset.y = HUBCGFloatMax(minContentOffset, offset.y);
     // ...or beyond the bottom.
-    CGFloat maxContentOffset = MAX(self.contentSize.height + self.collectionView.contentInset.bottom - CGRectGetHeight(self.collectionView.frame), minContentOffset);
+    CGFloat maxContentOffset = MAX(snapshot.contentSize.height + self.collectionView.contentInset.bottom - CGRectGetHeight(self.collectionView.frame), minContentOffset);
     offset.y = HUBCGFloatMin(maxContentOffset, offset.y);
     
-    self.previousLayoutAttributesByIndexPath = nil;
+    self.previousSnapshot = nil;
     self.lastViewModelDiff = nil;
     
     return offset;
@@ -244,183 +350,379 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (nullable NSArray<UICollectionViewLayoutAttributes *> *)layoutAttributesForElementsInRect:(CGRect)rect
 {
-    NSMutableArray<UICollectionViewLayoutAttributes *> * const layoutAttributes = [NSMutableArray new];
-
-    for (UICollectionViewLayoutAttributes *attributes in self.layoutAttributesByIndexPath.allValues) {
-        if (CGRectIntersectsRect(rect, attributes.frame)) {
-            [layoutAttributes addObject:attributes];
-        }
-    }
+    NSIndexSet * const componentIndexes = [self.snapshot indexesOfComponentsInRect:rect];
+    NSMutableArray<UICollectionViewLayoutAttributes *> * const layoutAttributes = [NSMutableArray arrayWithCapacity:componentIndexes.count];
+    
+    [componentIndexes enumerateIndexesUsingBlock:^(NSUInteger componentIndex, BOOL *stop) {
+        [layoutAttributes addObject:[self layoutAttributesForComponentAtIndex:componentIndex]];
+    }];
 
     return layoutAttributes;
 }
 
 - (nullable UICollectionViewLayoutAttributes *)layoutAttributesForItemAtIndexPath:(NSIndexPath *)indexPath
 {
-    return self.layoutAttributesByIndexPath[indexPath];
+    if (indexPath.item < 0 || (NSUInteger)indexPath.item >= self.snapshot.componentCount) {
+        return nil;
+    }
+    
+    return [self layoutAttributesForComponentAtIndex:(NSUInteger)indexPath.item];
+}
+
++ (Class)invalidationContextClass
+{
+    return [HUBCollectionViewLayoutInvalidationContext class];
 }
 
 - (BOOL)shouldInvalidateLayoutForBoundsChange:(CGRect)newBounds
 {
-    return YES;
+    if ([self invalidatesLayoutForContentOffsetChanges]) {
+        return YES;
+    }
+    
+    // Pure vertical scrolling doesn't affect any frames, unless it brings estimated components close to the visible area
+    return [self boundsChangeChangesWidth:newBounds] || [self boundsChangeRequiresRefinement:newBounds];
+}
+
+- (UICollectionViewLayoutInvalidationContext *)invalidationContextForBoundsChange:(CGRect)newBounds
+{
+    HUBCollectionViewLayoutInvalidationContext * const context = (HUBCollectionViewLayoutInvalidationContext *)[super invalidationContextForBoundsChange:newBounds];
+    context.invalidatedCollectionViewWidth = [self boundsChangeChangesWidth:newBounds];
+    context.invalidatedContentOffset = [self invalidatesLayoutForContentOffsetChanges];
+    
+    if (![self boundsChangeRequiresRefinement:newBounds]) {
+        return context;
+    }
+    
+    context.invalidatedEstimatedComponents = YES;
+    
+    HUBCollectionViewLayoutSnapshot * const snapshot = self.snapshot;
+    CGRect const measuringRect = [self measuringRectForBounds:newBounds];
+    HUBCollectionViewLayoutCalculator * const calculator = [self calculatorForCollectionViewSize:snapshot.collectionViewSize
+                                                                                       viewModel:snapshot.viewModel
+                                                                                previousSnapshot:snapshot
+                                                                                 addHeaderMargin:snapshot.addHeaderMargin
+                                                                                   measuringRect:measuringRect];
+    
+    HUBCollectionViewLayoutSnapshot * const refinedSnapshot = [calculator computeSnapshotWithDiff:nil];
+    
+    // Keep the topmost visible component in place, since the refined components above it may have changed size
+    NSUInteger const anchorComponentIndex = [snapshot indexesOfComponentsInRect:self.collectionView.bounds].firstIndex;
+    
+    if (anchorComponentIndex != NSNotFound) {
+        CGRect const previousAnchorFrame = [snapshot frameForComponentAtIndex:anchorComponentIndex];
+        CGRect const anchorFrame = [refinedSnapshot frameForComponentAtIndex:anchorComponentIndex];
+        context.contentOffsetAdjustment = CGPointMake(0, CGRectGetMinY(anchorFrame) - CGRectGetMinY(previousAnchorFrame));
+    }
+    
+    context.contentSizeAdjustment = CGSizeMake(0, refinedSnapshot.contentSize.height - snapshot.contentSize.height);
+    
+    // Refining doesn't change the view model, so any pending content offset adjustment for the last diff is kept
+    [self commitSnapshot:refinedSnapshot];
+    
+    return context;
 }
 
 - (CGSize)collectionViewContentSize
 {
-    return self.contentSize;
+    HUBCollectionViewLayoutSnapshot * const snapshot = self.snapshot;
+    return (snapshot != nil) ? snapshot.contentSize : CGSizeZero;
+}
+
+#pragma mark - Notification handling
+
+- (void)handleContentSizeCategoryDidChangeNotification:(NSNotification *)notification
+{
+    [self removeCachedComponentSizes];
 }
 
 #pragma mark - Private utilities
 
-- (id<HUBComponent>)componentForModel:(id<HUBComponentModel>)model
+- (UICollectionViewLayoutAttributes *)layoutAttributesForComponentAtIndex:(NSUInteger)componentIndex
 {
-    id<HUBComponent> const cachedComponent = self.componentCache[model.componentIdentifier];
+    NSPointerArray * const layoutAttributesByItem = self.layoutAttributesByItem;
+    UICollectionViewLayoutAttributes * const cachedLayoutAttributes = (__bridge UICollectionViewLayoutAttributes *)[layoutAttributesByItem pointerAtIndex:componentIndex];
     
-    if (cachedComponent != nil) {
-        return cachedComponent;
+    if (cachedLayoutAttributes != nil) {
+        return cachedLayoutAttributes;
     }
     
-    id<HUBComponent> const newComponent = [self.componentRegistry createComponentForModel:model];
-    self.componentCache[model.componentIdentifier] = newComponent;
+    NSIndexPath * const indexPath = [NSIndexPath indexPathForItem:(NSInteger)componentIndex inSection:0];
+    UICollectionViewLayoutAttributes * const layoutAttributes = [UICollectionViewLayoutAttributes layoutAttributesForCellWithIndexPath:indexPath];
+    layoutAttributes.frame = [self.snapshot frameForComponentAtIndex:componentIndex];
+    [layoutAttributesByItem replacePointerAtIndex:componentIndex withPointer:(__bridge void *)layoutAttributes];
+    return layoutAttributes;
+}
+
+- (nullable HUBCollectionViewLayoutSnapshot *)precomputedSnapshotForCollectionViewSize:(CGSize)collectionViewSize
+                                                                            viewModel:(id<HUBViewModel>)viewModel
+                                                                      addHeaderMargin:(BOOL)addHeaderMargin
+{
+    if (self.snapshot.viewModel != viewModel) {
+        return nil;
+    }
     
-    if (HUBConformsToProtocol(newComponent, @protocol(HUBComponentWithChildren))) {
-        ((id<HUBComponentWithChildren>)newComponent).childDelegate = self;
+    HUBCollectionViewLayoutSnapshot * const precomputedSnapshot = self.precomputedSnapshots[@(collectionViewSize.width)];
+    
+    if (precomputedSnapshot == nil || precomputedSnapshot.viewModel != viewModel || precomputedSnapshot.addHeaderMargin != addHeaderMargin) {
+        return nil;
     }
     
-    return newComponent;
+    if (CGSizeEqualToSize(precomputedSnapshot.collectionViewSize, collectionViewSize)) {
+        return precomputedSnapshot;
+    }
+    
+    // The frames only depend on the width, but the state used for virtualization depends on the height too
+    HUBCollectionViewLayoutSnapshot * const resizedSnapshot = [precomputedSnapshot snapshotWithCollectionViewSize:collectionViewSize];
+    CGRect const measuringRect = [self measuringRectForCollectionViewSize:collectionViewSize];
+    
+    if ([resizedSnapshot indexesOfEstimatedComponentsInRect:measuringRect].count == 0) {
+        return resizedSnapshot;
+    }
+    
+    HUBCollectionViewLayoutCalculator * const calculator = [self calculatorForCollectionViewSize:collectionViewSize
+                                                                                       viewModel:viewModel
+                                                                                previousSnapshot:resizedSnapshot
+                                                                                 addHeaderMargin:addHeaderMargin
+                                                                                   measuringRect:measuringRect];
+    
+    return [calculator computeSnapshotWithDiff:nil];
 }
 
-- (UIEdgeInsets)defaultMarginsForComponent:(id<HUBComponent>)component
-                                isInTopRow:(BOOL)componentIsInTopRow
-                    componentsOnCurrentRow:(NSArray<id<HUBComponent>> *)componentsOnCurrentRow
-                        collectionViewSize:(CGSize)collectionViewSize
-                           addHeaderMargin:(BOOL)addHeaderMargin
+- (void)precomputeForCollectionViewSize:(CGSize)collectionViewSize
+                              viewModel:(id<HUBViewModel>)viewModel
+                        addHeaderMargin:(BOOL)addHeaderMargin
 {
-    NSSet<HUBComponentLayoutTrait> * const componentLayoutTraits = component.layoutTraits;
-    UIEdgeInsets margins = UIEdgeInsetsZero;
+    HUBCollectionViewLayoutCalculator * const backgroundCalculator = [self backgroundCalculatorForCollectionViewSize:collectionViewSize
+                                                                                                            viewModel:viewModel
+                                                                                                    previousViewModel:nil
+                                                                                                      addHeaderMargin:addHeaderMargin];
     
-    if (componentIsInTopRow) {
-        id<HUBComponentModel> const headerComponentModel = self.viewModel.headerComponentModel;
-
-        if (headerComponentModel != nil) {
-            if (addHeaderMargin) {
-                id<HUBComponent> const headerComponent = [self componentForModel:headerComponentModel];
-                CGSize headerSize = [headerComponent preferredViewSizeForDisplayingModel:headerComponentModel containerViewSize:collectionViewSize];
-                margins.top = headerSize.height + [self.componentLayoutManager verticalMarginBetweenComponentWithLayoutTraits:componentLayoutTraits
-                                                                                           andHeaderComponentWithLayoutTraits:headerComponent.layoutTraits];
-            }
-        } else {
-            margins.top = [self.componentLayoutManager marginBetweenComponentWithLayoutTraits:componentLayoutTraits
-                                                                               andContentEdge:HUBComponentLayoutContentEdgeTop];
-        }
+    if (backgroundCalculator == nil) {
+        [self.pendingPrecomputationSizes addObject:[NSValue valueWithCGSize:collectionViewSize]];
+        [self addPrecomputationObserverIfNeeded];
+        return;
     }
     
-    if (componentsOnCurrentRow.count == 0) {
-        margins.left = [self.componentLayoutManager marginBetweenComponentWithLayoutTraits:componentLayoutTraits
-                                                                            andContentEdge:HUBComponentLayoutContentEdgeLeft];
-    } else {
-        id<HUBComponent> const precedingComponent = [componentsOnCurrentRow lastObject];
-        margins.left = [self.componentLayoutManager horizontalMarginForComponentWithLayoutTraits:componentLayoutTraits
-                                                                  precedingComponentLayoutTraits:precedingComponent.layoutTraits];
+    __weak __typeof(self) weakSelf = self;
+    NSUInteger const componentSizesGeneration = self.componentSizesGeneration;
+    
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        HUBCollectionViewLayoutSnapshot * const precomputedSnapshot = [backgroundCalculator computeSnapshotWithDiff:nil];
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            __strong __typeof(self) strongSelf = weakSelf;
+            
+            // The layout may have been computed for another view model, or its cached sizes removed, in the meantime
+            if (strongSelf.snapshot.viewModel == viewModel && strongSelf.componentSizesGeneration == componentSizesGeneration) {
+                strongSelf.precomputedSnapshots[@(collectionViewSize.width)] = precomputedSnapshot;
+            }
+        });
+    });
+}
+
+- (void)addPrecomputationObserverIfNeeded
+{
+    if (self.precomputationObserver != NULL) {
+        return;
     }
     
-    margins.right = [self.componentLayoutManager marginBetweenComponentWithLayoutTraits:componentLayoutTraits
-                                                                         andContentEdge:HUBComponentLayoutContentEdgeRight];
+    __weak __typeof(self) weakSelf = self;
     
-    return margins;
+    // Observing the default mode only means that nothing is computed while the user is scrolling
+    CFRunLoopObserverRef const observer = CFRunLoopObserverCreateWithHandler(kCFAllocatorDefault,
+                                                                             kCFRunLoopBeforeWaiting,
+                                                                             true,
+                                                                             HUBCollectionViewLayoutPrecomputationObserverOrder,
+                                                                             ^(CFRunLoopObserverRef runLoopObserver, CFRunLoopActivity activity) {
+        [weakSelf precomputeForNextPendingCollectionViewSize];
+    });
+    
+    CFRunLoopAddObserver(CFRunLoopGetMain(), observer, kCFRunLoopDefaultMode);
+    self.precomputationObserver = observer;
 }
 
-- (CGRect)defaultViewFrameForComponent:(id<HUBComponent>)component
-                                 model:(id<HUBComponentModel>)componentModel
-                          currentPoint:(CGPoint)currentPoint
-                    collectionViewSize:(CGSize)collectionViewSize
+- (void)removePrecomputationObserver
 {
-    CGRect componentViewFrame = CGRectZero;
-    componentViewFrame.size = [component preferredViewSizeForDisplayingModel:componentModel containerViewSize:collectionViewSize];
-    componentViewFrame.size.width = MIN(CGRectGetWidth(componentViewFrame), collectionViewSize.width);
-    return componentViewFrame;
+    CFRunLoopObserverRef const observer = self.precomputationObserver;
+    
+    if (observer == NULL) {
+        return;
+    }
+    
+    CFRunLoopObserverInvalidate(observer);
+    CFRelease(observer);
+    self.precomputationObserver = NULL;
 }
 
-- (CGRect)horizontallyAdjustComponentViewFrame:(CGRect)componentViewFrame forCollectionViewSize:(CGSize)collectionViewSize margins:(UIEdgeInsets)margins
+- (void)precomputeForNextPendingCollectionViewSize
 {
-    CGFloat const horizontalOverflow = CGRectGetMaxX(componentViewFrame) + margins.right - collectionViewSize.width;
+    NSMutableArray<NSValue *> * const pendingPrecomputationSizes = self.pendingPrecomputationSizes;
+    HUBCollectionViewLayoutSnapshot * const snapshot = self.snapshot;
     
-    if (horizontalOverflow > 0) {
-        componentViewFrame.size.width -= horizontalOverflow;
+    if (pendingPrecomputationSizes.count == 0 || snapshot == nil) {
+        [self cancelPendingPrecomputations];
+        return;
     }
     
-    return componentViewFrame;
+    // Only one layout is computed each time the run loop becomes idle, to keep handling events in between
+    while (pendingPrecomputationSizes.count > 0) {
+        CGSize const collectionViewSize = pendingPrecomputationSizes.firstObject.CGSizeValue;
+        [pendingPrecomputationSizes removeObjectAtIndex:0];
+        
+        // The collection view may have been resized to the pending width in the meantime
+        if (HUBCGFloatIsZero(collectionViewSize.width - snapshot.collectionViewSize.width) || self.precomputedSnapshots[@(collectionViewSize.width)] != nil) {
+            continue;
+        }
+        
+        HUBCollectionViewLayoutCalculator * const calculator = [self calculatorForCollectionViewSize:collectionViewSize
+                                                                                           viewModel:snapshot.viewModel
+                                                                                    previousSnapshot:nil
+                                                                                     addHeaderMargin:snapshot.addHeaderMargin
+                                                                                       measuringRect:[self measuringRectForCollectionViewSize:collectionViewSize]];
+        
+        self.precomputedSnapshots[@(collectionViewSize.width)] = [calculator computeSnapshotWithDiff:nil];
+        break;
+    }
+    
+    if (pendingPrecomputationSizes.count == 0) {
+        [self removePrecomputationObserver];
+    }
 }
 
-- (void)registerComponentViewFrame:(CGRect)componentViewFrame forIndex:(NSUInteger)componentIndex
+- (BOOL)boundsChangeChangesWidth:(CGRect)newBounds
 {
-    NSIndexPath * const indexPath = [NSIndexPath indexPathForItem:(NSInteger)componentIndex inSection:0];
-    UICollectionViewLayoutAttributes * const layoutAttributes = [UICollectionViewLayoutAttributes layoutAttributesForCellWithIndexPath:indexPath];
-    layoutAttributes.frame = componentViewFrame;
-    self.layoutAttributesByIndexPath[indexPath] = layoutAttributes;
+    return !HUBCGFloatIsZero(CGRectGetWidth(newBounds) - CGRectGetWidth(self.collectionView.bounds));
 }
 
-- (CGSize)contentSizeForContentHeight:(CGFloat)contentHeight
-                  bottomRowComponents:(NSArray<id<HUBComponent>> *)bottomRowComponents
-                  minimumBottomMargin:(CGFloat)minimumBottomMargin
-                   collectionViewSize:(CGSize)collectionViewSize
+- (BOOL)boundsChangeRequiresRefinement:(CGRect)newBounds
 {
-    CGFloat viewBottomMargin = 0;
+    HUBCollectionViewLayoutSnapshot * const snapshot = self.snapshot;
     
-    for (id<HUBComponent> const component in bottomRowComponents) {
-        CGFloat const componentBottomMargin = [self.componentLayoutManager marginBetweenComponentWithLayoutTraits:component.layoutTraits
-                                                                                                   andContentEdge:HUBComponentLayoutContentEdgeBottom];
-        
-        viewBottomMargin = HUBCGFloatMax(viewBottomMargin, componentBottomMargin);
+    if (!self.virtualized || snapshot == nil || !CGSizeEqualToSize(newBounds.size, snapshot.collectionViewSize)) {
+        return NO;
     }
     
-    contentHeight += HUBCGFloatMax(viewBottomMargin, minimumBottomMargin);
-    
-    return CGSizeMake(collectionViewSize.width, contentHeight);
+    return [snapshot indexesOfEstimatedComponentsInRect:[self measuringRectForBounds:newBounds]].count > 0;
 }
 
-- (void)updateLayoutAttributesForComponentsIfNeeded:(NSArray<id<HUBComponent>> *)components
-                                 lastComponentIndex:(NSInteger)lastComponentIndex
-                                    firstComponentX:(CGFloat)firstComponentX
-                                     lastComponentX:(CGFloat)lastComponentX
-                                           rowWidth:(CGFloat)rowWidth
+- (void)commitSnapshot:(HUBCollectionViewLayoutSnapshot *)snapshot
 {
+    if (snapshot.viewModel != self.snapshot.viewModel) {
+        self.snapshotContainsContentOffsetDependentComponents = [self viewModelContainsContentOffsetDependentComponents:snapshot.viewModel];
+    }
+    
+    self.snapshot = snapshot;
+    self.snapshotHasStaleComponentSizes = NO;
+    
+    // Layout attributes are created lazily when queried, so only the slots for them are reset here
+    NSPointerArray * const layoutAttributesByItem = self.layoutAttributesByItem;
+    layoutAttributesByItem.count = 0;
+    layoutAttributesByItem.count = snapshot.componentCount;
+}
 
+- (BOOL)invalidatesLayoutForContentOffsetChanges
+{
+    return self.invalidatesLayoutOnContentOffsetChange || self.snapshotContainsContentOffsetDependentComponents;
+}
 
-    NSArray<NSSet<HUBComponentLayoutTrait> *> *componentsTraits = [self.class layoutTraitsFromComponents:components];
-    CGFloat adjustment = [self.componentLayoutManager horizontalOffsetForComponentsWithLayoutTraits:componentsTraits
-                                                              firstComponentLeadingHorizontalOffset:firstComponentX
-                                                              lastComponentTrailingHorizontalOffset:rowWidth - lastComponentX];
+- (BOOL)viewModelContainsContentOffsetDependentComponents:(id<HUBViewModel>)viewModel
+{
+    id<HUBComponentModel> const headerComponentModel = viewModel.headerComponentModel;
+    
+    if (headerComponentModel != nil) {
+        id<HUBComponent> const headerComponent = [self componentForModel:headerComponentModel];
+        
+        if (HUBConformsToProtocol(headerComponent, @protocol(HUBComponentWithContentOffsetDependentLayout))) {
+            return YES;
+        }
+    }
+    
+    for (id<HUBComponentModel> const componentModel in viewModel.bodyComponentModels) {
+        id<HUBComponent> const component = [self componentForModel:componentModel];
+        
+        if (HUBConformsToProtocol(component, @protocol(HUBComponentWithContentOffsetDependentLayout))) {
+            return YES;
+        }
+    }
+    
+    return NO;
+}
 
-    [self updateLayoutAttributesForComponents:components horizontalAdjustment:adjustment lastComponentIndex:lastComponentIndex];
+- (CGRect)measuringRectForCollectionViewSize:(CGSize)collectionViewSize
+{
+    UICollectionView * const collectionView = self.collectionView;
+    CGPoint const contentOffset = (collectionView != nil) ? collectionView.contentOffset : CGPointZero;
+    return [self measuringRectForBounds:(CGRect){contentOffset, collectionViewSize}];
 }
 
-+ (NSArray<NSSet<HUBComponentLayoutTrait> *> *)layoutTraitsFromComponents:(NSArray<id<HUBComponent>> *)components
+- (CGRect)measuringRectForBounds:(CGRect)bounds
 {
-    NSMutableArray *layoutTraints = [NSMutableArray new];
-    for (id<HUBComponent> component in components) {
-        [layoutTraints addObject:component.layoutTraits];
+    if (!self.virtualized) {
+        return CGRectInfinite;
     }
-    return [layoutTraints copy];
+    
+    CGFloat const measuringDistance = CGRectGetHeight(bounds) * HUBCollectionViewLayoutVirtualizedMeasuringDistance;
+    return CGRectInset(bounds, 0, -measuringDistance);
 }
 
-- (void)updateLayoutAttributesForComponents:(NSArray<id<HUBComponent>> *)components
-                       horizontalAdjustment:(CGFloat)horizontalAdjustment
-                         lastComponentIndex:(NSInteger)lastComponentIndex
+- (HUBCollectionViewLayoutCalculator *)calculatorForCollectionViewSize:(CGSize)collectionViewSize
+                                                             viewModel:(id<HUBViewModel>)viewModel
+                                                      previousSnapshot:(nullable HUBCollectionViewLayoutSnapshot *)previousSnapshot
+                                                       addHeaderMargin:(BOOL)addHeaderMargin
+                                                         measuringRect:(CGRect)measuringRect
 {
-    if (HUBCGFloatIsZero(horizontalAdjustment) || lastComponentIndex < 0) {
-        return;
+    // Nothing measured before the cached sizes were removed can be reused
+    if (self.snapshotHasStaleComponentSizes) {
+        previousSnapshot = nil;
     }
+    
+    // Estimated sizes depend on the width that components were measured for
+    HUBCollectionViewLayoutSnapshot * const snapshot = previousSnapshot ?: self.snapshot;
+    BOOL const canUseSizeEstimates = !self.snapshotHasStaleComponentSizes && CGSizeEqualToSize(snapshot.collectionViewSize, collectionViewSize);
+    
+    return [[HUBCollectionViewLayoutCalculator alloc] initWithViewModel:viewModel
+                                                     collectionViewSize:collectionViewSize
+                                                        addHeaderMargin:addHeaderMargin
+                                                             components:[self componentsForViewModel:viewModel]
+                                                 componentLayoutManager:self.componentLayoutManager
+                                                              sizeCache:self.sizeCache
+                                                          measuringRect:measuringRect
+                                                 componentSizeEstimates:canUseSizeEstimates ? snapshot.componentSizeEstimates : nil
+                                                       previousSnapshot:previousSnapshot];
+}
 
-    NSUInteger indexOfFirstComponentOnTheRow = (NSUInteger)lastComponentIndex - components.count + 1;
-    for (NSUInteger index = indexOfFirstComponentOnTheRow; index <= (NSUInteger)lastComponentIndex; index++) {
-        NSIndexPath * const indexPath = [NSIndexPath indexPathForItem:(NSInteger)index inSection:0];
-        UICollectionViewLayoutAttributes * const layoutAttributes = [self layoutAttributesForItemAtIndexPath:indexPath];
-        CGRect adjustedFrame = layoutAttributes.frame;
-        adjustedFrame.origin.x += horizontalAdjustment;
+- (NSDictionary<HUBIdentifier *, id<HUBComponent>> *)componentsForViewModel:(id<HUBViewModel>)viewModel
+{
+    id<HUBComponentModel> const headerComponentModel = viewModel.headerComponentModel;
+    
+    if (headerComponentModel != nil) {
+        [self componentForModel:headerComponentModel];
+    }
+    
+    for (id<HUBComponentModel> const componentModel in viewModel.bodyComponentModels) {
+        [self componentForModel:componentModel];
+    }
+    
+    return [self.componentCache copy];
+}
 
-        [self registerComponentViewFrame:adjustedFrame forIndex:index];
+- (id<HUBComponent>)componentForModel:(id<HUBComponentModel>)model
+{
+    id<HUBComponent> const cachedComponent = self.componentCache[model.componentIdentifier];
+    
+    if (cachedComponent != nil) {
+        return cachedComponent;
     }
+    
+    id<HUBComponent> const newComponent = [self.componentRegistry createComponentForModel:model];
+    self.componentCache[model.componentIdentifier] = newComponent;
+    
+    if (HUBConformsToProtocol(newComponent, @protocol(HUBComponentWithChildren))) {
+        ((id<HUBComponentWithChildren>)newComponent).childDelegate = self;
+    }
+    
+    return newComponent;
 }
 
 @end
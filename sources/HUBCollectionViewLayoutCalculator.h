@@ -0,0 +1,84 @@
+/*
+ *  Copyright (c) 2016 Spotify AB.
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ */
+
+#import <UIKit/UIKit.h>
+#import "HUBHeaderMacros.h"
+
+@protocol HUBViewModel;
+@protocol HUBComponent;
+@protocol HUBComponentLayoutManager;
+@class HUBIdentifier;
+@class HUBViewModelDiff;
+@class HUBComponentSizeCache;
+@class HUBCollectionViewLayoutSnapshot;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Class that computes a single collection view layout, yielding an immutable snapshot
+ *
+ *  A calculator doesn't touch any UI or shared mutable state, besides the thread safe size cache, so it may be used on
+ *  a background queue as long as the components and the layout manager that it uses support that. All components needed
+ *  for the view model must be resolved before the calculator is created, which should be done on the main queue.
+ */
+@interface HUBCollectionViewLayoutCalculator : NSObject
+
+/**
+ *  Initialize an instance of this class with the input of a layout computation
+ *
+ *  @param viewModel The view model to compute a layout for
+ *  @param collectionViewSize The size of the collection view that will use the layout
+ *  @param addHeaderMargin Whether margin should be added to account for any header component
+ *  @param components The components to use for the models of the view model, keyed by component identifier
+ *  @param componentLayoutManager The manager responsible for component layout
+ *  @param sizeCache The cache to use to retrieve the preferred view sizes of components
+ *  @param measuringRect The rect within which components are measured. Components outside of it are given the
+ *         estimated size for their component identifier, if one exists. Pass `CGRectInfinite` to measure all components.
+ *  @param componentSizeEstimates Any sizes to use for components outside of the measuring rect, keyed by component
+ *         identifier. The first measured size of each component identifier is added to these estimates.
+ *  @param previousSnapshot Any previously computed snapshot, which parts of may be reused if a diff is given when
+ *         computing the layout
+ */
+- (instancetype)initWithViewModel:(id<HUBViewModel>)viewModel
+               collectionViewSize:(CGSize)collectionViewSize
+                  addHeaderMargin:(BOOL)addHeaderMargin
+                       components:(NSDictionary<HUBIdentifier *, id<HUBComponent>> *)components
+           componentLayoutManager:(id<HUBComponentLayoutManager>)componentLayoutManager
+                        sizeCache:(HUBComponentSizeCache *)sizeCache
+                    measuringRect:(CGRect)measuringRect
+           componentSizeEstimates:(nullable NSDictionary<HUBIdentifier *, NSValue *> *)componentSizeEstimates
+                 previousSnapshot:(nullable HUBCollectionViewLayoutSnapshot *)previousSnapshot HUB_DESIGNATED_INITIALIZER;
+
+/**
+ *  Compute the layout, returning a snapshot of it
+ *
+ *  @param diff Any diff between the view model of the previous snapshot and the view model to compute a layout for
+ *
+ *  If no diff is given, but the view model is the same as the one of the previous snapshot, only the components of the
+ *  previous snapshot that were estimated within the measuring rect are measured, and the rest of the layout is reused.
+ *
+ *  This method should only be called once per calculator.
+ */
+- (HUBCollectionViewLayoutSnapshot *)computeSnapshotWithDiff:(nullable HUBViewModelDiff *)diff;
+
+@end
+
+NS_ASSUME_NONNULL_END
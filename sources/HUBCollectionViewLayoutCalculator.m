@@ -0,0 +1,890 @@
+/*
+ *  Copyright (c) 2016 Spotify AB.
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ */
+
+#import "HUBCollectionViewLayoutCalculator.h"
+
+#import "HUBCollectionViewLayoutSnapshot.h"
+#import "HUBComponentSizeCache.h"
+#import "HUBViewModel.h"
+#import "HUBComponentModel.h"
+#import "HUBComponent.h"
+#import "HUBComponentWithDynamicSize.h"
+#import "HUBIdentifier.h"
+#import "HUBComponentLayoutManagerWithLayoutTraitMasks.h"
+#import "HUBViewModelDiff.h"
+#import "HUBUtilities.h"
+
+#import "CGFloat+HUBMath.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// The number of layout trait masks that don't contain any custom layout trait, which are tracked per row in a bitset
+static NSUInteger const HUBCollectionViewLayoutCalculatorBuiltInLayoutTraitMaskCount = HUBComponentLayoutTraitMaskCustom;
+
+/// Bit set in the layout trait mask set of a row if any of its margins have to be computed using sets of layout traits
+static uint64_t const HUBCollectionViewLayoutCalculatorRowRequiresLayoutTraitSets = (uint64_t)1 << HUBComponentLayoutTraitMaskCustom;
+
+/// Return the index of the first checkpoint for a row starting at or after a given component index
+static NSUInteger HUBCollectionViewLayoutRowCheckpointLowerBound(NSData *checkpointData, NSUInteger componentIndex)
+{
+    const HUBCollectionViewLayoutRowCheckpoint * const checkpoints = checkpointData.bytes;
+    NSUInteger lowerBound = 0;
+    NSUInteger upperBound = checkpointData.length / sizeof(HUBCollectionViewLayoutRowCheckpoint);
+    
+    while (lowerBound < upperBound) {
+        NSUInteger const middle = lowerBound + (upperBound - lowerBound) / 2;
+        
+        if (checkpoints[middle].componentIndex < componentIndex) {
+            lowerBound = middle + 1;
+        } else {
+            upperBound = middle;
+        }
+    }
+    
+    return lowerBound;
+}
+
+@interface HUBCollectionViewLayoutCalculator ()
+
+@property (nonatomic, strong, readonly) id<HUBViewModel> viewModel;
+@property (nonatomic, readonly) CGSize collectionViewSize;
+@property (nonatomic, readonly) BOOL addHeaderMargin;
+@property (nonatomic, copy, readonly) NSDictionary<HUBIdentifier *, id<HUBComponent>> *components;
+@property (nonatomic, strong, readonly) id<HUBComponentLayoutManager> componentLayoutManager;
+@property (nonatomic, strong, readonly, nullable) id<HUBComponentLayoutManagerWithLayoutTraitMasks> componentLayoutManagerWithLayoutTraitMasks;
+@property (nonatomic, strong, readonly) NSMapTable<id<HUBComponent>, NSNumber *> *layoutTraitMasksByComponent;
+@property (nonatomic, strong, readonly) NSMutableData *currentRowLayoutTraitMasks;
+@property (nonatomic) uint64_t currentRowLayoutTraitMaskSet;
+@property (nonatomic, strong, readonly) NSMutableData *verticalMarginsByLayoutTraitMasks;
+@property (nonatomic, strong, readonly) NSMutableData *previousRowLayoutTraitMasks;
+@property (nonatomic) CGFloat previousRowLeadingHorizontalOffset;
+@property (nonatomic) CGFloat previousRowTrailingHorizontalOffset;
+@property (nonatomic) CGFloat previousRowHorizontalAdjustment;
+@property (nonatomic, strong, readonly) HUBComponentSizeCache *sizeCache;
+@property (nonatomic, readonly) CGRect measuringRect;
+@property (nonatomic, strong, readonly) NSMutableDictionary<HUBIdentifier *, NSValue *> *componentSizeEstimates;
+@property (nonatomic, strong, readonly) NSMutableIndexSet *estimatedComponentIndexes;
+@property (nonatomic, strong, nullable) HUBViewModelDiff *diff;
+@property (nonatomic, strong, readonly, nullable) HUBCollectionViewLayoutSnapshot *previousSnapshot;
+@property (nonatomic, strong, readonly) NSMutableData *componentFrames;
+@property (nonatomic) BOOL containsComponentsWithDynamicSize;
+
+@end
+
+@implementation HUBCollectionViewLayoutCalculator
+
+- (instancetype)initWithViewModel:(id<HUBViewModel>)viewModel
+               collectionViewSize:(CGSize)collectionViewSize
+                  addHeaderMargin:(BOOL)addHeaderMargin
+                       components:(NSDictionary<HUBIdentifier *, id<HUBComponent>> *)components
+           componentLayoutManager:(id<HUBComponentLayoutManager>)componentLayoutManager
+                        sizeCache:(HUBComponentSizeCache *)sizeCache
+                    measuringRect:(CGRect)measuringRect
+           componentSizeEstimates:(nullable NSDictionary<HUBIdentifier *, NSValue *> *)componentSizeEstimates
+                 previousSnapshot:(nullable HUBCollectionViewLayoutSnapshot *)previousSnapshot
+{
+    self = [super init];
+    
+    if (self) {
+        _viewModel = viewModel;
+        _collectionViewSize = collectionViewSize;
+        _addHeaderMargin = addHeaderMargin;
+        _components = [components copy];
+        _componentLayoutManager = componentLayoutManager;
+        _layoutTraitMasksByComponent = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsObjectPointerPersonality
+                                                             valueOptions:NSPointerFunctionsStrongMemory];
+        _currentRowLayoutTraitMasks = [NSMutableData new];
+        _previousRowLayoutTraitMasks = [NSMutableData new];
+        
+        NSUInteger const verticalMarginCount = HUBCollectionViewLayoutCalculatorBuiltInLayoutTraitMaskCount * HUBCollectionViewLayoutCalculatorBuiltInLayoutTraitMaskCount;
+        _verticalMarginsByLayoutTraitMasks = [NSMutableData dataWithLength:verticalMarginCount * sizeof(CGFloat)];
+        CGFloat * const verticalMargins = _verticalMarginsByLayoutTraitMasks.mutableBytes;
+        
+        for (NSUInteger index = 0; index < verticalMarginCount; index++) {
+            verticalMargins[index] = NAN;
+        }
+        
+        if (HUBConformsToProtocol(componentLayoutManager, @protocol(HUBComponentLayoutManagerWithLayoutTraitMasks))) {
+            _componentLayoutManagerWithLayoutTraitMasks = (id<HUBComponentLayoutManagerWithLayoutTraitMasks>)componentLayoutManager;
+        }
+        _sizeCache = sizeCache;
+        _measuringRect = measuringRect;
+        _componentSizeEstimates = (componentSizeEstimates != nil) ? [componentSizeEstimates mutableCopy] : [NSMutableDictionary new];
+        _estimatedComponentIndexes = [NSMutableIndexSet new];
+        _previousSnapshot = previousSnapshot;
+        _componentFrames = [NSMutableData dataWithLength:viewModel.bodyComponentModels.count * sizeof(CGRect)];
+    }
+    
+    return self;
+}
+
+#pragma mark - API
+
+- (HUBCollectionViewLayoutSnapshot *)computeSnapshotWithDiff:(nullable HUBViewModelDiff *)diff
+{
+    self.diff = diff;
+    
+    HUBCollectionViewLayoutSnapshot * const previousSnapshot = self.previousSnapshot;
+    id<HUBViewModel> const previousViewModel = previousSnapshot.viewModel;
+    NSData * const previousRowCheckpoints = previousSnapshot.rowCheckpoints;
+    CGSize const collectionViewSize = self.collectionViewSize;
+    BOOL const addHeaderMargin = self.addHeaderMargin;
+    NSIndexSet * const refinedComponentIndexes = [self previousComponentIndexesToRefine];
+    BOOL const canReuseLayout = [self canReusePreviousSnapshotRefiningComponentIndexes:refinedComponentIndexes];
+    NSUInteger const reusableRowCheckpointCount = canReuseLayout ? [self reusableRowCheckpointCountForDiff:diff
+                                                                                  refinedComponentIndexes:refinedComponentIndexes] : 0;
+    
+    BOOL componentIsInTopRow = YES;
+    NSMutableArray<id<HUBComponent>> * const componentsOnCurrentRow = [NSMutableArray new];
+    CGFloat currentRowMaxY = 0;
+    CGPoint currentPoint = CGPointZero;
+    CGPoint firstComponentOnCurrentRowOrigin = CGPointZero;
+    NSUInteger const allComponentsCount = self.viewModel.bodyComponentModels.count;
+    CGSize contentSize = CGSizeZero;
+    CGFloat maxBottomRowComponentHeight = 0;
+    CGFloat maxBottomRowHeightWithMargins = 0;
+    NSUInteger currentRowFirstComponentIndex = 0;
+    NSUInteger firstComputedComponentIndex = 0;
+    NSMutableData * const rowCheckpoints = [NSMutableData new];
+    
+    if (reusableRowCheckpointCount > 0) {
+        // Resume the computation at the start of the first row that may have changed, keeping the frames before it
+        const HUBCollectionViewLayoutRowCheckpoint * const checkpoints = previousRowCheckpoints.bytes;
+        HUBCollectionViewLayoutRowCheckpoint const checkpoint = checkpoints[reusableRowCheckpointCount - 1];
+        
+        [rowCheckpoints appendBytes:checkpoints length:(reusableRowCheckpointCount - 1) * sizeof(HUBCollectionViewLayoutRowCheckpoint)];
+        
+        firstComputedComponentIndex = checkpoint.componentIndex;
+        currentRowFirstComponentIndex = checkpoint.previousRowFirstComponentIndex;
+        componentIsInTopRow = (currentRowFirstComponentIndex == 0);
+        currentRowMaxY = checkpoint.currentRowMaxY;
+        currentPoint = checkpoint.currentPoint;
+        firstComponentOnCurrentRowOrigin = checkpoint.firstComponentOnCurrentRowOrigin;
+        
+        for (NSUInteger componentIndex = currentRowFirstComponentIndex; componentIndex < firstComputedComponentIndex; componentIndex++) {
+            [self appendComponent:[self componentForModel:self.viewModel.bodyComponentModels[componentIndex]] toCurrentRow:componentsOnCurrentRow];
+        }
+        
+        [self.componentFrames replaceBytesInRange:NSMakeRange(0, firstComputedComponentIndex * sizeof(CGRect))
+                                        withBytes:previousSnapshot.componentFrames.bytes];
+        
+        NSMutableIndexSet * const reusedEstimatedComponentIndexes = [previousSnapshot.estimatedComponentIndexes mutableCopy];
+        [reusedEstimatedComponentIndexes removeIndexesInRange:NSMakeRange(firstComputedComponentIndex, (NSUInteger)NSNotFound - firstComputedComponentIndex)];
+        [self.estimatedComponentIndexes addIndexes:reusedEstimatedComponentIndexes];
+    }
+    
+    NSInteger const componentsCountChange = (NSInteger)allComponentsCount - (NSInteger)previousViewModel.bodyComponentModels.count;
+    NSUInteger const firstUnchangedTrailingComponentIndex = canReuseLayout ? [self firstUnchangedTrailingComponentIndexForDiff:diff
+                                                                                                       refinedComponentIndexes:refinedComponentIndexes
+                                                                                                         componentsCountChange:componentsCountChange] : NSNotFound;
+    BOOL contentSizeComputed = NO;
+    
+    for (NSUInteger componentIndex = firstComputedComponentIndex; componentIndex < allComponentsCount; componentIndex++) {
+        if (canReuseLayout && componentIndex > firstComputedComponentIndex && componentIndex >= firstUnchangedTrailingComponentIndex) {
+            NSUInteger const previousComponentIndex = (NSUInteger)((NSInteger)componentIndex - componentsCountChange);
+            NSUInteger const previousCheckpointIndex = [self indexOfRowCheckpointForComponentIndex:previousComponentIndex
+                                                                                      inCheckpoints:previousRowCheckpoints];
+            
+            if (previousCheckpointIndex != NSNotFound) {
+                HUBCollectionViewLayoutRowCheckpoint const checkpoint = ((const HUBCollectionViewLayoutRowCheckpoint *)previousRowCheckpoints.bytes)[previousCheckpointIndex];
+                CGFloat const verticalOffset = currentRowMaxY - checkpoint.currentRowMaxY;
+                
+                BOOL const stateMatchesCheckpoint = [self currentRowComponents:componentsOnCurrentRow
+                                                                currentPoint:currentPoint
+                                            firstComponentOnCurrentRowOrigin:firstComponentOnCurrentRowOrigin
+                                                              verticalOffset:verticalOffset
+                                                          matchRowCheckpoint:checkpoint
+                                                           previousViewModel:previousViewModel];
+                
+                if (stateMatchesCheckpoint) {
+                    // The rest of the layout is the same as before, only shifted vertically, so it doesn't need to be computed
+                    [self updateLayoutAttributesForComponentsIfNeeded:componentsOnCurrentRow
+                                                   lastComponentIndex:(NSInteger)componentIndex - 1
+                                                      firstComponentX:firstComponentOnCurrentRowOrigin.x
+                                                       lastComponentX:currentPoint.x
+                                                             rowWidth:collectionViewSize.width];
+                    
+                    [self reuseSnapshotFromRowCheckpointAtIndex:previousCheckpointIndex
+                                          componentsCountChange:componentsCountChange
+                                                 verticalOffset:verticalOffset
+                                                 rowCheckpoints:rowCheckpoints];
+                    
+                    contentSize = CGSizeMake(collectionViewSize.width, previousSnapshot.contentSize.height + verticalOffset);
+                    contentSizeComputed = YES;
+                    break;
+                }
+            }
+        }
+        
+        id<HUBComponentModel> const componentModel = self.viewModel.bodyComponentModels[componentIndex];
+        id<HUBComponent> const component = [self componentForModel:componentModel];
+        BOOL isLastComponent = (componentIndex == allComponentsCount - 1);
+
+        CGRect componentViewFrame = [self defaultViewFrameForComponent:component
+                                                                 model:componentModel
+                                                                 index:componentIndex
+                                                          currentPoint:currentPoint
+                                                        currentRowMaxY:currentRowMaxY
+                                                    collectionViewSize:collectionViewSize];
+
+        UIEdgeInsets margins = [self defaultMarginsForComponent:component
+                                                     isInTopRow:componentIsInTopRow
+                                         componentsOnCurrentRow:componentsOnCurrentRow
+                                             collectionViewSize:collectionViewSize
+                                                addHeaderMargin:addHeaderMargin];
+
+        componentViewFrame.origin.x = currentPoint.x + margins.left;
+
+        BOOL couldFitOnTheRow = CGRectGetMaxX(componentViewFrame) + margins.right <= collectionViewSize.width;
+        
+        if (couldFitOnTheRow == NO) {
+            HUBCollectionViewLayoutRowCheckpoint const checkpoint = {
+                .componentIndex = componentIndex,
+                .previousRowFirstComponentIndex = currentRowFirstComponentIndex,
+                .currentRowMaxY = currentRowMaxY,
+                .currentPoint = currentPoint,
+                .firstComponentOnCurrentRowOrigin = firstComponentOnCurrentRowOrigin
+            };
+            
+            [rowCheckpoints appendBytes:&checkpoint length:sizeof(checkpoint)];
+            
+            // When resuming a computation, the previous row has already been adjusted
+            if (componentIndex != firstComputedComponentIndex || reusableRowCheckpointCount == 0) {
+                [self updateLayoutAttributesForComponentsIfNeeded:componentsOnCurrentRow
+                                               lastComponentIndex:(NSInteger)componentIndex - 1
+                                                  firstComponentX:firstComponentOnCurrentRowOrigin.x
+                                                   lastComponentX:currentPoint.x
+                                                         rowWidth:collectionViewSize.width];
+            }
+
+            if (componentsOnCurrentRow.count > 0) {
+                margins.top = [self verticalMarginForComponent:component currentRowComponents:componentsOnCurrentRow];
+            }
+            
+            componentViewFrame.origin.x = [self marginBetweenComponent:component andContentEdge:HUBComponentLayoutContentEdgeLeft];
+            
+            componentViewFrame.origin.y = currentRowMaxY + margins.top;
+            componentIsInTopRow = NO;
+            [self removeAllComponentsFromCurrentRow:componentsOnCurrentRow];
+            currentRowFirstComponentIndex = componentIndex;
+            currentPoint.y = CGRectGetMinY(componentViewFrame);
+            currentRowMaxY = CGRectGetMaxY(componentViewFrame) + margins.bottom;
+        } else {
+            componentViewFrame.origin.y = currentPoint.y + margins.top;
+        }
+        
+        componentViewFrame = [self horizontallyAdjustComponentViewFrame:componentViewFrame
+                                                  forCollectionViewSize:collectionViewSize
+                                                                margins:margins];
+        
+        currentPoint.x = CGRectGetMaxX(componentViewFrame);
+        currentRowMaxY = HUBCGFloatMax(currentRowMaxY, CGRectGetMaxY(componentViewFrame));
+        
+        [self registerComponentViewFrame:componentViewFrame forIndex:componentIndex];
+        
+        [self appendComponent:component toCurrentRow:componentsOnCurrentRow];
+
+        if (componentsOnCurrentRow.count == 1) {
+            firstComponentOnCurrentRowOrigin = componentViewFrame.origin;
+        }
+
+        if (isLastComponent) {
+            // We center components if needed when we go to a new row. If it is the last row we need to center it here
+            [self updateLayoutAttributesForComponentsIfNeeded:componentsOnCurrentRow
+                                           lastComponentIndex:(NSInteger)componentIndex
+                                              firstComponentX:firstComponentOnCurrentRowOrigin.x
+                                               lastComponentX:currentPoint.x
+                                                     rowWidth:collectionViewSize.width];
+        }
+    }
+
+    if (contentSizeComputed == NO) {
+        contentSize = [self contentSizeForContentHeight:currentRowMaxY
+                                    bottomRowComponents:componentsOnCurrentRow
+                                    minimumBottomMargin:maxBottomRowHeightWithMargins - maxBottomRowComponentHeight
+                                     collectionViewSize:collectionViewSize];
+    }
+    
+    return [[HUBCollectionViewLayoutSnapshot alloc] initWithViewModel:self.viewModel
+                                                   collectionViewSize:collectionViewSize
+                                                      addHeaderMargin:addHeaderMargin
+                                                          contentSize:contentSize
+                                                      componentFrames:self.componentFrames
+                                                       rowCheckpoints:rowCheckpoints
+                                    containsComponentsWithDynamicSize:self.containsComponentsWithDynamicSize
+                                            estimatedComponentIndexes:self.estimatedComponentIndexes
+                                               componentSizeEstimates:self.componentSizeEstimates];
+}
+
+#pragma mark - Private utilities
+
+- (id<HUBComponent>)componentForModel:(id<HUBComponentModel>)model
+{
+    id<HUBComponent> const component = self.components[model.componentIdentifier];
+    NSAssert(component != nil, @"Components must be resolved before computing a layout, missing: %@", model.componentIdentifier);
+    return component;
+}
+
+- (CGSize)preferredViewSizeForComponent:(id<HUBComponent>)component
+                     displayingModel:(id<HUBComponentModel>)model
+                   containerViewSize:(CGSize)containerViewSize
+{
+    if (HUBConformsToProtocol(component, @protocol(HUBComponentWithDynamicSize))) {
+        self.containsComponentsWithDynamicSize = YES;
+    }
+    
+    return [self.sizeCache preferredViewSizeForComponent:component displayingModel:model containerViewSize:containerViewSize];
+}
+
+- (UIEdgeInsets)defaultMarginsForComponent:(id<HUBComponent>)component
+                                isInTopRow:(BOOL)componentIsInTopRow
+                    componentsOnCurrentRow:(NSArray<id<HUBComponent>> *)componentsOnCurrentRow
+                        collectionViewSize:(CGSize)collectionViewSize
+                           addHeaderMargin:(BOOL)addHeaderMargin
+{
+    UIEdgeInsets margins = UIEdgeInsetsZero;
+    
+    if (componentIsInTopRow) {
+        id<HUBComponentModel> const headerComponentModel = self.viewModel.headerComponentModel;
+
+        if (headerComponentModel != nil) {
+            if (addHeaderMargin) {
+                id<HUBComponent> const headerComponent = [self componentForModel:headerComponentModel];
+                CGSize headerSize = [self preferredViewSizeForComponent:headerComponent displayingModel:headerComponentModel containerViewSize:collectionViewSize];
+                margins.top = headerSize.height + [self verticalMarginBetweenComponent:component andHeaderComponent:headerComponent];
+            }
+        } else {
+            margins.top = [self marginBetweenComponent:component andContentEdge:HUBComponentLayoutContentEdgeTop];
+        }
+    }
+    
+    if (componentsOnCurrentRow.count == 0) {
+        margins.left = [self marginBetweenComponent:component andContentEdge:HUBComponentLayoutContentEdgeLeft];
+    } else {
+        id<HUBComponent> const precedingComponent = [componentsOnCurrentRow lastObject];
+        margins.left = [self horizontalMarginForComponent:component precedingComponent:precedingComponent];
+    }
+    
+    margins.right = [self marginBetweenComponent:component andContentEdge:HUBComponentLayoutContentEdgeRight];
+    
+    return margins;
+}
+
+- (CGRect)defaultViewFrameForComponent:(id<HUBComponent>)component
+                                 model:(id<HUBComponentModel>)componentModel
+                                 index:(NSUInteger)componentIndex
+                          currentPoint:(CGPoint)currentPoint
+                        currentRowMaxY:(CGFloat)currentRowMaxY
+                    collectionViewSize:(CGSize)collectionViewSize
+{
+    CGRect componentViewFrame = CGRectZero;
+    HUBIdentifier * const componentIdentifier = componentModel.componentIdentifier;
+    NSValue * const sizeEstimate = self.componentSizeEstimates[componentIdentifier];
+    
+    // The component either ends up on the current row or on a new one, so it can't reach outside of this range
+    CGFloat const estimatedMinY = currentPoint.y;
+    CGFloat const estimatedMaxY = currentRowMaxY + sizeEstimate.CGSizeValue.height;
+    CGRect const measuringRect = self.measuringRect;
+    
+    if (sizeEstimate != nil && (estimatedMaxY < CGRectGetMinY(measuringRect) || estimatedMinY > CGRectGetMaxY(measuringRect))) {
+        if (HUBConformsToProtocol(component, @protocol(HUBComponentWithDynamicSize))) {
+            self.containsComponentsWithDynamicSize = YES;
+        }
+        
+        componentViewFrame.size = sizeEstimate.CGSizeValue;
+        [self.estimatedComponentIndexes addIndex:componentIndex];
+    } else {
+        componentViewFrame.size = [self preferredViewSizeForComponent:component displayingModel:componentModel containerViewSize:collectionViewSize];
+        
+        // Keeping the first measured size as the estimate makes estimated frames stable, so that they can be reused
+        if (sizeEstimate == nil && !CGRectIsInfinite(measuringRect)) {
+            self.componentSizeEstimates[componentIdentifier] = [NSValue valueWithCGSize:componentViewFrame.size];
+        }
+    }
+    
+    componentViewFrame.size.width = MIN(CGRectGetWidth(componentViewFrame), collectionViewSize.width);
+    return componentViewFrame;
+}
+
+- (CGRect)horizontallyAdjustComponentViewFrame:(CGRect)componentViewFrame forCollectionViewSize:(CGSize)collectionViewSize margins:(UIEdgeInsets)margins
+{
+    CGFloat const horizontalOverflow = CGRectGetMaxX(componentViewFrame) + margins.right - collectionViewSize.width;
+    
+    if (horizontalOverflow > 0) {
+        componentViewFrame.size.width -= horizontalOverflow;
+    }
+    
+    return componentViewFrame;
+}
+
+- (void)registerComponentViewFrame:(CGRect)componentViewFrame forIndex:(NSUInteger)componentIndex
+{
+    CGRect * const frames = self.componentFrames.mutableBytes;
+    frames[componentIndex] = componentViewFrame;
+}
+
+- (NSIndexSet *)previousComponentIndexesToRefine
+{
+    HUBCollectionViewLayoutSnapshot * const previousSnapshot = self.previousSnapshot;
+    
+    if (previousSnapshot == nil) {
+        return [NSIndexSet indexSet];
+    }
+    
+    return [previousSnapshot indexesOfEstimatedComponentsInRect:self.measuringRect];
+}
+
+- (BOOL)canReusePreviousSnapshotRefiningComponentIndexes:(NSIndexSet *)refinedComponentIndexes
+{
+    HUBCollectionViewLayoutSnapshot * const previousSnapshot = self.previousSnapshot;
+    HUBViewModelDiff * const diff = self.diff;
+    
+    if (previousSnapshot == nil) {
+        return NO;
+    }
+    
+    // Without a diff, the only known changes are the estimated components that are now measured
+    BOOL const isRefiningPreviousSnapshot = (diff == nil && previousSnapshot.viewModel == self.viewModel && refinedComponentIndexes.count > 0);
+    
+    if (diff == nil && !isRefiningPreviousSnapshot) {
+        return NO;
+    }
+    
+    // The size of a component with a dynamic size may have changed even though its model didn't
+    if (previousSnapshot.containsComponentsWithDynamicSize) {
+        return NO;
+    }
+    
+    if (!CGSizeEqualToSize(self.collectionViewSize, previousSnapshot.collectionViewSize) || self.addHeaderMargin != previousSnapshot.addHeaderMargin) {
+        return NO;
+    }
+    
+    // The header affects the margins of the top row, which all other rows are positioned relative to
+    id<HUBComponentModel> const previousHeaderComponentModel = previousSnapshot.viewModel.headerComponentModel;
+    id<HUBComponentModel> const headerComponentModel = self.viewModel.headerComponentModel;
+    
+    if (previousHeaderComponentModel != headerComponentModel && ![previousHeaderComponentModel isEqual:headerComponentModel]) {
+        return NO;
+    }
+    
+    NSUInteger const previousComponentsCount = previousSnapshot.componentCount;
+    
+    if (diff == nil) {
+        return previousComponentsCount == self.viewModel.bodyComponentModels.count;
+    }
+    
+    // Make sure that the diff describes the changes since the previous snapshot
+    return previousComponentsCount + diff.insertedBodyComponentIndexPaths.count == self.viewModel.bodyComponentModels.count + diff.deletedBodyComponentIndexPaths.count;
+}
+
+- (NSUInteger)reusableRowCheckpointCountForDiff:(nullable HUBViewModelDiff *)diff
+                        refinedComponentIndexes:(NSIndexSet *)refinedComponentIndexes
+{
+    NSInteger firstChangedComponentIndex = NSIntegerMax;
+    
+    if (diff != nil) {
+        for (NSIndexPath * const indexPath in [self changedIndexPathsForDiff:diff]) {
+            firstChangedComponentIndex = MIN(firstChangedComponentIndex, indexPath.item);
+        }
+    }
+    
+    // Refined components use indexes from before any change, just like reloaded ones
+    if (refinedComponentIndexes.count > 0) {
+        firstChangedComponentIndex = MIN(firstChangedComponentIndex, (NSInteger)refinedComponentIndexes.firstIndex);
+    }
+    
+    // Rows are reusable up until the last one that starts before the first change, since a changed component may fit on it
+    if (firstChangedComponentIndex <= 0) {
+        return 0;
+    }
+    
+    return HUBCollectionViewLayoutRowCheckpointLowerBound(self.previousSnapshot.rowCheckpoints, (NSUInteger)firstChangedComponentIndex);
+}
+
+- (NSUInteger)firstUnchangedTrailingComponentIndexForDiff:(nullable HUBViewModelDiff *)diff
+                                  refinedComponentIndexes:(NSIndexSet *)refinedComponentIndexes
+                                    componentsCountChange:(NSInteger)componentsCountChange
+{
+    if (diff == nil && refinedComponentIndexes.count == 0) {
+        return NSNotFound;
+    }
+    
+    NSInteger firstUnchangedTrailingComponentIndex = MAX(0, componentsCountChange);
+    
+    if (refinedComponentIndexes.count > 0) {
+        firstUnchangedTrailingComponentIndex = MAX(firstUnchangedTrailingComponentIndex,
+                                                   (NSInteger)refinedComponentIndexes.lastIndex + 1 + componentsCountChange);
+    }
+    
+    if (diff == nil) {
+        return (NSUInteger)firstUnchangedTrailingComponentIndex;
+    }
+    
+    // Inserts and move destinations use indexes from after the change, the other changes use indexes from before it
+    for (NSIndexPath * const indexPath in diff.insertedBodyComponentIndexPaths) {
+        firstUnchangedTrailingComponentIndex = MAX(firstUnchangedTrailingComponentIndex, indexPath.item + 1);
+    }
+    
+    for (NSIndexPath * const indexPath in diff.movedBodyComponentIndexPaths.allValues) {
+        firstUnchangedTrailingComponentIndex = MAX(firstUnchangedTrailingComponentIndex, indexPath.item + 1);
+    }
+    
+    NSMutableArray<NSIndexPath *> * const previousIndexPaths = [NSMutableArray new];
+    [previousIndexPaths addObjectsFromArray:diff.deletedBodyComponentIndexPaths];
+    [previousIndexPaths addObjectsFromArray:diff.reloadedBodyComponentIndexPaths];
+    [previousIndexPaths addObjectsFromArray:diff.movedBodyComponentIndexPaths.allKeys];
+    
+    for (NSIndexPath * const indexPath in previousIndexPaths) {
+        firstUnchangedTrailingComponentIndex = MAX(firstUnchangedTrailingComponentIndex, indexPath.item + 1 + componentsCountChange);
+    }
+    
+    return (NSUInteger)firstUnchangedTrailingComponentIndex;
+}
+
+- (NSArray<NSIndexPath *> *)changedIndexPathsForDiff:(HUBViewModelDiff *)diff
+{
+    NSMutableArray<NSIndexPath *> * const indexPaths = [NSMutableArray new];
+    [indexPaths addObjectsFromArray:diff.insertedBodyComponentIndexPaths];
+    [indexPaths addObjectsFromArray:diff.deletedBodyComponentIndexPaths];
+    [indexPaths addObjectsFromArray:diff.reloadedBodyComponentIndexPaths];
+    [indexPaths addObjectsFromArray:diff.movedBodyComponentIndexPaths.allKeys];
+    [indexPaths addObjectsFromArray:diff.movedBodyComponentIndexPaths.allValues];
+    return indexPaths;
+}
+
+- (NSUInteger)indexOfRowCheckpointForComponentIndex:(NSUInteger)componentIndex inCheckpoints:(NSData *)checkpointData
+{
+    NSUInteger const index = HUBCollectionViewLayoutRowCheckpointLowerBound(checkpointData, componentIndex);
+    
+    if (index * sizeof(HUBCollectionViewLayoutRowCheckpoint) >= checkpointData.length) {
+        return NSNotFound;
+    }
+    
+    const HUBCollectionViewLayoutRowCheckpoint * const checkpoints = checkpointData.bytes;
+    return (checkpoints[index].componentIndex == componentIndex) ? index : NSNotFound;
+}
+
+- (BOOL)currentRowComponents:(NSArray<id<HUBComponent>> *)componentsOnCurrentRow
+                  currentPoint:(CGPoint)currentPoint
+firstComponentOnCurrentRowOrigin:(CGPoint)firstComponentOnCurrentRowOrigin
+                verticalOffset:(CGFloat)verticalOffset
+            matchRowCheckpoint:(HUBCollectionViewLayoutRowCheckpoint)checkpoint
+             previousViewModel:(id<HUBViewModel>)previousViewModel
+{
+    if (componentsOnCurrentRow.count != checkpoint.componentIndex - checkpoint.previousRowFirstComponentIndex) {
+        return NO;
+    }
+    
+    if (!HUBCGFloatIsZero(currentPoint.x - checkpoint.currentPoint.x)
+        || !HUBCGFloatIsZero(currentPoint.y - checkpoint.currentPoint.y - verticalOffset)
+        || !HUBCGFloatIsZero(firstComponentOnCurrentRowOrigin.x - checkpoint.firstComponentOnCurrentRowOrigin.x)
+        || !HUBCGFloatIsZero(firstComponentOnCurrentRowOrigin.y - checkpoint.firstComponentOnCurrentRowOrigin.y - verticalOffset)) {
+        return NO;
+    }
+    
+    // The layout traits of the components on a row determine the margins of the next one
+    for (NSUInteger index = 0; index < componentsOnCurrentRow.count; index++) {
+        id<HUBComponentModel> const previousComponentModel = previousViewModel.bodyComponentModels[checkpoint.previousRowFirstComponentIndex + index];
+        
+        if ([self componentForModel:previousComponentModel] != componentsOnCurrentRow[index]) {
+            return NO;
+        }
+    }
+    
+    return YES;
+}
+
+- (void)reuseSnapshotFromRowCheckpointAtIndex:(NSUInteger)checkpointIndex
+                        componentsCountChange:(NSInteger)componentsCountChange
+                               verticalOffset:(CGFloat)verticalOffset
+                               rowCheckpoints:(NSMutableData *)rowCheckpoints
+{
+    HUBCollectionViewLayoutSnapshot * const previousSnapshot = self.previousSnapshot;
+    NSData * const checkpointData = previousSnapshot.rowCheckpoints;
+    const HUBCollectionViewLayoutRowCheckpoint * const checkpoints = checkpointData.bytes;
+    NSUInteger const checkpointCount = checkpointData.length / sizeof(HUBCollectionViewLayoutRowCheckpoint);
+    NSUInteger const previousComponentsCount = previousSnapshot.componentCount;
+    
+    const CGRect * const previousFrames = previousSnapshot.componentFrames.bytes;
+    
+    for (NSUInteger previousIndex = checkpoints[checkpointIndex].componentIndex; previousIndex < previousComponentsCount; previousIndex++) {
+        NSUInteger const index = (NSUInteger)((NSInteger)previousIndex + componentsCountChange);
+        [self registerComponentViewFrame:CGRectOffset(previousFrames[previousIndex], 0, verticalOffset) forIndex:index];
+    }
+    
+    NSUInteger const firstReusedPreviousIndex = checkpoints[checkpointIndex].componentIndex;
+    NSMutableIndexSet * const reusedEstimatedComponentIndexes = [previousSnapshot.estimatedComponentIndexes mutableCopy];
+    [reusedEstimatedComponentIndexes removeIndexesInRange:NSMakeRange(0, firstReusedPreviousIndex)];
+    [reusedEstimatedComponentIndexes shiftIndexesStartingAtIndex:firstReusedPreviousIndex by:componentsCountChange];
+    [self.estimatedComponentIndexes addIndexes:reusedEstimatedComponentIndexes];
+    
+    for (NSUInteger index = checkpointIndex; index < checkpointCount; index++) {
+        HUBCollectionViewLayoutRowCheckpoint checkpoint = checkpoints[index];
+        checkpoint.componentIndex = (NSUInteger)((NSInteger)checkpoint.componentIndex + componentsCountChange);
+        checkpoint.previousRowFirstComponentIndex = (NSUInteger)((NSInteger)checkpoint.previousRowFirstComponentIndex + componentsCountChange);
+        checkpoint.currentRowMaxY += verticalOffset;
+        checkpoint.currentPoint.y += verticalOffset;
+        checkpoint.firstComponentOnCurrentRowOrigin.y += verticalOffset;
+        [rowCheckpoints appendBytes:&checkpoint length:sizeof(checkpoint)];
+    }
+}
+
+#pragma mark - Layout manager
+
+- (HUBComponentLayoutTraitMask)layoutTraitMaskForComponent:(id<HUBComponent>)component
+{
+    NSNumber * const cachedLayoutTraitMask = [self.layoutTraitMasksByComponent objectForKey:component];
+    
+    if (cachedLayoutTraitMask != nil) {
+        return cachedLayoutTraitMask.unsignedIntegerValue;
+    }
+    
+    HUBComponentLayoutTraitMask const layoutTraitMask = HUBComponentLayoutTraitMaskFromLayoutTraits(component.layoutTraits);
+    [self.layoutTraitMasksByComponent setObject:@(layoutTraitMask) forKey:component];
+    return layoutTraitMask;
+}
+
+/// Return the layout manager to use for a combination of layout trait masks, or nil if the traits need to be passed as sets
+- (nullable id<HUBComponentLayoutManagerWithLayoutTraitMasks>)layoutManagerForLayoutTraitMask:(HUBComponentLayoutTraitMask)layoutTraitMask
+{
+    if (layoutTraitMask & HUBComponentLayoutTraitMaskCustom) {
+        return nil;
+    }
+    
+    return self.componentLayoutManagerWithLayoutTraitMasks;
+}
+
+- (CGFloat)marginBetweenComponent:(id<HUBComponent>)component andContentEdge:(HUBComponentLayoutContentEdge)contentEdge
+{
+    HUBComponentLayoutTraitMask const layoutTraitMask = [self layoutTraitMaskForComponent:component];
+    id<HUBComponentLayoutManagerWithLayoutTraitMasks> const layoutManager = [self layoutManagerForLayoutTraitMask:layoutTraitMask];
+    
+    if (layoutManager != nil) {
+        return [layoutManager marginBetweenComponentWithLayoutTraitMask:layoutTraitMask andContentEdge:contentEdge];
+    }
+    
+    return [self.componentLayoutManager marginBetweenComponentWithLayoutTraits:component.layoutTraits andContentEdge:contentEdge];
+}
+
+- (CGFloat)verticalMarginBetweenComponent:(id<HUBComponent>)component andHeaderComponent:(id<HUBComponent>)headerComponent
+{
+    HUBComponentLayoutTraitMask const layoutTraitMask = [self layoutTraitMaskForComponent:component];
+    HUBComponentLayoutTraitMask const headerLayoutTraitMask = [self layoutTraitMaskForComponent:headerComponent];
+    id<HUBComponentLayoutManagerWithLayoutTraitMasks> const layoutManager = [self layoutManagerForLayoutTraitMask:layoutTraitMask | headerLayoutTraitMask];
+    
+    if (layoutManager != nil) {
+        return [layoutManager verticalMarginBetweenComponentWithLayoutTraitMask:layoutTraitMask
+                                          andHeaderComponentWithLayoutTraitMask:headerLayoutTraitMask];
+    }
+    
+    return [self.componentLayoutManager verticalMarginBetweenComponentWithLayoutTraits:component.layoutTraits
+                                                    andHeaderComponentWithLayoutTraits:headerComponent.layoutTraits];
+}
+
+- (CGFloat)horizontalMarginForComponent:(id<HUBComponent>)component precedingComponent:(id<HUBComponent>)precedingComponent
+{
+    HUBComponentLayoutTraitMask const layoutTraitMask = [self layoutTraitMaskForComponent:component];
+    HUBComponentLayoutTraitMask const precedingLayoutTraitMask = [self layoutTraitMaskForComponent:precedingComponent];
+    id<HUBComponentLayoutManagerWithLayoutTraitMasks> const layoutManager = [self layoutManagerForLayoutTraitMask:layoutTraitMask | precedingLayoutTraitMask];
+    
+    if (layoutManager != nil) {
+        return [layoutManager horizontalMarginForComponentWithLayoutTraitMask:layoutTraitMask
+                                            precedingComponentLayoutTraitMask:precedingLayoutTraitMask];
+    }
+    
+    return [self.componentLayoutManager horizontalMarginForComponentWithLayoutTraits:component.layoutTraits
+                                                      precedingComponentLayoutTraits:precedingComponent.layoutTraits];
+}
+
+- (CGFloat)verticalMarginForComponent:(id<HUBComponent>)component precedingComponent:(id<HUBComponent>)precedingComponent
+{
+    HUBComponentLayoutTraitMask const layoutTraitMask = [self layoutTraitMaskForComponent:component];
+    HUBComponentLayoutTraitMask const precedingLayoutTraitMask = [self layoutTraitMaskForComponent:precedingComponent];
+    id<HUBComponentLayoutManagerWithLayoutTraitMasks> const layoutManager = [self layoutManagerForLayoutTraitMask:layoutTraitMask | precedingLayoutTraitMask];
+    
+    if (layoutManager != nil) {
+        return [layoutManager verticalMarginForComponentWithLayoutTraitMask:layoutTraitMask
+                                          precedingComponentLayoutTraitMask:precedingLayoutTraitMask];
+    }
+    
+    return [self.componentLayoutManager verticalMarginForComponentWithLayoutTraits:component.layoutTraits
+                                                    precedingComponentLayoutTraits:precedingComponent.layoutTraits];
+}
+
+- (CGFloat)horizontalOffsetForComponents:(NSArray<id<HUBComponent>> *)components
+   firstComponentLeadingHorizontalOffset:(CGFloat)firstComponentLeadingOffsetX
+   lastComponentTrailingHorizontalOffset:(CGFloat)lastComponentTrailingOffsetX
+{
+    NSMutableData * const layoutTraitMaskData = self.currentRowLayoutTraitMasks;
+    NSAssert(layoutTraitMaskData.length == components.count * sizeof(HUBComponentLayoutTraitMask),
+             @"Horizontal offsets can only be computed for the current row");
+    
+    if (self.currentRowLayoutTraitMaskSet & HUBCollectionViewLayoutCalculatorRowRequiresLayoutTraitSets) {
+        return [self.componentLayoutManager horizontalOffsetForComponentsWithLayoutTraits:[self.class layoutTraitsFromComponents:components]
+                                                    firstComponentLeadingHorizontalOffset:firstComponentLeadingOffsetX
+                                                    lastComponentTrailingHorizontalOffset:lastComponentTrailingOffsetX];
+    }
+    
+    // Rows in a grid are usually identical, in which case the offset of the previous row can be reused
+    if (layoutTraitMaskData.length > 0
+        && [layoutTraitMaskData isEqualToData:self.previousRowLayoutTraitMasks]
+        && HUBCGFloatIsZero(firstComponentLeadingOffsetX - self.previousRowLeadingHorizontalOffset)
+        && HUBCGFloatIsZero(lastComponentTrailingOffsetX - self.previousRowTrailingHorizontalOffset)) {
+        return self.previousRowHorizontalAdjustment;
+    }
+    
+    CGFloat const horizontalAdjustment = [self.componentLayoutManagerWithLayoutTraitMasks horizontalOffsetForComponentsWithLayoutTraitMasks:layoutTraitMaskData.bytes
+                                                                                                                                      count:components.count
+                                                                                                      firstComponentLeadingHorizontalOffset:firstComponentLeadingOffsetX
+                                                                                                      lastComponentTrailingHorizontalOffset:lastComponentTrailingOffsetX];
+    
+    [self.previousRowLayoutTraitMasks setData:layoutTraitMaskData];
+    self.previousRowLeadingHorizontalOffset = firstComponentLeadingOffsetX;
+    self.previousRowTrailingHorizontalOffset = lastComponentTrailingOffsetX;
+    self.previousRowHorizontalAdjustment = horizontalAdjustment;
+    
+    return horizontalAdjustment;
+}
+
+#pragma mark - Current row
+
+- (void)appendComponent:(id<HUBComponent>)component toCurrentRow:(NSMutableArray<id<HUBComponent>> *)componentsOnCurrentRow
+{
+    [componentsOnCurrentRow addObject:component];
+    
+    HUBComponentLayoutTraitMask const layoutTraitMask = [self layoutTraitMaskForComponent:component];
+    [self.currentRowLayoutTraitMasks appendBytes:&layoutTraitMask length:sizeof(layoutTraitMask)];
+    
+    if (layoutTraitMask < HUBCollectionViewLayoutCalculatorBuiltInLayoutTraitMaskCount && self.componentLayoutManagerWithLayoutTraitMasks != nil) {
+        self.currentRowLayoutTraitMaskSet |= (uint64_t)1 << layoutTraitMask;
+    } else {
+        self.currentRowLayoutTraitMaskSet |= HUBCollectionViewLayoutCalculatorRowRequiresLayoutTraitSets;
+    }
+}
+
+- (void)removeAllComponentsFromCurrentRow:(NSMutableArray<id<HUBComponent>> *)componentsOnCurrentRow
+{
+    [componentsOnCurrentRow removeAllObjects];
+    self.currentRowLayoutTraitMasks.length = 0;
+    self.currentRowLayoutTraitMaskSet = 0;
+}
+
+- (CGFloat)verticalMarginForComponent:(id<HUBComponent>)component currentRowComponents:(NSArray<id<HUBComponent>> *)componentsOnCurrentRow
+{
+    HUBComponentLayoutTraitMask const layoutTraitMask = [self layoutTraitMaskForComponent:component];
+    uint64_t const rowLayoutTraitMaskSet = self.currentRowLayoutTraitMaskSet;
+    CGFloat margin = 0;
+    
+    if (layoutTraitMask >= HUBCollectionViewLayoutCalculatorBuiltInLayoutTraitMaskCount
+        || (rowLayoutTraitMaskSet & HUBCollectionViewLayoutCalculatorRowRequiresLayoutTraitSets)) {
+        for (id<HUBComponent> const verticallyPrecedingComponent in componentsOnCurrentRow) {
+            margin = HUBCGFloatMax(margin, [self verticalMarginForComponent:component precedingComponent:verticallyPrecedingComponent]);
+        }
+        
+        return margin;
+    }
+    
+    // The margin only depends on the masks, so each distinct mask on the row only needs to be considered once
+    uint64_t remainingLayoutTraitMasks = rowLayoutTraitMaskSet;
+    
+    while (remainingLayoutTraitMasks != 0) {
+        HUBComponentLayoutTraitMask const precedingLayoutTraitMask = (HUBComponentLayoutTraitMask)__builtin_ctzll(remainingLayoutTraitMasks);
+        remainingLayoutTraitMasks &= remainingLayoutTraitMasks - 1;
+        margin = HUBCGFloatMax(margin, [self verticalMarginForLayoutTraitMask:layoutTraitMask precedingLayoutTraitMask:precedingLayoutTraitMask]);
+    }
+    
+    return margin;
+}
+
+- (CGFloat)verticalMarginForLayoutTraitMask:(HUBComponentLayoutTraitMask)layoutTraitMask
+                   precedingLayoutTraitMask:(HUBComponentLayoutTraitMask)precedingLayoutTraitMask
+{
+    CGFloat * const verticalMargins = self.verticalMarginsByLayoutTraitMasks.mutableBytes;
+    NSUInteger const index = layoutTraitMask * HUBCollectionViewLayoutCalculatorBuiltInLayoutTraitMaskCount + precedingLayoutTraitMask;
+    
+    if (isnan(verticalMargins[index])) {
+        verticalMargins[index] = [self.componentLayoutManagerWithLayoutTraitMasks verticalMarginForComponentWithLayoutTraitMask:layoutTraitMask
+                                                                                               precedingComponentLayoutTraitMask:precedingLayoutTraitMask];
+    }
+    
+    return verticalMargins[index];
+}
+
+#pragma mark - Content size and row adjustment
+
+- (CGSize)contentSizeForContentHeight:(CGFloat)contentHeight
+                  bottomRowComponents:(NSArray<id<HUBComponent>> *)bottomRowComponents
+                  minimumBottomMargin:(CGFloat)minimumBottomMargin
+                   collectionViewSize:(CGSize)collectionViewSize
+{
+    CGFloat viewBottomMargin = 0;
+    
+    for (id<HUBComponent> const component in bottomRowComponents) {
+        CGFloat const componentBottomMargin = [self marginBetweenComponent:component andContentEdge:HUBComponentLayoutContentEdgeBottom];
+        
+        viewBottomMargin = HUBCGFloatMax(viewBottomMargin, componentBottomMargin);
+    }
+    
+    contentHeight += HUBCGFloatMax(viewBottomMargin, minimumBottomMargin);
+    
+    return CGSizeMake(collectionViewSize.width, contentHeight);
+}
+
+- (void)updateLayoutAttributesForComponentsIfNeeded:(NSArray<id<HUBComponent>> *)components
+                                 lastComponentIndex:(NSInteger)lastComponentIndex
+                                    firstComponentX:(CGFloat)firstComponentX
+                                     lastComponentX:(CGFloat)lastComponentX
+                                           rowWidth:(CGFloat)rowWidth
+{
+    CGFloat adjustment = [self horizontalOffsetForComponents:components
+                       firstComponentLeadingHorizontalOffset:firstComponentX
+                       lastComponentTrailingHorizontalOffset:rowWidth - lastComponentX];
+
+    [self updateLayoutAttributesForComponents:components horizontalAdjustment:adjustment lastComponentIndex:lastComponentIndex];
+}
+
++ (NSArray<NSSet<HUBComponentLayoutTrait> *> *)layoutTraitsFromComponents:(NSArray<id<HUBComponent>> *)components
+{
+    NSMutableArray *layoutTraints = [NSMutableArray new];
+    for (id<HUBComponent> component in components) {
+        [layoutTraints addObject:component.layoutTraits];
+    }
+    return [layoutTraints copy];
+}
+
+- (void)updateLayoutAttributesForComponents:(NSArray<id<HUBComponent>> *)components
+                       horizontalAdjustment:(CGFloat)horizontalAdjustment
+                         lastComponentIndex:(NSInteger)lastComponentIndex
+{
+    if (HUBCGFloatIsZero(horizontalAdjustment) || lastComponentIndex < 0) {
+        return;
+    }
+
+    CGRect * const frames = self.componentFrames.mutableBytes;
+    NSUInteger indexOfFirstComponentOnTheRow = (NSUInteger)lastComponentIndex - components.count + 1;
+    for (NSUInteger index = indexOfFirstComponentOnTheRow; index <= (NSUInteger)lastComponentIndex; index++) {
+        frames[index].origin.x += horizontalAdjustment;
+    }
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
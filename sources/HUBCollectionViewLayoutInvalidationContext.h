@@ -0,0 +1,44 @@
+/*
+ *  Copyright (c) 2016 Spotify AB.
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ */
+
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Invalidation context used by `HUBCollectionViewLayout`
+ *
+ *  The context describes why the layout was invalidated, so that the layout only does the work needed for that reason.
+ */
+@interface HUBCollectionViewLayoutInvalidationContext : UICollectionViewLayoutInvalidationContext
+
+/// Whether the layout was invalidated because the width of the collection view changed
+@property (nonatomic, assign) BOOL invalidatedCollectionViewWidth;
+
+/// Whether the layout was invalidated because components with estimated sizes became close to the visible area
+@property (nonatomic, assign) BOOL invalidatedEstimatedComponents;
+
+/// Whether the layout was invalidated because it was asked to be invalidated on every content offset change
+@property (nonatomic, assign) BOOL invalidatedContentOffset;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,135 @@
+/*
+ *  Copyright (c) 2016 Spotify AB.
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ */
+
+#import <UIKit/UIKit.h>
+#import "HUBHeaderMacros.h"
+
+@protocol HUBViewModel;
+@class HUBIdentifier;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// The state of a layout computation when reaching the first component of a row, used to resume computations
+typedef struct {
+    NSUInteger componentIndex;
+    NSUInteger previousRowFirstComponentIndex;
+    CGFloat currentRowMaxY;
+    CGPoint currentPoint;
+    CGPoint firstComponentOnCurrentRowOrigin;
+} HUBCollectionViewLayoutRowCheckpoint;
+
+/**
+ *  Immutable snapshot of a computed collection view layout
+ *
+ *  Snapshots are created by `HUBCollectionViewLayoutCalculator`, possibly on a background queue, and are committed to
+ *  a `HUBCollectionViewLayout` on the main queue. Besides the frames of all body components, a snapshot contains the
+ *  state needed to compute the next layout incrementally, and an index used to look up the components within a rect.
+ */
+@interface HUBCollectionViewLayoutSnapshot : NSObject
+
+/// The view model that the layout was computed for
+@property (nonatomic, strong, readonly) id<HUBViewModel> viewModel;
+
+/// The size of the collection view that the layout was computed for
+@property (nonatomic, readonly) CGSize collectionViewSize;
+
+/// Whether margin was added to account for any header component
+@property (nonatomic, readonly) BOOL addHeaderMargin;
+
+/// The size of the content of the layout
+@property (nonatomic, readonly) CGSize contentSize;
+
+/// The number of body components that the layout contains frames for
+@property (nonatomic, readonly) NSUInteger componentCount;
+
+/// The frames of all body components, as `CGRect` values in component index order
+@property (nonatomic, copy, readonly) NSData *componentFrames;
+
+/// The state of the computation at the start of each row, as `HUBCollectionViewLayoutRowCheckpoint` values in order
+@property (nonatomic, copy, readonly) NSData *rowCheckpoints;
+
+/// Whether the layout contains any component conforming to `HUBComponentWithDynamicSize`
+@property (nonatomic, readonly) BOOL containsComponentsWithDynamicSize;
+
+/// The indexes of the body components whose frames are based on an estimated size, rather than a measured one
+@property (nonatomic, copy, readonly) NSIndexSet *estimatedComponentIndexes;
+
+/// The sizes used for body components that weren't measured, as `CGSize` values keyed by component identifier
+@property (nonatomic, copy, readonly) NSDictionary<HUBIdentifier *, NSValue *> *componentSizeEstimates;
+
+/**
+ *  Initialize an instance of this class with the result of a layout computation
+ *
+ *  @param viewModel The view model that the layout was computed for
+ *  @param collectionViewSize The size of the collection view that the layout was computed for
+ *  @param addHeaderMargin Whether margin was added to account for any header component
+ *  @param contentSize The size of the content of the layout
+ *  @param componentFrames The frames of the body components, as `CGRect` values in component index order
+ *  @param rowCheckpoints The state of the computation at the start of each row
+ *  @param containsComponentsWithDynamicSize Whether the layout contains components with a dynamic size
+ *  @param estimatedComponentIndexes The indexes of the body components whose frames are based on an estimated size
+ *  @param componentSizeEstimates The sizes used for body components that weren't measured, keyed by component identifier
+ */
+- (instancetype)initWithViewModel:(id<HUBViewModel>)viewModel
+               collectionViewSize:(CGSize)collectionViewSize
+                  addHeaderMargin:(BOOL)addHeaderMargin
+                      contentSize:(CGSize)contentSize
+                  componentFrames:(NSData *)componentFrames
+                   rowCheckpoints:(NSData *)rowCheckpoints
+containsComponentsWithDynamicSize:(BOOL)containsComponentsWithDynamicSize
+        estimatedComponentIndexes:(NSIndexSet *)estimatedComponentIndexes
+           componentSizeEstimates:(NSDictionary<HUBIdentifier *, NSValue *> *)componentSizeEstimates HUB_DESIGNATED_INITIALIZER;
+
+/**
+ *  Return a snapshot with the same layout as this one, computed for a collection view with a different size
+ *
+ *  @param collectionViewSize The size of the collection view, which should have the same width as the one that this
+ *         snapshot was computed for, since frames depend on the width
+ */
+- (HUBCollectionViewLayoutSnapshot *)snapshotWithCollectionViewSize:(CGSize)collectionViewSize;
+
+/**
+ *  Return the frame of the body component at a given index
+ *
+ *  @param componentIndex The index of the component. If out of bounds, `CGRectZero` is returned.
+ */
+- (CGRect)frameForComponentAtIndex:(NSUInteger)componentIndex;
+
+/**
+ *  Return the indexes of all body components whose frames intersect a given rect
+ *
+ *  @param rect The rect to find components within
+ *
+ *  This method uses binary search, so its cost depends on the number of components within the rect, rather than on
+ *  the total number of components.
+ */
+- (NSIndexSet *)indexesOfComponentsInRect:(CGRect)rect;
+
+/**
+ *  Return the indexes of all body components whose frames intersect a given rect, and are based on an estimated size
+ *
+ *  @param rect The rect to find components within
+ */
+- (NSIndexSet *)indexesOfEstimatedComponentsInRect:(CGRect)rect;
+
+@end
+
+NS_ASSUME_NONNULL_END
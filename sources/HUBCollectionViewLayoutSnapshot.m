@@ -0,0 +1,204 @@
+/*
+ *  Copyright (c) 2016 Spotify AB.
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ */
+
+#import "HUBCollectionViewLayoutSnapshot.h"
+
+#import <stdlib.h>
+
+#import "HUBViewModel.h"
+#import "CGFloat+HUBMath.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Return the indexes of a set of component frames, sorted by the minimum Y of the frames
+static NSData *HUBCollectionViewLayoutSnapshotSortComponentIndexes(NSData *componentFrames)
+{
+    const CGRect * const frames = componentFrames.bytes;
+    NSUInteger const count = componentFrames.length / sizeof(CGRect);
+    NSMutableData * const sortedIndexData = [NSMutableData dataWithLength:count * sizeof(NSUInteger)];
+    NSUInteger * const sortedIndexes = sortedIndexData.mutableBytes;
+    
+    for (NSUInteger index = 0; index < count; index++) {
+        sortedIndexes[index] = index;
+    }
+    
+    if (count < 2) {
+        return sortedIndexData;
+    }
+    
+    // Components are laid out row by row, so this is close to sorted already, and a stable sort keeps the index order
+    mergesort_b(sortedIndexes, count, sizeof(NSUInteger), ^int(const void *indexA, const void *indexB) {
+        CGFloat const minYA = CGRectGetMinY(frames[*(const NSUInteger *)indexA]);
+        CGFloat const minYB = CGRectGetMinY(frames[*(const NSUInteger *)indexB]);
+        
+        if (minYA < minYB) {
+            return -1;
+        }
+        
+        if (minYA > minYB) {
+            return 1;
+        }
+        
+        return 0;
+    });
+    
+    return sortedIndexData;
+}
+
+/// Return the running maximum of the maximum Y of a set of component frames, in sorted index order
+static NSData *HUBCollectionViewLayoutSnapshotComputeRunningMaximumYs(NSData *componentFrames, NSData *sortedComponentIndexes)
+{
+    const CGRect * const frames = componentFrames.bytes;
+    const NSUInteger * const sortedIndexes = sortedComponentIndexes.bytes;
+    NSUInteger const count = sortedComponentIndexes.length / sizeof(NSUInteger);
+    NSMutableData * const maximumYData = [NSMutableData dataWithLength:count * sizeof(CGFloat)];
+    CGFloat * const maximumYs = maximumYData.mutableBytes;
+    CGFloat maximumY = -CGFLOAT_MAX;
+    
+    for (NSUInteger sortedIndex = 0; sortedIndex < count; sortedIndex++) {
+        maximumY = HUBCGFloatMax(maximumY, CGRectGetMaxY(frames[sortedIndexes[sortedIndex]]));
+        maximumYs[sortedIndex] = maximumY;
+    }
+    
+    return maximumYData;
+}
+
+@interface HUBCollectionViewLayoutSnapshot ()
+
+@property (nonatomic, copy, readonly) NSData *componentIndexesSortedByMinY;
+@property (nonatomic, copy, readonly) NSData *runningMaximumYs;
+
+@end
+
+@implementation HUBCollectionViewLayoutSnapshot
+
+- (instancetype)initWithViewModel:(id<HUBViewModel>)viewModel
+               collectionViewSize:(CGSize)collectionViewSize
+                  addHeaderMargin:(BOOL)addHeaderMargin
+                      contentSize:(CGSize)contentSize
+                  componentFrames:(NSData *)componentFrames
+                   rowCheckpoints:(NSData *)rowCheckpoints
+containsComponentsWithDynamicSize:(BOOL)containsComponentsWithDynamicSize
+        estimatedComponentIndexes:(NSIndexSet *)estimatedComponentIndexes
+           componentSizeEstimates:(NSDictionary<HUBIdentifier *, NSValue *> *)componentSizeEstimates
+{
+    self = [super init];
+    
+    if (self) {
+        _viewModel = viewModel;
+        _collectionViewSize = collectionViewSize;
+        _addHeaderMargin = addHeaderMargin;
+        _contentSize = contentSize;
+        _componentFrames = [componentFrames copy];
+        _componentCount = componentFrames.length / sizeof(CGRect);
+        _rowCheckpoints = [rowCheckpoints copy];
+        _containsComponentsWithDynamicSize = containsComponentsWithDynamicSize;
+        _estimatedComponentIndexes = [estimatedComponentIndexes copy];
+        _componentSizeEstimates = [componentSizeEstimates copy];
+        _componentIndexesSortedByMinY = HUBCollectionViewLayoutSnapshotSortComponentIndexes(_componentFrames);
+        _runningMaximumYs = HUBCollectionViewLayoutSnapshotComputeRunningMaximumYs(_componentFrames, _componentIndexesSortedByMinY);
+    }
+    
+    return self;
+}
+
+#pragma mark - API
+
+- (HUBCollectionViewLayoutSnapshot *)snapshotWithCollectionViewSize:(CGSize)collectionViewSize
+{
+    return [[HUBCollectionViewLayoutSnapshot alloc] initWithViewModel:self.viewModel
+                                                   collectionViewSize:collectionViewSize
+                                                      addHeaderMargin:self.addHeaderMargin
+                                                          contentSize:self.contentSize
+                                                      componentFrames:self.componentFrames
+                                                       rowCheckpoints:self.rowCheckpoints
+                                    containsComponentsWithDynamicSize:self.containsComponentsWithDynamicSize
+                                            estimatedComponentIndexes:self.estimatedComponentIndexes
+                                               componentSizeEstimates:self.componentSizeEstimates];
+}
+
+- (CGRect)frameForComponentAtIndex:(NSUInteger)componentIndex
+{
+    if (componentIndex >= self.componentCount) {
+        return CGRectZero;
+    }
+    
+    const CGRect * const frames = self.componentFrames.bytes;
+    return frames[componentIndex];
+}
+
+- (NSIndexSet *)indexesOfComponentsInRect:(CGRect)rect
+{
+    const CGRect * const frames = self.componentFrames.bytes;
+    const NSUInteger * const sortedIndexes = self.componentIndexesSortedByMinY.bytes;
+    const CGFloat * const runningMaximumYs = self.runningMaximumYs.bytes;
+    NSUInteger const count = self.componentCount;
+    
+    // Find the first component that could reach into the rect, using the running maximum Y, which never decreases
+    NSUInteger lowerBound = 0;
+    NSUInteger upperBound = count;
+    
+    while (lowerBound < upperBound) {
+        NSUInteger const middle = lowerBound + (upperBound - lowerBound) / 2;
+        
+        if (runningMaximumYs[middle] <= CGRectGetMinY(rect)) {
+            lowerBound = middle + 1;
+        } else {
+            upperBound = middle;
+        }
+    }
+    
+    NSMutableIndexSet * const indexes = [NSMutableIndexSet new];
+    
+    // Scan until reaching components that start below the rect, since all following components do too
+    for (NSUInteger sortedIndex = lowerBound; sortedIndex < count; sortedIndex++) {
+        CGRect const frame = frames[sortedIndexes[sortedIndex]];
+        
+        if (CGRectGetMinY(frame) >= CGRectGetMaxY(rect)) {
+            break;
+        }
+        
+        if (CGRectIntersectsRect(rect, frame)) {
+            [indexes addIndex:sortedIndexes[sortedIndex]];
+        }
+    }
+    
+    return indexes;
+}
+
+- (NSIndexSet *)indexesOfEstimatedComponentsInRect:(CGRect)rect
+{
+    NSIndexSet * const estimatedComponentIndexes = self.estimatedComponentIndexes;
+    
+    if (estimatedComponentIndexes.count == 0) {
+        return [NSIndexSet indexSet];
+    }
+    
+    NSIndexSet * const indexesInRect = [self indexesOfComponentsInRect:rect];
+    
+    return [indexesInRect indexesPassingTest:^BOOL(NSUInteger index, BOOL *stop) {
+        return [estimatedComponentIndexes containsIndex:index];
+    }];
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -42,6 +42,24 @@ NS_ASSUME_NONNULL_BEGIN
      groupIdentifierDidChange:(nullable NSString *)newGroupIdentifier
            oldGroupIdentifier:(nullable NSString *)oldGroupIdentifier;
 
+- (void)componentModelBuilderDidChange:(id<HUBComponentModelBuilder>)componentModelBuilder;
+
+@end
+
+/**
+ *  Holds the model that was most recently built by a component model builder
+ *
+ *  A cache is shared between a builder and any copies of it, for as long as none of them are modified, since they
+ *  will all build equal models. A builder that is modified stops using the shared cache.
+ */
+@interface HUBComponentModelBuildCache : NSObject
+
+@property (nonatomic, strong, nullable) HUBComponentModelImplementation *model;
+
+@end
+
+@implementation HUBComponentModelBuildCache
+
 @end
 
 @interface HUBComponentModelBuilderImplementation () <HUBComponentModelBuilderDelegate>
@@ -58,6 +76,7 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, strong, readonly) NSMutableDictionary<NSString *, HUBComponentModelBuilderImplementation *> *childBuilders;
 @property (nonatomic, strong, readonly) NSMutableArray<NSString *> *childIdentifierOrder;
 @property (nonatomic, strong, readonly) NSMutableDictionary<NSString *, NSMutableArray<id<HUBComponentModelBuilder>> *> *childBuildersByGroupIdentifier;
+@property (nonatomic, strong, nullable) HUBComponentModelBuildCache *buildCache;
 
 @end
 
@@ -81,6 +100,79 @@ NS_ASSUME_NONNULL_BEGIN
 @synthesize loggingData = _loggingData;
 @synthesize customData = _customData;
 
+#pragma mark - Property setters
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdirect-ivar-access"
+
+- (void)setComponentNamespace:(NSString *)componentNamespace
+{
+    _componentNamespace = [componentNamespace copy];
+    [self markAsModified];
+}
+
+- (void)setComponentName:(NSString *)componentName
+{
+    _componentName = [componentName copy];
+    [self markAsModified];
+}
+
+- (void)setComponentCategory:(HUBComponentCategory)componentCategory
+{
+    _componentCategory = [componentCategory copy];
+    [self markAsModified];
+}
+
+- (void)setTitle:(nullable NSString *)title
+{
+    _title = [title copy];
+    [self markAsModified];
+}
+
+- (void)setSubtitle:(nullable NSString *)subtitle
+{
+    _subtitle = [subtitle copy];
+    [self markAsModified];
+}
+
+- (void)setAccessoryTitle:(nullable NSString *)accessoryTitle
+{
+    _accessoryTitle = [accessoryTitle copy];
+    [self markAsModified];
+}
+
+- (void)setDescriptionText:(nullable NSString *)descriptionText
+{
+    _descriptionText = [descriptionText copy];
+    [self markAsModified];
+}
+
+- (void)setIconIdentifier:(nullable NSString *)iconIdentifier
+{
+    _iconIdentifier = [iconIdentifier copy];
+    [self markAsModified];
+}
+
+- (void)setMetadata:(nullable NSDictionary<NSString *, id> *)metadata
+{
+    _metadata = metadata;
+    [self markAsModified];
+}
+
+- (void)setLoggingData:(nullable NSDictionary<NSString *, id> *)loggingData
+{
+    _loggingData = loggingData;
+    [self markAsModified];
+}
+
+- (void)setCustomData:(nullable NSDictionary<NSString *, id> *)customData
+{
+    _customData = customData;
+    [self markAsModified];
+}
+
+#pragma clang diagnostic pop
+
 #pragma mark - Class methods
 
 + (NSArray<id<HUBComponentModel>> *)buildComponentModelsUsingBuilders:(NSDictionary<NSString *,HUBComponentModelBuilderImplementation *> *)builders
@@ -187,14 +279,17 @@ NS_ASSUME_NONNULL_BEGIN
 
 #pragma mark - HUBComponentModelBuilder
 
+// Image data and target builders don't report their changes, so handing them out counts as a modification
+
 - (id<HUBComponentImageDataBuilder>)mainImageDataBuilder
 {
+    [self markAsModified];
     return self.mainImageDataBuilderImplementation;
 }
 
 - (nullable NSURL *)mainImageURL
 {
-    return self.mainImageDataBuilder.URL;
+    return self.mainImageDataBuilderImplementation.URL;
 }
 
 - (void)setMainImageURL:(nullable NSURL *)mainImageURL
@@ -204,7 +299,7 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (nullable UIImage *)mainImage
 {
-    return self.mainImageDataBuilder.localImage;
+    return self.mainImageDataBuilderImplementation.localImage;
 }
 
 - (void)setMainImage:(nullable UIImage *)mainImage
@@ -214,17 +309,19 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (id<HUBComponentImageDataBuilder>)backgroundImageDataBuilder
 {
+    [self markAsModified];
     return self.backgroundImageDataBuilderImplementation;
 }
 
 - (id<HUBComponentTargetBuilder>)targetBuilder
 {
+    [self markAsModified];
     return [self getOrCreateTargetBuilder];
 }
 
 - (nullable NSURL *)backgroundImageURL
 {
-    return self.backgroundImageDataBuilder.URL;
+    return self.backgroundImageDataBuilderImplementation.URL;
 }
 
 - (void)setBackgroundImageURL:(nullable NSURL *)backgroundImageURL
@@ -234,7 +331,7 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (nullable UIImage *)backgroundImage
 {
-    return self.backgroundImageDataBuilder.localImage;
+    return self.backgroundImageDataBuilderImplementation.localImage;
 }
 
 - (void)setBackgroundImage:(nullable UIImage *)backgroundImage
@@ -249,6 +346,7 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (id<HUBComponentImageDataBuilder>)builderForCustomImageDataWithIdentifier:(NSString *)identifier
 {
+    [self markAsModified];
     return [self getOrCreateBuilderForCustomImageDataWithIdentifier:identifier];
 }
 
@@ -282,6 +380,12 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)removeBuilderForChildWithIdentifier:(NSString *)identifier
 {
     id<HUBComponentModelBuilder> builder = self.childBuilders[identifier];
+    
+    if (builder == nil) {
+        return;
+    }
+    
+    [self markAsModified];
     self.childBuilders[identifier] = nil;
     [self.childIdentifierOrder removeObject:identifier];
 
@@ -298,6 +402,10 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (void)removeAllChildBuilders
 {
+    if (self.childBuilders.count > 0) {
+        [self markAsModified];
+    }
+    
     [self.childBuilders removeAllObjects];
     [self.childIdentifierOrder removeAllObjects];
     [self.childBuildersByGroupIdentifier removeAllObjects];
@@ -312,6 +420,8 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (void)addJSONDictionary:(NSDictionary<NSString *, NSObject *> *)dictionary
 {
+    [self markAsModified];
+    
     id<HUBComponentModelJSONSchema> componentModelSchema = self.JSONSchema.componentModelSchema;
     
     NSString * const componentIdentifierString = [componentModelSchema.componentIdentifierPath stringFromJSONDictionary:dictionary];
@@ -447,7 +557,6 @@ NS_ASSUME_NONNULL_BEGIN
                                                                                                                 iconImageResolver:self.iconImageResolver
                                                                                                              mainImageDataBuilder:mainImageDataBuilder
                                                                                                        backgroundImageDataBuilder:backgroundImageDataBuilder];
-    copy.delegate = self.delegate;
     copy.componentNamespace = self.componentNamespace;
     copy.componentName = self.componentName;
     copy.componentCategory = self.componentCategory;
@@ -469,6 +578,7 @@ NS_ASSUME_NONNULL_BEGIN
 
     for (NSString * const childIdentifier in self.childBuilders) {
         HUBComponentModelBuilderImplementation *childBuilder = [self.childBuilders[childIdentifier] copy];
+        childBuilder.delegate = copy;
         copy.childBuilders[childIdentifier] = childBuilder;
 
         if (childBuilder.groupIdentifier != nil) {
@@ -484,6 +594,15 @@ NS_ASSUME_NONNULL_BEGIN
 
     [copy.childIdentifierOrder addObjectsFromArray:self.childIdentifierOrder];
     
+    // Assigned last, so that populating the copy doesn't notify the delegate or discard the shared build cache
+    copy.delegate = self.delegate;
+    
+    if (self.buildCache == nil) {
+        self.buildCache = [HUBComponentModelBuildCache new];
+    }
+    
+    copy.buildCache = self.buildCache;
+    
     return copy;
 }
 
@@ -491,6 +610,13 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (id<HUBComponentModel>)buildForIndex:(NSUInteger)index parent:(nullable id<HUBComponentModel>)parent
 {
+    HUBComponentModelImplementation * const cachedModel = self.buildCache.model;
+    
+    // The builder hasn't been modified since the cached model was built, so it can be reused if its position is the same
+    if (cachedModel != nil && cachedModel.index == index && cachedModel.parent == parent) {
+        return cachedModel;
+    }
+    
     HUBIdentifier * const componentIdentifier = [[HUBIdentifier alloc] initWithNamespace:self.componentNamespace
                                                                                     name:self.componentName];
     
@@ -538,6 +664,12 @@ NS_ASSUME_NONNULL_BEGIN
                                                                                identifierOrder:self.childIdentifierOrder
                                                                                         parent:model];
     
+    if (self.buildCache == nil) {
+        self.buildCache = [HUBComponentModelBuildCache new];
+    }
+    
+    self.buildCache.model = model;
+    
     return model;
 }
 
@@ -580,13 +712,20 @@ NS_ASSUME_NONNULL_BEGIN
 
     NSString *oldGroupIdentifier = _groupIdentifier;
 
-    _groupIdentifier = groupIdentifier;
+    _groupIdentifier = [groupIdentifier copy];
 
 #pragma clang diagnostic pop
 
+    [self markAsModified];
     [self.delegate componentModelBuilder:self groupIdentifierDidChange:self.groupIdentifier oldGroupIdentifier:oldGroupIdentifier];
 }
 
+- (void)markAsModified
+{
+    self.buildCache = nil;
+    [self.delegate componentModelBuilderDidChange:self];
+}
+
 - (HUBComponentModelBuilderImplementation *)getOrCreateBuilderForChildWithIdentifier:(nullable NSString *)identifier
 {
     if (identifier != nil) {
@@ -607,6 +746,7 @@ NS_ASSUME_NONNULL_BEGIN
                                                                                                              backgroundImageDataBuilder:nil];
     newBuilder.delegate = self;
     
+    [self markAsModified];
     self.childBuilders[newBuilder.modelIdentifier] = newBuilder;
     [self.childIdentifierOrder addObject:newBuilder.modelIdentifier];
     
@@ -632,6 +772,11 @@ NS_ASSUME_NONNULL_BEGIN
 
 #pragma mark - HUBComponentModelBuilderDelegate
 
+- (void)componentModelBuilderDidChange:(id<HUBComponentModelBuilder>)componentModelBuilder
+{
+    [self markAsModified];
+}
+
 - (void)componentModelBuilder:(id<HUBComponentModelBuilder>)componentModelBuilder groupIdentifierDidChange:(nullable NSString *)newGroupIdentifier oldGroupIdentifier:(nullable NSString *)oldGroupIdentifier
 {
     if (oldGroupIdentifier != nil) {
@@ -69,6 +69,12 @@ NS_ASSUME_NONNULL_BEGIN
         nil];
 }
 
++ (nullable NSArray<NSString *> *)prioritizedAutoEquatablePropertyNames
+{
+    return @[HUBKeyPath((id<HUBComponentModel>)nil, identifier),
+             HUBKeyPath((id<HUBComponentModel>)nil, componentIdentifier)];
+}
+
 #pragma mark - Initializer
 
 - (instancetype)initWithIdentifier:(NSString *)identifier
@@ -0,0 +1,72 @@
+/*
+ *  Copyright (c) 2016 Spotify AB.
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ */
+
+#import <UIKit/UIKit.h>
+#import "HUBHeaderMacros.h"
+
+@protocol HUBComponent;
+@protocol HUBComponentModel;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ *  Class that caches the preferred view sizes of components
+ *
+ *  Sizes are cached based on the identifier of the component, the content of the model (through its hash and
+ *  equality) and the size of the container view, so cached sizes remain valid across layout computations, and
+ *  can be reused when returning to a previously used container view size (for example after rotating back).
+ *
+ *  Components conforming to `HUBComponentWithDynamicSize` are always asked for their preferred view size.
+ */
+@interface HUBComponentSizeCache : NSObject
+
+/**
+ *  Initialize an instance of this class with a maximum number of sizes to cache
+ *
+ *  @param countLimit The maximum number of sizes that the cache should hold. Sizes may be evicted before this
+ *         limit is reached, for example when the system is low on memory.
+ */
+- (instancetype)initWithCountLimit:(NSUInteger)countLimit HUB_DESIGNATED_INITIALIZER;
+
+/**
+ *  Return the preferred view size of a component for displaying a certain model
+ *
+ *  @param component The component to return the preferred view size of
+ *  @param model The model that the component will display
+ *  @param containerViewSize The size of the container in which the component's view will be displayed
+ *
+ *  If no size is cached for the component, model and container view size, the component is asked for its
+ *  preferred view size, which is then cached.
+ */
+- (CGSize)preferredViewSizeForComponent:(id<HUBComponent>)component
+                     displayingModel:(id<HUBComponentModel>)model
+                   containerViewSize:(CGSize)containerViewSize;
+
+/**
+ *  Remove all sizes from the cache
+ *
+ *  Sizes that are being measured on other threads while the cache is cleared won't be cached.
+ */
+- (void)removeAllSizes;
+
+@end
+
+NS_ASSUME_NONNULL_END
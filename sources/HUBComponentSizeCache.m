@@ -0,0 +1,154 @@
+/*
+ *  Copyright (c) 2016 Spotify AB.
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ */
+
+#import "HUBComponentSizeCache.h"
+
+#import "HUBComponentWithDynamicSize.h"
+#import "HUBComponentModel.h"
+#import "HUBIdentifier.h"
+#import "HUBUtilities.h"
+
+#import <stdatomic.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Key used to look up sizes in a `HUBComponentSizeCache`
+@interface HUBComponentSizeCacheKey : NSObject
+
+@property (nonatomic, strong, readonly) HUBIdentifier *componentIdentifier;
+@property (nonatomic, strong, readonly) id<HUBComponentModel> model;
+@property (nonatomic, readonly) CGSize containerViewSize;
+
+- (instancetype)initWithComponentIdentifier:(HUBIdentifier *)componentIdentifier
+                                      model:(id<HUBComponentModel>)model
+                          containerViewSize:(CGSize)containerViewSize HUB_DESIGNATED_INITIALIZER;
+
+@end
+
+@implementation HUBComponentSizeCacheKey
+
+- (instancetype)initWithComponentIdentifier:(HUBIdentifier *)componentIdentifier
+                                      model:(id<HUBComponentModel>)model
+                          containerViewSize:(CGSize)containerViewSize
+{
+    self = [super init];
+    
+    if (self) {
+        _componentIdentifier = componentIdentifier;
+        _model = model;
+        _containerViewSize = containerViewSize;
+    }
+    
+    return self;
+}
+
+- (BOOL)isEqual:(id)object
+{
+    if (object == self) {
+        return YES;
+    }
+    
+    if (![object isKindOfClass:[HUBComponentSizeCacheKey class]]) {
+        return NO;
+    }
+    
+    HUBComponentSizeCacheKey * const key = object;
+    
+    if (!CGSizeEqualToSize(self.containerViewSize, key.containerViewSize)) {
+        return NO;
+    }
+    
+    if (![self.componentIdentifier isEqual:key.componentIdentifier]) {
+        return NO;
+    }
+    
+    return self.model == key.model || [self.model isEqual:key.model];
+}
+
+- (NSUInteger)hash
+{
+    NSUInteger const sizeHash = (NSUInteger)self.containerViewSize.width * 31 + (NSUInteger)self.containerViewSize.height;
+    return self.model.hash ^ (self.componentIdentifier.hash * 31) ^ (sizeHash * 961);
+}
+
+@end
+
+@interface HUBComponentSizeCache ()
+
+@property (nonatomic, strong, readonly) NSCache<HUBComponentSizeCacheKey *, NSValue *> *sizes;
+
+@end
+
+@implementation HUBComponentSizeCache
+{
+    /// Incremented whenever all sizes are removed, so that sizes measured before that aren't cached afterwards
+    _Atomic(NSUInteger) _generation;
+}
+
+- (instancetype)initWithCountLimit:(NSUInteger)countLimit
+{
+    self = [super init];
+    
+    if (self) {
+        _sizes = [NSCache new];
+        _sizes.countLimit = countLimit;
+    }
+    
+    return self;
+}
+
+- (CGSize)preferredViewSizeForComponent:(id<HUBComponent>)component
+                     displayingModel:(id<HUBComponentModel>)model
+                   containerViewSize:(CGSize)containerViewSize
+{
+    if (HUBConformsToProtocol(component, @protocol(HUBComponentWithDynamicSize))) {
+        return [component preferredViewSizeForDisplayingModel:model containerViewSize:containerViewSize];
+    }
+    
+    HUBComponentSizeCacheKey * const key = [[HUBComponentSizeCacheKey alloc] initWithComponentIdentifier:model.componentIdentifier
+                                                                                                   model:model
+                                                                                       containerViewSize:containerViewSize];
+    
+    NSValue * const cachedSize = [self.sizes objectForKey:key];
+    
+    if (cachedSize != nil) {
+        return cachedSize.CGSizeValue;
+    }
+    
+    NSUInteger const generation = atomic_load_explicit(&_generation, memory_order_acquire);
+    CGSize const size = [component preferredViewSizeForDisplayingModel:model containerViewSize:containerViewSize];
+    
+    if (atomic_load_explicit(&_generation, memory_order_acquire) == generation) {
+        [self.sizes setObject:[NSValue valueWithCGSize:size] forKey:key];
+    }
+    
+    return size;
+}
+
+- (void)removeAllSizes
+{
+    atomic_fetch_add_explicit(&_generation, 1, memory_order_release);
+    [self.sizes removeAllObjects];
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -34,6 +34,7 @@
 @class HUBComponentWrapper;
 @class HUBComponentUIStateManager;
 @class HUBComponentGestureRecognizer;
+@class HUBViewModelDiff;
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -163,6 +164,9 @@ willUpdateSelectionState:(HUBComponentSelectionState)selectionState;
 /// Whether the wrapped component is observing actions
 @property (nonatomic, readonly) BOOL isActionObserver;
 
+/// Whether the wrapped component is able to update its children in place
+@property (nonatomic, readonly) BOOL handlesChildUpdates;
+
 /// Whether the wrapped component's view has appeared since the model was last changed
 @property (nonatomic, readonly) BOOL viewHasAppearedSinceLastModelChange;
 
@@ -220,6 +224,18 @@ willUpdateSelectionState:(HUBComponentSelectionState)selectionState;
  */
 - (void)reconfigureViewWithContainerViewSize:(CGSize)containerViewSize;
 
+/**
+ *  Updates the component's view for changes made only to its children, without reconfiguring it
+ *
+ *  @param model The new model of the component
+ *  @param diff The changes to the component's children
+ *
+ *  Any child component wrappers for unchanged children are kept, and re-indexed according to their new position.
+ *  Modified children that can in turn update their own children in place are updated recursively. This method may
+ *  only be called for components that `handlesChildUpdates`.
+ */
+- (void)updateViewForChildChangesInModel:(id<HUBComponentModel>)model diff:(HUBViewModelDiff *)diff;
+
 @end
 
 NS_ASSUME_NONNULL_END
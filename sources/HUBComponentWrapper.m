@@ -22,15 +22,28 @@
 #import "HUBComponentWrapper.h"
 
 #import "HUBComponentActionPerformer.h"
+#import "HUBComponentWithChildren.h"
 #import "HUBComponentModel.h"
 #import "HUBComponentUIStateManager.h"
 #import "HUBComponentResizeObservingView.h"
 #import "HUBActionPerformer.h"
 #import "HUBComponentGestureRecognizer.h"
 #import "HUBUtilities.h"
+#import "HUBViewModelDiff.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
+static NSIndexSet *HUBIndexSetFromIndexPaths(NSArray<NSIndexPath *> *indexPaths)
+{
+    NSMutableIndexSet * const indexSet = [NSMutableIndexSet new];
+
+    for (NSIndexPath * const indexPath in indexPaths) {
+        [indexSet addIndex:(NSUInteger)indexPath.item];
+    }
+
+    return [indexSet copy];
+}
+
 @interface HUBComponentWrapper () <HUBComponentChildDelegate, HUBComponentResizeObservingViewDelegate, HUBActionPerformer, UIGestureRecognizerDelegate>
 
 @property (nonatomic, strong, readwrite) id<HUBComponentModel> model;
@@ -159,6 +172,11 @@ NS_ASSUME_NONNULL_BEGIN
     return HUBConformsToProtocol(self.component, @protocol(HUBComponentActionObserver));
 }
 
+- (BOOL)handlesChildUpdates
+{
+    return HUBConformsToProtocol(self.component, @protocol(HUBComponentWithChildUpdates));
+}
+
 - (BOOL)isRootComponent
 {
     return self.parent == nil;
@@ -205,7 +223,10 @@ NS_ASSUME_NONNULL_BEGIN
     self.component.view.accessibilityIdentifier = self.model.identifier;
 
     if (self.hasBeenConfigured) {
-        if ([self.model isEqual:model]) {
+        // Component models cache their hashes, which makes most changed models cheap to detect
+        id<HUBComponentModel> const currentModel = self.model;
+        
+        if (currentModel == model || (currentModel.hash == model.hash && [currentModel isEqual:model])) {
             return;
         }
         
@@ -230,6 +251,44 @@ NS_ASSUME_NONNULL_BEGIN
     [self.component configureViewWithModel:self.model containerViewSize:containerViewSize];
 }
 
+- (void)updateViewForChildChangesInModel:(id<HUBComponentModel>)model diff:(HUBViewModelDiff *)diff
+{
+    NSAssert(self.handlesChildUpdates, @"Attempted to update the children of a component that doesn't support it: %@", self.component);
+
+    NSIndexSet * const insertedIndexes = HUBIndexSetFromIndexPaths(diff.insertedBodyComponentIndexPaths);
+    NSIndexSet * const deletedIndexes = HUBIndexSetFromIndexPaths(diff.deletedBodyComponentIndexPaths);
+    NSMutableIndexSet * const reloadedIndexes = [HUBIndexSetFromIndexPaths(diff.reloadedBodyComponentIndexPaths) mutableCopy];
+    NSMutableDictionary<NSNumber *, NSNumber *> * const movedIndexes = [NSMutableDictionary dictionaryWithCapacity:diff.movedBodyComponentIndexPaths.count];
+
+    [diff.movedBodyComponentIndexPaths enumerateKeysAndObjectsUsingBlock:^(NSIndexPath *fromIndexPath, NSIndexPath *toIndexPath, BOOL *stop) {
+        movedIndexes[@(fromIndexPath.item)] = @(toIndexPath.item);
+    }];
+
+    // Children whose own children changed can be updated recursively, rather than being reloaded by the component
+    [diff.childComponentDiffs enumerateKeysAndObjectsUsingBlock:^(NSIndexPath *indexPath, HUBViewModelDiff *childDiff, BOOL *stop) {
+        HUBComponentWrapper * const childComponent = self.childrenByIndex[@(indexPath.item)];
+
+        if (childComponent.handlesChildUpdates && childDiff.parentComponentModel != nil) {
+            [childComponent updateViewForChildChangesInModel:childDiff.parentComponentModel diff:childDiff];
+            [reloadedIndexes removeIndex:(NSUInteger)indexPath.item];
+        }
+    }];
+
+    [self updateChildIndexesForModel:model
+                     insertedIndexes:insertedIndexes
+                      deletedIndexes:deletedIndexes
+                     reloadedIndexes:reloadedIndexes
+                        movedIndexes:movedIndexes];
+
+    self.model = model;
+
+    [(id<HUBComponentWithChildUpdates>)self.component updateViewForChildChangesInModel:model
+                                                                  insertedChildIndexes:insertedIndexes
+                                                                   deletedChildIndexes:deletedIndexes
+                                                                  reloadedChildIndexes:reloadedIndexes
+                                                                     movedChildIndexes:movedIndexes];
+}
+
 - (void)prepareViewForReuse
 {
     NSNumber * const index = @(self.model.index);
@@ -409,6 +468,70 @@ NS_ASSUME_NONNULL_BEGIN
     [self.delegate componentWrapper:self childSelectedAtIndex:childIndex customData:customData];
 }
 
+#pragma mark - Private utilities
+
+- (void)updateChildIndexesForModel:(id<HUBComponentModel>)model
+                   insertedIndexes:(NSIndexSet *)insertedIndexes
+                    deletedIndexes:(NSIndexSet *)deletedIndexes
+                   reloadedIndexes:(NSIndexSet *)reloadedIndexes
+                      movedIndexes:(NSDictionary<NSNumber *, NSNumber *> *)movedIndexes
+{
+    NSArray<id<HUBComponentModel>> * const children = model.children ?: @[];
+    NSUInteger const previousChildCount = self.model.children.count;
+    NSSet<NSNumber *> * const movedToIndexes = [NSSet setWithArray:movedIndexes.allValues];
+    NSMutableDictionary<NSNumber *, NSNumber *> * const newIndexes = [movedIndexes mutableCopy];
+
+    // Children that weren't inserted, deleted or moved keep their relative order, so they can be paired up in sequence
+    NSUInteger newIndex = 0;
+
+    for (NSUInteger previousIndex = 0; previousIndex < previousChildCount; previousIndex++) {
+        if ([deletedIndexes containsIndex:previousIndex] || movedIndexes[@(previousIndex)] != nil) {
+            continue;
+        }
+
+        while ([insertedIndexes containsIndex:newIndex] || [movedToIndexes containsObject:@(newIndex)]) {
+            newIndex++;
+        }
+
+        newIndexes[@(previousIndex)] = @(newIndex);
+        newIndex++;
+    }
+
+    NSDictionary<NSNumber *, HUBComponentWrapper *> * const previousChildrenByIndex = [self.childrenByIndex copy];
+    NSDictionary<NSNumber *, UIView *> * const previousVisibleChildViewsByIndex = [self.visibleChildViewsByIndex copy];
+    NSMutableArray<HUBComponentWrapper *> * const removedChildren = [NSMutableArray new];
+    [self.childrenByIndex removeAllObjects];
+    [self.visibleChildViewsByIndex removeAllObjects];
+
+    // Deleted and reloaded children are replaced by the component, which will ask for new child components for them
+    [previousChildrenByIndex enumerateKeysAndObjectsUsingBlock:^(NSNumber *previousIndex, HUBComponentWrapper *childComponent, BOOL *stop) {
+        NSNumber * const childIndex = newIndexes[previousIndex];
+
+        if (childIndex == nil || [reloadedIndexes containsIndex:previousIndex.unsignedIntegerValue]) {
+            [removedChildren addObject:childComponent];
+            return;
+        }
+
+        // The models of unchanged children are equal, but they still need to reflect their new position
+        childComponent.model = children[childIndex.unsignedIntegerValue];
+        self.childrenByIndex[childIndex] = childComponent;
+    }];
+
+    [previousVisibleChildViewsByIndex enumerateKeysAndObjectsUsingBlock:^(NSNumber *previousIndex, UIView *childView, BOOL *stop) {
+        NSNumber * const childIndex = newIndexes[previousIndex];
+
+        if (childIndex == nil || [reloadedIndexes containsIndex:previousIndex.unsignedIntegerValue]) {
+            return;
+        }
+
+        self.visibleChildViewsByIndex[childIndex] = childView;
+    }];
+
+    for (HUBComponentWrapper * const removedChild in removedChildren) {
+        [removedChild prepareViewForReuse];
+    }
+}
+
 #pragma mark - HUBComponentResizeObservingViewDelegate
 
 - (void)resizeObservingViewDidResize:(HUBComponentResizeObservingView *)view
@@ -19,7 +19,7 @@
  *  under the License.
  */
 
-#import "HUBComponentLayoutManager.h"
+#import "HUBComponentLayoutManagerWithLayoutTraitMasks.h"
 #import "HUBHeaderMacros.h"
 
 NS_ASSUME_NONNULL_BEGIN
@@ -29,9 +29,10 @@ NS_ASSUME_NONNULL_BEGIN
  *
  *  This layout manager applies a given `margin` (set in the initializer) to all components, except if
  *  two components are both stackable (vertical), or if a component is full width (horizontal). Adjustment
- *  is also made for centered components.
+ *  is also made for centered components. Custom layout traits are ignored, so sets of layout traits are converted
+ *  into masks and handled by the mask variants of the layout manager methods.
  */
-@interface HUBDefaultComponentLayoutManager : NSObject <HUBComponentLayoutManager>
+@interface HUBDefaultComponentLayoutManager : NSObject <HUBComponentLayoutManagerWithLayoutTraitMasks>
 
 /**
  *  Initialize an instance of this class
@@ -49,18 +49,65 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (CGFloat)marginBetweenComponentWithLayoutTraits:(NSSet<HUBComponentLayoutTrait> *)layoutTraits
                                    andContentEdge:(HUBComponentLayoutContentEdge)contentEdge
+{
+    return [self marginBetweenComponentWithLayoutTraitMask:HUBComponentLayoutTraitMaskFromLayoutTraits(layoutTraits)
+                                            andContentEdge:contentEdge];
+}
+
+- (CGFloat)verticalMarginBetweenComponentWithLayoutTraits:(NSSet<HUBComponentLayoutTrait> *)layoutTraits
+                       andHeaderComponentWithLayoutTraits:(NSSet<HUBComponentLayoutTrait> *)headerLayoutTraits
+{
+    return [self verticalMarginBetweenComponentWithLayoutTraitMask:HUBComponentLayoutTraitMaskFromLayoutTraits(layoutTraits)
+                             andHeaderComponentWithLayoutTraitMask:HUBComponentLayoutTraitMaskFromLayoutTraits(headerLayoutTraits)];
+}
+
+- (CGFloat)horizontalMarginForComponentWithLayoutTraits:(NSSet<HUBComponentLayoutTrait> *)layoutTraits
+                         precedingComponentLayoutTraits:(NSSet<HUBComponentLayoutTrait> *)precedingComponentLayoutTraits
+{
+    return [self horizontalMarginForComponentWithLayoutTraitMask:HUBComponentLayoutTraitMaskFromLayoutTraits(layoutTraits)
+                               precedingComponentLayoutTraitMask:HUBComponentLayoutTraitMaskFromLayoutTraits(precedingComponentLayoutTraits)];
+}
+
+- (CGFloat)verticalMarginForComponentWithLayoutTraits:(NSSet<HUBComponentLayoutTrait> *)layoutTraits
+                       precedingComponentLayoutTraits:(NSSet<HUBComponentLayoutTrait> *)precedingComponentLayoutTraits
+{
+    return [self verticalMarginForComponentWithLayoutTraitMask:HUBComponentLayoutTraitMaskFromLayoutTraits(layoutTraits)
+                             precedingComponentLayoutTraitMask:HUBComponentLayoutTraitMaskFromLayoutTraits(precedingComponentLayoutTraits)];
+}
+
+- (CGFloat)horizontalOffsetForComponentsWithLayoutTraits:(NSArray<NSSet<HUBComponentLayoutTrait> *> *)componentsTraits
+                   firstComponentLeadingHorizontalOffset:(CGFloat)firstComponentLeadingOffsetX
+                   lastComponentTrailingHorizontalOffset:(CGFloat)lastComponentTrailingOffsetX
+{
+    NSMutableData * const layoutTraitMaskData = [NSMutableData dataWithLength:componentsTraits.count * sizeof(HUBComponentLayoutTraitMask)];
+    HUBComponentLayoutTraitMask * const layoutTraitMasks = layoutTraitMaskData.mutableBytes;
+    
+    for (NSUInteger index = 0; index < componentsTraits.count; index++) {
+        layoutTraitMasks[index] = HUBComponentLayoutTraitMaskFromLayoutTraits(componentsTraits[index]);
+    }
+    
+    return [self horizontalOffsetForComponentsWithLayoutTraitMasks:layoutTraitMasks
+                                                             count:componentsTraits.count
+                             firstComponentLeadingHorizontalOffset:firstComponentLeadingOffsetX
+                             lastComponentTrailingHorizontalOffset:lastComponentTrailingOffsetX];
+}
+
+#pragma mark - HUBComponentLayoutManagerWithLayoutTraitMasks
+
+- (CGFloat)marginBetweenComponentWithLayoutTraitMask:(HUBComponentLayoutTraitMask)layoutTraitMask
+                                      andContentEdge:(HUBComponentLayoutContentEdge)contentEdge
 {
     switch (contentEdge) {
         case HUBComponentLayoutContentEdgeTop:
         case HUBComponentLayoutContentEdgeBottom:
-            if ([layoutTraits containsObject:HUBComponentLayoutTraitStackable]) {
+            if (layoutTraitMask & HUBComponentLayoutTraitMaskStackable) {
                 return 0;
             }
             
             break;
         case HUBComponentLayoutContentEdgeLeft:
         case HUBComponentLayoutContentEdgeRight:
-            if ([layoutTraits containsObject:HUBComponentLayoutTraitFullWidth]) {
+            if (layoutTraitMask & HUBComponentLayoutTraitMaskFullWidth) {
                 return 0;
             }
             
@@ -70,21 +117,21 @@ NS_ASSUME_NONNULL_BEGIN
     return self.margin;
 }
 
-- (CGFloat)verticalMarginBetweenComponentWithLayoutTraits:(NSSet<HUBComponentLayoutTrait> *)layoutTraits
-                       andHeaderComponentWithLayoutTraits:(NSSet<HUBComponentLayoutTrait> *)headerLayoutTraits
+- (CGFloat)verticalMarginBetweenComponentWithLayoutTraitMask:(HUBComponentLayoutTraitMask)layoutTraitMask
+                       andHeaderComponentWithLayoutTraitMask:(HUBComponentLayoutTraitMask)headerLayoutTraitMask
 {
-    return [self verticalMarginForComponentWithLayoutTraits:layoutTraits
-                             precedingComponentLayoutTraits:headerLayoutTraits];
+    return [self verticalMarginForComponentWithLayoutTraitMask:layoutTraitMask
+                             precedingComponentLayoutTraitMask:headerLayoutTraitMask];
 }
 
-- (CGFloat)horizontalMarginForComponentWithLayoutTraits:(NSSet<HUBComponentLayoutTrait> *)layoutTraits
-                         precedingComponentLayoutTraits:(NSSet<HUBComponentLayoutTrait> *)precedingComponentLayoutTraits
+- (CGFloat)horizontalMarginForComponentWithLayoutTraitMask:(HUBComponentLayoutTraitMask)layoutTraitMask
+                         precedingComponentLayoutTraitMask:(HUBComponentLayoutTraitMask)precedingComponentLayoutTraitMask
 {
-    if ([layoutTraits containsObject:HUBComponentLayoutTraitFullWidth]) {
+    if (layoutTraitMask & HUBComponentLayoutTraitMaskFullWidth) {
         return 0;
     } else {
-        BOOL const isCentered = [layoutTraits containsObject:HUBComponentLayoutTraitCentered];
-        BOOL const precedingIsCentered = [precedingComponentLayoutTraits containsObject:HUBComponentLayoutTraitCentered];
+        BOOL const isCentered = (layoutTraitMask & HUBComponentLayoutTraitMaskCentered) != 0;
+        BOOL const precedingIsCentered = (precedingComponentLayoutTraitMask & HUBComponentLayoutTraitMaskCentered) != 0;
         
         // Centered components are always grouped toghether
         if (isCentered != precedingIsCentered) {
@@ -95,25 +142,26 @@ NS_ASSUME_NONNULL_BEGIN
     return self.margin;
 }
 
-- (CGFloat)verticalMarginForComponentWithLayoutTraits:(NSSet<HUBComponentLayoutTrait> *)layoutTraits
-                       precedingComponentLayoutTraits:(NSSet<HUBComponentLayoutTrait> *)precedingComponentLayoutTraits
+- (CGFloat)verticalMarginForComponentWithLayoutTraitMask:(HUBComponentLayoutTraitMask)layoutTraitMask
+                       precedingComponentLayoutTraitMask:(HUBComponentLayoutTraitMask)precedingComponentLayoutTraitMask
 {
-    BOOL const shouldStack = [self shouldStackComponentWithLayoutTraits:layoutTraits
-                                         belowComponentWithLayoutTraits:precedingComponentLayoutTraits];
+    BOOL const shouldStack = [self shouldStackComponentWithLayoutTraitMask:layoutTraitMask
+                                         belowComponentWithLayoutTraitMask:precedingComponentLayoutTraitMask];
     
     return shouldStack ? 0 : self.margin;
 }
 
-- (CGFloat)horizontalOffsetForComponentsWithLayoutTraits:(NSArray<NSSet<HUBComponentLayoutTrait> *> *)componentsTraits
-                   firstComponentLeadingHorizontalOffset:(CGFloat)firstComponentLeadingOffsetX
-                   lastComponentTrailingHorizontalOffset:(CGFloat)lastComponentTrailingOffsetX
+- (CGFloat)horizontalOffsetForComponentsWithLayoutTraitMasks:(const HUBComponentLayoutTraitMask *)layoutTraitMasks
+                                                       count:(NSUInteger)count
+                       firstComponentLeadingHorizontalOffset:(CGFloat)firstComponentLeadingOffsetX
+                       lastComponentTrailingHorizontalOffset:(CGFloat)lastComponentTrailingOffsetX
 {
-    if (componentsTraits.count == 0) {
+    if (count == 0) {
         return 0;
     }
     
-    for (NSSet<HUBComponentLayoutTrait> *layoutTraits in componentsTraits) {
-        if ([layoutTraits containsObject:HUBComponentLayoutTraitCentered] == NO) {
+    for (NSUInteger index = 0; index < count; index++) {
+        if ((layoutTraitMasks[index] & HUBComponentLayoutTraitMaskCentered) == 0) {
             return 0;
         }
     }
@@ -124,15 +172,15 @@ NS_ASSUME_NONNULL_BEGIN
 
 #pragma mark - Private utilities
 
-- (BOOL)shouldStackComponentWithLayoutTraits:(NSSet<HUBComponentLayoutTrait> *)bottomLayoutTraits
-              belowComponentWithLayoutTraits:(NSSet<HUBComponentLayoutTrait> *)topLayoutTraits
+- (BOOL)shouldStackComponentWithLayoutTraitMask:(HUBComponentLayoutTraitMask)bottomLayoutTraitMask
+              belowComponentWithLayoutTraitMask:(HUBComponentLayoutTraitMask)topLayoutTraitMask
 {
-    if ([bottomLayoutTraits containsObject:HUBComponentLayoutTraitAlwaysStackUpwards]) {
+    if (bottomLayoutTraitMask & HUBComponentLayoutTraitMaskAlwaysStackUpwards) {
         return YES;
     }
     
-    return [topLayoutTraits containsObject:HUBComponentLayoutTraitStackable] &&
-           [bottomLayoutTraits containsObject:HUBComponentLayoutTraitStackable];
+    return (topLayoutTraitMask & HUBComponentLayoutTraitMaskStackable) &&
+           (bottomLayoutTraitMask & HUBComponentLayoutTraitMaskStackable);
 }
 
 @end
@@ -205,23 +205,47 @@ static inline BOOL HUBNavigationItemEqualToNavigationItem(UINavigationItem *navi
 }
 
 /**
- *  Copy the properties from an instance of `UINavigationItem` into another
+ *  Return the names of any properties that differ between two `UINavigationItem` instances
+ *
+ *  @param navigationItemA The first navigation item
+ *  @param navigationItemB The second navigation item
+ *
+ *  Only properties which have names included in the array obtained by calling `HUBNavigationItemPropertyNames()`
+ *  are compared. If either navigation item is nil, all of its properties are considered nil.
+ */
+static inline NSSet<NSString *> *HUBNavigationItemChangedPropertyNames(UINavigationItem * _Nullable navigationItemA, UINavigationItem * _Nullable navigationItemB)
+{
+    NSMutableSet<NSString *> * const changedPropertyNames = [NSMutableSet new];
+    
+    for (NSString * const propertyName in HUBNavigationItemPropertyNames()) {
+        if (!HUBPropertyIsEqual(navigationItemA, navigationItemB, propertyName)) {
+            [changedPropertyNames addObject:propertyName];
+        }
+    }
+    
+    return [changedPropertyNames copy];
+}
+
+/**
+ *  Copy a subset of the properties from an instance of `UINavigationItem` into another
  *
  *  @param navigationItemA The navigation item to copy values into
  *  @param navigationItemB Any navigation item to copy values from
+ *  @param propertyNames The names of the properties to copy
  *
  *  @return navigationItemA
  *
- *  If `navigationItemB` is nil, all `navigationItemA` properties will be reset to `nil`. To determine
- *  which properties that should be handled, `HUBNavigationItemPropertyNames()` is called.
+ *  If `navigationItemB` is nil, the given `navigationItemA` properties will be reset to `nil`.
  */
-static inline UINavigationItem *HUBCopyNavigationItemProperties(UINavigationItem *navigationItemA, UINavigationItem * _Nullable navigationItemB)
+static inline UINavigationItem *HUBCopyNavigationItemPropertiesWithNames(UINavigationItem *navigationItemA,
+                                                                         UINavigationItem * _Nullable navigationItemB,
+                                                                         id<NSFastEnumeration> propertyNames)
 {
     NSSet<NSString *> * const boolPropertyNames = [NSSet setWithObjects:HUBKeyPath(navigationItemA, hidesBackButton),
                                                                         HUBKeyPath(navigationItemA, leftItemsSupplementBackButton),
                                                                         nil];
     
-    for (NSString * const propertyName in HUBNavigationItemPropertyNames()) {
+    for (NSString * const propertyName in propertyNames) {
         id const value = [navigationItemB valueForKey:propertyName];
         
         if (value == nil) {
@@ -237,6 +261,22 @@ static inline UINavigationItem *HUBCopyNavigationItemProperties(UINavigationItem
     return navigationItemA;
 }
 
+/**
+ *  Copy the properties from an instance of `UINavigationItem` into another
+ *
+ *  @param navigationItemA The navigation item to copy values into
+ *  @param navigationItemB Any navigation item to copy values from
+ *
+ *  @return navigationItemA
+ *
+ *  If `navigationItemB` is nil, all `navigationItemA` properties will be reset to `nil`. To determine
+ *  which properties that should be handled, `HUBNavigationItemPropertyNames()` is called.
+ */
+static inline UINavigationItem *HUBCopyNavigationItemProperties(UINavigationItem *navigationItemA, UINavigationItem * _Nullable navigationItemB)
+{
+    return HUBCopyNavigationItemPropertiesWithNames(navigationItemA, navigationItemB, HUBNavigationItemPropertyNames());
+}
+
 /**
  *  Return a serialized string representation of a serializable object
  *
@@ -246,6 +246,17 @@ NS_ASSUME_NONNULL_BEGIN
     } completion:nil];
 }
 
+- (void)traitCollectionDidChange:(nullable UITraitCollection *)previousTraitCollection
+{
+    [super traitCollectionDidChange:previousTraitCollection];
+
+    UICollectionViewLayout * const layout = self.collectionView.collectionViewLayout;
+
+    if ([layout isKindOfClass:[HUBCollectionViewLayout class]]) {
+        [(HUBCollectionViewLayout *)layout collectionViewTraitCollectionDidChange:previousTraitCollection];
+    }
+}
+
 #pragma mark - HUBViewController
 
 - (NSString *)featureIdentifier
@@ -427,12 +438,20 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (void)viewModelLoader:(id<HUBViewModelLoader>)viewModelLoader didLoadViewModel:(id<HUBViewModel>)viewModel
 {
+    // Layouts precomputed for the current view model would be discarded once the new one is rendered
+    UICollectionViewLayout * const layout = self.collectionView.collectionViewLayout;
+
+    if ([layout isKindOfClass:[HUBCollectionViewLayout class]]) {
+        [(HUBCollectionViewLayout *)layout cancelPendingPrecomputations];
+    }
+
     HUBOperation * const willUpdateDelegateOperation = [HUBOperation synchronousOperationWithBlock:^{
         [self.delegate viewController:self willUpdateWithViewModel:viewModel];
     }];
 
     HUBOperation * const updateViewModelOperation = [HUBOperation synchronousOperationWithBlock:^{
-        HUBCopyNavigationItemProperties(self.navigationItem, viewModel.navigationItem);
+        NSSet<NSString *> * const changedNavigationItemPropertyNames = HUBNavigationItemChangedPropertyNames(self.navigationItem, viewModel.navigationItem);
+        HUBCopyNavigationItemPropertiesWithNames(self.navigationItem, viewModel.navigationItem, changedNavigationItemPropertyNames);
         self.viewModel = viewModel;
         self.viewModelHasChangedSinceLastLayoutUpdate = YES;
         [self.view setNeedsLayout];
@@ -870,6 +889,8 @@ willUpdateSelectionState:(HUBComponentSelectionState)selectionState
         diff = [HUBViewModelDiff diffFromViewModel:nonnullViewModel toViewModel:viewModel];
     }
 
+    [self configureOverlayComponentsForViewModel:viewModel diff:diff];
+
     BOOL const hasDiffChanges = (diff == nil || diff.hasChanges);
     UICollectionView *collectionView = self.collectionView;
     HUBCollectionViewLayout * const layout = (HUBCollectionViewLayout *)collectionView.collectionViewLayout;
@@ -904,7 +925,6 @@ willUpdateSelectionState:(HUBComponentSelectionState)selectionState
 
         [self saveStatesForVisibleComponents];
         [self configureHeaderComponent];
-        [self configureOverlayComponents];
         [self adjustCollectionViewContentInsetWithProposedTopValue:[self calculateTopContentInset]];
 
         self.viewModelHasChangedSinceLastLayoutUpdate = NO;
@@ -919,6 +939,7 @@ willUpdateSelectionState:(HUBComponentSelectionState)selectionState
                        [self headerAndOverlayComponentViewsWillAppear];
                        [self adjustCollectionViewContentInsetWithProposedTopValue:[self calculateTopContentInset]];
                        [self.delegate viewControllerDidFinishRendering:self];
+                       [(HUBCollectionViewLayout *)self.collectionView.collectionViewLayout precomputeForLikelyCollectionViewSizes];
                        completionHandler();
                    }];
     }];
@@ -1011,30 +1032,41 @@ willUpdateSelectionState:(HUBComponentSelectionState)selectionState
                                                                  previousComponentWrapper:self.headerComponentWrapper];
 }
 
-- (void)configureOverlayComponents
+- (void)configureOverlayComponentsForViewModel:(id<HUBViewModel>)viewModel diff:(nullable HUBViewModelDiff *)diff
 {
-    NSMutableArray * const currentOverlayComponentWrappers = [self.overlayComponentWrappers mutableCopy];
+    // The diff was calculated for the view model being rendered, which may be older than the latest loaded one
+    NSArray<id<HUBComponentModel>> * const componentModels = viewModel.overlayComponentModels;
+    NSArray<HUBComponentWrapper *> * const currentOverlayComponentWrappers = [self.overlayComponentWrappers copy];
     [self.overlayComponentWrappers removeAllObjects];
 
-    for (id<HUBComponentModel> const componentModel in self.viewModel.overlayComponentModels) {
+    // The diff can only be used to skip unchanged components if it was calculated from the currently rendered overlays
+    NSUInteger const previousComponentCount = componentModels.count - diff.insertedOverlayComponentIndexes.count + diff.deletedOverlayComponentIndexes.count;
+    BOOL const shouldSkipUnchangedComponents = (diff != nil && previousComponentCount == currentOverlayComponentWrappers.count);
+
+    for (NSUInteger componentIndex = 0; componentIndex < componentModels.count; componentIndex++) {
+        id<HUBComponentModel> const componentModel = componentModels[componentIndex];
         HUBComponentWrapper *componentWrapper = nil;
 
-        if (self.overlayComponentWrappers.count < currentOverlayComponentWrappers.count) {
-            NSUInteger const componentIndex = self.overlayComponentWrappers.count;
+        if (componentIndex < currentOverlayComponentWrappers.count) {
             componentWrapper = currentOverlayComponentWrappers[componentIndex];
-            [currentOverlayComponentWrappers removeObjectAtIndex:componentIndex];
         }
 
-        componentWrapper = [self configureHeaderOrOverlayComponentWrapperWithModel:componentModel
-                                                          previousComponentWrapper:componentWrapper];
+        BOOL const componentIsUnchanged = shouldSkipUnchangedComponents
+                                       && componentWrapper != nil
+                                       && ![diff.reloadedOverlayComponentIndexes containsIndex:componentIndex];
+
+        if (!componentIsUnchanged) {
+            componentWrapper = [self configureHeaderOrOverlayComponentWrapperWithModel:componentModel
+                                                              previousComponentWrapper:componentWrapper];
+        }
 
         [self.overlayComponentWrappers addObject:componentWrapper];
 
         componentWrapper.view.center = [self overlayComponentCenterPoint];
     }
 
-    for (HUBComponentWrapper * const unusedOverlayComponentWrapper in currentOverlayComponentWrappers) {
-        [self removeComponentWrapper:unusedOverlayComponentWrapper];
+    for (NSUInteger componentIndex = componentModels.count; componentIndex < currentOverlayComponentWrappers.count; componentIndex++) {
+        [self removeComponentWrapper:currentOverlayComponentWrappers[componentIndex]];
     }
 }
 
@@ -155,6 +155,19 @@ NS_ASSUME_NONNULL_BEGIN
     }
 }
 
+- (HUBDiffAlgorithm *)diffAlgorithmForFeatureRegistration:(HUBFeatureRegistration *)featureRegistration
+{
+    NSString * const algorithmName = featureRegistration.options[@"HUBViewModelDiff"];
+
+    if ([algorithmName isEqualToString:@"heckel"]) {
+        return HUBDiffHeckelAlgorithm;
+    } else if ([algorithmName isEqualToString:@"lcs"]) {
+        return HUBDiffLCSAlgorithm;
+    }
+
+    return HUBDiffMyersAlgorithm;
+}
+
 - (HUBViewController *)createStandardViewControllerForViewURI:(NSURL *)viewURI
                                           featureRegistration:(HUBFeatureRegistration *)featureRegistration
 {
@@ -164,7 +177,13 @@ NS_ASSUME_NONNULL_BEGIN
     HUBViewModelLoaderImplementation * const viewModelLoader = [self.viewModelLoaderFactory createViewModelLoaderForViewURI:viewURI
                                                                                                         featureRegistration:featureRegistration];
     
-    HUBViewModelRenderer * const viewModelRenderer = [HUBViewModelRenderer new];
+    HUBViewModelRenderer * const viewModelRenderer = [[HUBViewModelRenderer alloc] initWithDiffAlgorithm:[self diffAlgorithmForFeatureRegistration:featureRegistration]];
+    NSString * const maximumChangedFraction = featureRegistration.options[@"HUBViewModelDiffMaximumChangedFraction"];
+
+    if (maximumChangedFraction != nil) {
+        viewModelRenderer.maximumChangedFraction = (CGFloat)maximumChangedFraction.doubleValue;
+    }
+
     id<HUBImageLoader> const imageLoader = [self.imageLoaderFactory createImageLoader];
     HUBCollectionViewFactory * const collectionViewFactory = [HUBCollectionViewFactory new];
     HUBComponentReusePool * const componentReusePool = [[HUBComponentReusePool alloc] initWithComponentRegistry:self.componentRegistry];
@@ -177,17 +196,21 @@ NS_ASSUME_NONNULL_BEGIN
     
     id<HUBViewControllerScrollHandler> const scrollHandlerToUse = featureRegistration.viewControllerScrollHandler ?: [HUBViewControllerDefaultScrollHandler new];
     
-    return [[HUBViewControllerImplementation alloc] initWithViewURI:viewURI
-                                                        featureInfo:featureInfo
-                                                    viewModelLoader:viewModelLoader
-                                                  viewModelRenderer:viewModelRenderer
-                                              collectionViewFactory:collectionViewFactory
-                                                  componentRegistry:self.componentRegistry
-                                                 componentReusePool:componentReusePool
-                                             componentLayoutManager:self.componentLayoutManager
-                                                      actionHandler:actionHandlerWrapper
-                                                      scrollHandler:scrollHandlerToUse
-                                                        imageLoader:imageLoader];
+    HUBViewControllerImplementation * const viewController = [[HUBViewControllerImplementation alloc] initWithViewURI:viewURI
+                                                                                                           featureInfo:featureInfo
+                                                                                                       viewModelLoader:viewModelLoader
+                                                                                                     viewModelRenderer:viewModelRenderer
+                                                                                                 collectionViewFactory:collectionViewFactory
+                                                                                                     componentRegistry:self.componentRegistry
+                                                                                                    componentReusePool:componentReusePool
+                                                                                                componentLayoutManager:self.componentLayoutManager
+                                                                                                         actionHandler:actionHandlerWrapper
+                                                                                                         scrollHandler:scrollHandlerToUse
+                                                                                                           imageLoader:imageLoader];
+    
+    viewController.usesVirtualizedLayout = [featureRegistration.options[@"HUBCollectionViewLayout"] isEqualToString:@"virtualized"];
+    
+    return viewController;
 }
 
 - (HUBViewController *)createExperimentalViewControllerForViewURI:(NSURL *)viewURI
@@ -37,6 +37,9 @@ NS_ASSUME_NONNULL_BEGIN
 /// Extension enabling a HUBViewControllerImplementation instance to be initialized by the framework
 @interface HUBViewControllerImplementation : HUBViewController
 
+/// Whether the collection view layout of the view controller should be virtualized. See `HUBCollectionViewLayout`.
+@property (nonatomic, assign) BOOL usesVirtualizedLayout;
+
 /**
  *  Initialize an instance of this class with its required dependencies
  *
@@ -56,7 +56,8 @@ NS_ASSUME_NONNULL_BEGIN
     HUBViewModelLoaderDelegate,
     HUBComponentWrapperDelegate,
     UICollectionViewDataSource,
-    HUBCollectionViewDelegate
+    HUBCollectionViewDelegate,
+    HUBViewModelRendererDelegate
 >
 
 @property (nonatomic, strong, readonly) id<HUBFeatureInfo> featureInfo;
@@ -81,6 +82,7 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, strong, nullable) HUBComponentWrapper *highlightedComponentWrapper;
 @property (nonatomic, strong, readonly) HUBOperationQueue *renderingOperationQueue;
 @property (nonatomic, strong, nullable) id<HUBViewModel> viewModel;
+@property (nonatomic, strong, nullable) id<HUBViewModel> renderedViewModel;
 @property (nonatomic, assign) BOOL viewHasAppeared;
 @property (nonatomic, assign) BOOL viewHasBeenLaidOut;
 @property (nonatomic) BOOL viewModelHasChangedSinceLastLayoutUpdate;
@@ -144,6 +146,7 @@ NS_ASSUME_NONNULL_BEGIN
     _renderingOperationQueue = [HUBOperationQueue new];
 
     viewModelLoader.delegate = self;
+    viewModelRenderer.delegate = self;
     if (HUBConformsToProtocol(viewModelLoader, @protocol(HUBViewModelLoaderWithActions))) {
         ((id<HUBViewModelLoaderWithActions>)viewModelLoader).actionPerformer = self;
     }
@@ -257,6 +260,17 @@ NS_ASSUME_NONNULL_BEGIN
     } completion:nil];
 }
 
+- (void)traitCollectionDidChange:(nullable UITraitCollection *)previousTraitCollection
+{
+    [super traitCollectionDidChange:previousTraitCollection];
+
+    UICollectionViewLayout * const layout = self.collectionView.collectionViewLayout;
+
+    if ([layout isKindOfClass:[HUBCollectionViewLayout class]]) {
+        [(HUBCollectionViewLayout *)layout collectionViewTraitCollectionDidChange:previousTraitCollection];
+    }
+}
+
 #pragma mark - HUBViewController
 
 - (NSString *)featureIdentifier
@@ -438,12 +452,23 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (void)viewModelLoader:(id<HUBViewModelLoader>)viewModelLoader didLoadViewModel:(id<HUBViewModel>)viewModel
 {
+    // Any render still waiting for its diff would be immediately superseded, so let the new view model skip the line
+    [self.viewModelRenderer discardPendingRender];
+
+    // Layouts precomputed for the current view model would be discarded once the new one is rendered
+    UICollectionViewLayout * const layout = self.collectionView.collectionViewLayout;
+
+    if ([layout isKindOfClass:[HUBCollectionViewLayout class]]) {
+        [(HUBCollectionViewLayout *)layout cancelPendingPrecomputations];
+    }
+
     HUBOperation * const willUpdateDelegateOperation = [HUBOperation synchronousOperationWithBlock:^{
         [self.delegate viewController:self willUpdateWithViewModel:viewModel];
     }];
 
     HUBOperation * const updateViewModelOperation = [HUBOperation synchronousOperationWithBlock:^{
-        HUBCopyNavigationItemProperties(self.navigationItem, viewModel.navigationItem);
+        NSSet<NSString *> * const changedNavigationItemPropertyNames = HUBNavigationItemChangedPropertyNames(self.navigationItem, viewModel.navigationItem);
+        HUBCopyNavigationItemPropertiesWithNames(self.navigationItem, viewModel.navigationItem, changedNavigationItemPropertyNames);
         self.viewModel = viewModel;
         self.viewModelHasChangedSinceLastLayoutUpdate = YES;
         [self.view setNeedsLayout];
@@ -660,6 +685,40 @@ willUpdateSelectionState:(HUBComponentSelectionState)selectionState
                           componentModel:nil];
 }
 
+#pragma mark - HUBViewModelRendererDelegate
+
+- (void)viewModelRenderer:(HUBViewModelRenderer *)renderer
+      willRenderViewModel:(id<HUBViewModel>)viewModel
+                     diff:(nullable HUBViewModelDiff *)diff
+{
+    // The collection view keeps reflecting the previously rendered view model until its diff has been calculated
+    self.renderedViewModel = viewModel;
+    [self configureOverlayComponentsForViewModel:viewModel diff:diff];
+}
+
+- (BOOL)viewModelRenderer:(HUBViewModelRenderer *)renderer
+  applyChildComponentDiff:(HUBViewModelDiff *)childComponentDiff
+   toComponentAtIndexPath:(NSIndexPath *)indexPath
+{
+    id<HUBComponentModel> const componentModel = childComponentDiff.parentComponentModel;
+    HUBComponentCollectionViewCell * const cell = (HUBComponentCollectionViewCell *)[self.collectionView cellForItemAtIndexPath:indexPath];
+
+    // Cells that aren't currently displayed are cheaper to simply reload
+    if (componentModel == nil || cell == nil) {
+        return NO;
+    }
+
+    HUBComponentWrapper * const componentWrapper = [self componentWrapperFromCell:cell];
+
+    if (!componentWrapper.handlesChildUpdates) {
+        return NO;
+    }
+
+    [componentWrapper updateViewForChildChangesInModel:componentModel diff:childComponentDiff];
+
+    return YES;
+}
+
 #pragma mark - UICollectionViewDataSource
 
 - (NSInteger)numberOfSectionsInCollectionView:(UICollectionView *)collectionView
@@ -669,12 +728,12 @@ willUpdateSelectionState:(HUBComponentSelectionState)selectionState
 
 - (NSInteger)collectionView:(UICollectionView *)collectionView numberOfItemsInSection:(NSInteger)section
 {
-    return (NSInteger)self.viewModel.bodyComponentModels.count;
+    return (NSInteger)self.renderedViewModel.bodyComponentModels.count;
 }
 
 - (UICollectionViewCell *)collectionView:(UICollectionView *)collectionView cellForItemAtIndexPath:(NSIndexPath *)indexPath
 {
-    id<HUBComponentModel> const componentModel = self.viewModel.bodyComponentModels[(NSUInteger)indexPath.item];
+    id<HUBComponentModel> const componentModel = self.renderedViewModel.bodyComponentModels[(NSUInteger)indexPath.item];
     NSString * const cellReuseIdentifier = componentModel.componentIdentifier.identifierString;
 
     HUBComponentCollectionViewCell * const cell = [self.collectionView dequeueReusableCellWithReuseIdentifier:cellReuseIdentifier
@@ -860,13 +919,14 @@ willUpdateSelectionState:(HUBComponentSelectionState)selectionState
         }
 
         if (![self.collectionView.collectionViewLayout isKindOfClass:[HUBCollectionViewLayout class]]) {
-            self.collectionView.collectionViewLayout = [[HUBCollectionViewLayout alloc] initWithComponentRegistry:self.componentRegistry
-                                                                                           componentLayoutManager:self.componentLayoutManager];
+            HUBCollectionViewLayout * const layout = [[HUBCollectionViewLayout alloc] initWithComponentRegistry:self.componentRegistry
+                                                                                         componentLayoutManager:self.componentLayoutManager];
+            layout.virtualized = self.usesVirtualizedLayout;
+            self.collectionView.collectionViewLayout = layout;
         }
 
         [self saveStatesForVisibleComponents];
         [self configureHeaderComponent];
-        [self configureOverlayComponents];
         [self adjustCollectionViewContentInsetWithProposedTopValue:[self calculateTopContentInset]];
 
         self.viewModelHasChangedSinceLastLayoutUpdate = NO;
@@ -880,10 +940,15 @@ willUpdateSelectionState:(HUBComponentSelectionState)selectionState
                               usingBatchUpdates:self.viewHasAppeared
                                        animated:NO
                                 addHeaderMargin:shouldAddHeaderMargin
-                                     completion:^{
-                                         [self headerAndOverlayComponentViewsWillAppear];
-                                         [self adjustCollectionViewContentInsetWithProposedTopValue:[self calculateTopContentInset]];
-                                         [self.delegate viewControllerDidFinishRendering:self];
+                                     completion:^(BOOL rendered) {
+                                         // A render that was discarded for a newer view model is only completed
+                                         if (rendered) {
+                                             [self headerAndOverlayComponentViewsWillAppear];
+                                             [self adjustCollectionViewContentInsetWithProposedTopValue:[self calculateTopContentInset]];
+                                             [self.delegate viewControllerDidFinishRendering:self];
+                                             [(HUBCollectionViewLayout *)collectionView.collectionViewLayout precomputeForLikelyCollectionViewSizes];
+                                         }
+
                                          completionHandler();
                                      }];
     }];
@@ -976,30 +1041,41 @@ willUpdateSelectionState:(HUBComponentSelectionState)selectionState
                                                                  previousComponentWrapper:self.headerComponentWrapper];
 }
 
-- (void)configureOverlayComponents
+- (void)configureOverlayComponentsForViewModel:(id<HUBViewModel>)viewModel diff:(nullable HUBViewModelDiff *)diff
 {
-    NSMutableArray * const currentOverlayComponentWrappers = [self.overlayComponentWrappers mutableCopy];
+    // The diff was calculated for the view model being rendered, which may be older than the latest loaded one
+    NSArray<id<HUBComponentModel>> * const componentModels = viewModel.overlayComponentModels;
+    NSArray<HUBComponentWrapper *> * const currentOverlayComponentWrappers = [self.overlayComponentWrappers copy];
     [self.overlayComponentWrappers removeAllObjects];
 
-    for (id<HUBComponentModel> const componentModel in self.viewModel.overlayComponentModels) {
+    // The diff can only be used to skip unchanged components if it was calculated from the currently rendered overlays
+    NSUInteger const previousComponentCount = componentModels.count - diff.insertedOverlayComponentIndexes.count + diff.deletedOverlayComponentIndexes.count;
+    BOOL const shouldSkipUnchangedComponents = (diff != nil && previousComponentCount == currentOverlayComponentWrappers.count);
+
+    for (NSUInteger componentIndex = 0; componentIndex < componentModels.count; componentIndex++) {
+        id<HUBComponentModel> const componentModel = componentModels[componentIndex];
         HUBComponentWrapper *componentWrapper = nil;
 
-        if (self.overlayComponentWrappers.count < currentOverlayComponentWrappers.count) {
-            NSUInteger const componentIndex = self.overlayComponentWrappers.count;
+        if (componentIndex < currentOverlayComponentWrappers.count) {
             componentWrapper = currentOverlayComponentWrappers[componentIndex];
-            [currentOverlayComponentWrappers removeObjectAtIndex:componentIndex];
         }
 
-        componentWrapper = [self configureHeaderOrOverlayComponentWrapperWithModel:componentModel
-                                                          previousComponentWrapper:componentWrapper];
+        BOOL const componentIsUnchanged = shouldSkipUnchangedComponents
+                                       && componentWrapper != nil
+                                       && ![diff.reloadedOverlayComponentIndexes containsIndex:componentIndex];
+
+        if (!componentIsUnchanged) {
+            componentWrapper = [self configureHeaderOrOverlayComponentWrapperWithModel:componentModel
+                                                              previousComponentWrapper:componentWrapper];
+        }
 
         [self.overlayComponentWrappers addObject:componentWrapper];
 
         componentWrapper.view.center = [self overlayComponentCenterPoint];
     }
 
-    for (HUBComponentWrapper * const unusedOverlayComponentWrapper in currentOverlayComponentWrappers) {
-        [self removeComponentWrapper:unusedOverlayComponentWrapper];
+    for (NSUInteger componentIndex = componentModels.count; componentIndex < currentOverlayComponentWrappers.count; componentIndex++) {
+        [self removeComponentWrapper:currentOverlayComponentWrappers[componentIndex]];
     }
 }
 
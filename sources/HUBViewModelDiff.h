@@ -32,8 +32,11 @@ NS_ASSUME_NONNULL_BEGIN
  *
  * @param from The view model that is being transitioned from.
  * @param to The view model that is being transitioned to.
+ * @param maximumEditDistance The maximum number of body component insertions and deletions that the diff may
+ *        consist of, with a moved component counting as one of each. If the changes between the two view models
+ *        exceed it, the function stops as early as it can and returns nil. Pass NSUIntegerMax for no limit.
  */
-typedef HUBViewModelDiff *(HUBDiffAlgorithm)(id<HUBViewModel> from, id<HUBViewModel> to);
+typedef HUBViewModelDiff * _Nullable (HUBDiffAlgorithm)(id<HUBViewModel> from, id<HUBViewModel> to, NSUInteger maximumEditDistance);
 
 /** 
  * An implementation of the longest-common-subsequence.
@@ -42,17 +45,27 @@ typedef HUBViewModelDiff *(HUBDiffAlgorithm)(id<HUBViewModel> from, id<HUBViewMo
  * 
  * https://en.wikipedia.org/wiki/Longest_common_subsequence_problem
  */
-extern HUBViewModelDiff *HUBDiffLCSAlgorithm(id<HUBViewModel>, id<HUBViewModel>);
+extern HUBViewModelDiff * _Nullable HUBDiffLCSAlgorithm(id<HUBViewModel>, id<HUBViewModel>, NSUInteger);
 
 /**
- * An implementation of the Eugene Myers diff algorithm. 
- * Given two sequences with n and m elements, the algorithm has a time & space
- * complexity of O((N + M) * D), where D is the minimum number of changes between
- * the two sequences.
+ * An implementation of the Eugene Myers diff algorithm, using its linear space refinement.
+ * Given two sequences with n and m elements, the algorithm has a time complexity of
+ * O((N + M) * D), where D is the minimum number of changes between the two sequences,
+ * and a space complexity of O(N + M).
  *
  * http://www.xmailserver.org/diff2.pdf
  */
-extern HUBViewModelDiff *HUBDiffMyersAlgorithm(id<HUBViewModel>, id<HUBViewModel>);
+extern HUBViewModelDiff * _Nullable HUBDiffMyersAlgorithm(id<HUBViewModel>, id<HUBViewModel>, NSUInteger);
+
+/**
+ * An implementation of Paul Heckel's diff algorithm.
+ * Given two sequences with n and m elements, the algorithm has a time & space
+ * complexity of O(N + M). Unlike the other algorithms, it detects moves directly
+ * rather than reporting them as deletions followed by insertions.
+ *
+ * http://dl.acm.org/citation.cfm?id=359467
+ */
+extern HUBViewModelDiff * _Nullable HUBDiffHeckelAlgorithm(id<HUBViewModel>, id<HUBViewModel>, NSUInteger);
 
 /**
  * The @c HUBViewModelDiff class provides a way to visualise changes between
@@ -70,7 +83,43 @@ extern HUBViewModelDiff *HUBDiffMyersAlgorithm(id<HUBViewModel>, id<HUBViewModel
 /// The index paths of any body components that were modified in the new view model. 
 @property (nonatomic, strong, readonly) NSArray<NSIndexPath *> *reloadedBodyComponentIndexPaths;
 
-/// A convenience property that returns YES if there are any inserts, deletes or reloads in body or header components of this diff.
+/**
+ * The index paths of any body components that changed position in the new view model, mapped from their index path
+ * in the old view model to their index path in the new one.
+ *
+ * Only components that are otherwise unchanged are considered moves. A component that was both moved and modified is
+ * reported as a deletion and an insertion, since a collection view can't move and reload the same item in a single
+ * batch update.
+ */
+@property (nonatomic, strong, readonly) NSDictionary<NSIndexPath *, NSIndexPath *> *movedBodyComponentIndexPaths;
+
+/**
+ * Diffs of the children of any body components that were modified only by changes to their children, keyed by the
+ * index path of the parent component in the old view model.
+ *
+ * Each key is also contained in `reloadedBodyComponentIndexPaths`, so these components may still simply be reloaded,
+ * but a component that is able to update its children in place can apply the child diff instead. Child diffs are
+ * calculated recursively using the same algorithm, so they may in turn contain diffs for nested children.
+ */
+@property (nonatomic, strong, readonly) NSDictionary<NSIndexPath *, HUBViewModelDiff *> *childComponentDiffs;
+
+/// For a diff of a component's children, the model of that component in the new view model. Otherwise nil.
+@property (nonatomic, strong, readonly, nullable) id<HUBComponentModel> parentComponentModel;
+
+/// The indexes of any overlay components that were added in the new view model.
+@property (nonatomic, strong, readonly) NSIndexSet *insertedOverlayComponentIndexes;
+
+/// The indexes of any overlay components that were removed from the new view model.
+@property (nonatomic, strong, readonly) NSIndexSet *deletedOverlayComponentIndexes;
+
+/// The indexes of any overlay components that were modified in the new view model.
+@property (nonatomic, strong, readonly) NSIndexSet *reloadedOverlayComponentIndexes;
+
+/**
+ * A convenience property that returns YES if there are any inserts, deletes, moves or reloads in body or header components of this diff.
+ *
+ * Changes to overlay components are not included, since they don't affect the collection view.
+ */
 @property (nonatomic, readonly) BOOL hasChanges;
 
 /**
@@ -87,6 +136,22 @@ extern HUBViewModelDiff *HUBDiffMyersAlgorithm(id<HUBViewModel>, id<HUBViewModel
                       toViewModel:(id<HUBViewModel>)toViewModel
                         algorithm:(HUBDiffAlgorithm)algorithm;
 
+/**
+ * Initializes a @c HUBViewModelDiff using the two view models, unless they differ too much for the diff to be useful.
+ *
+ * @param fromViewModel The view model that is being transitioned from.
+ * @param toViewModel The view model that is being transitioned to.
+ * @param algorithm The diffing algorithm to use.
+ * @param maximumEditDistance The maximum number of body component insertions and deletions that the diff may consist
+ *        of. See @c HUBDiffAlgorithm for more info.
+ *
+ * @returns An instance of @c HUBViewModelDiff, or nil if the maximum edit distance was exceeded.
+ */
++ (nullable instancetype)diffFromViewModel:(id<HUBViewModel>)fromViewModel
+                               toViewModel:(id<HUBViewModel>)toViewModel
+                                 algorithm:(HUBDiffAlgorithm)algorithm
+                       maximumEditDistance:(NSUInteger)maximumEditDistance;
+
 /**
  * Initializes a @c HUBViewModelDiff using the two view models by finding the longest common subsequence
  * between the two models' body components.
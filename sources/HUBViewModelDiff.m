@@ -22,6 +22,9 @@
 
 #import "HUBViewModelDiff.h"
 #import "HUBComponentModel.h"
+#import "HUBViewModelImplementation.h"
+#import "HUBAutoEquatable.h"
+#import "HUBKeyPath.h"
 
 #import <UIKit/UIKit.h>
 
@@ -37,8 +40,48 @@ static inline NSArray<NSIndexPath *> *HUBIndexSetToIndexPathArray(NSIndexSet *in
     return [indexPaths copy];
 }
 
+/// Wrap an array of component models in a view model, so that they can be diffed as if they were body components
+static inline id<HUBViewModel> HUBDiffViewModelWithComponentModels(NSArray<id<HUBComponentModel>> * _Nullable componentModels) {
+    return [[HUBViewModelImplementation alloc] initWithIdentifier:nil
+                                                   navigationItem:nil
+                                             headerComponentModel:nil
+                                              bodyComponentModels:componentModels ?: @[]
+                                           overlayComponentModels:@[]
+                                                       customData:nil];
+}
+
+static inline BOOL HUBDiffComponentIdentifiersAreEqual(id<HUBComponentModel> fromModel, id<HUBComponentModel> toModel) {
+    NSString * const fromIdentifier = fromModel.identifier;
+    NSString * const toIdentifier = toModel.identifier;
+    return fromIdentifier == toIdentifier || [fromIdentifier isEqualToString:toIdentifier];
+}
+
+/**
+ * Compare two component models, skipping the deep equality check if they are the same instance, or if their cached
+ * hashes already show that they differ
+ */
+static inline BOOL HUBDiffComponentModelsAreEqual(id<HUBComponentModel> fromModel, id<HUBComponentModel> toModel) {
+    if (fromModel == toModel) {
+        return YES;
+    }
+
+    if (fromModel.hash != toModel.hash) {
+        return NO;
+    }
+
+    return [toModel isEqual:fromModel];
+}
+
 @interface  HUBViewModelDiff ()
 
+@property (nonatomic, strong, readwrite) NSArray<NSIndexPath *> *insertedBodyComponentIndexPaths;
+@property (nonatomic, strong, readwrite) NSArray<NSIndexPath *> *deletedBodyComponentIndexPaths;
+@property (nonatomic, strong, readwrite) NSDictionary<NSIndexPath *, NSIndexPath *> *movedBodyComponentIndexPaths;
+@property (nonatomic, strong, readwrite) NSDictionary<NSIndexPath *, HUBViewModelDiff *> *childComponentDiffs;
+@property (nonatomic, strong, readwrite, nullable) id<HUBComponentModel> parentComponentModel;
+@property (nonatomic, strong, readwrite) NSIndexSet *insertedOverlayComponentIndexes;
+@property (nonatomic, strong, readwrite) NSIndexSet *deletedOverlayComponentIndexes;
+@property (nonatomic, strong, readwrite) NSIndexSet *reloadedOverlayComponentIndexes;
 @property (nonatomic, assign) BOOL headerComponentHasChanged;
 
 @end
@@ -48,12 +91,25 @@ static inline NSArray<NSIndexPath *> *HUBIndexSetToIndexPathArray(NSIndexSet *in
 - (instancetype)initWithInserts:(NSIndexSet *)inserts
                         deletes:(NSIndexSet *)deletes
                         reloads:(NSIndexSet *)reloads
+{
+    return [self initWithInserts:inserts deletes:deletes reloads:reloads moves:@{}];
+}
+
+- (instancetype)initWithInserts:(NSIndexSet *)inserts
+                        deletes:(NSIndexSet *)deletes
+                        reloads:(NSIndexSet *)reloads
+                          moves:(NSDictionary<NSIndexPath *, NSIndexPath *> *)moves
 {
     self = [super init];
     if (self) {
         _insertedBodyComponentIndexPaths = HUBIndexSetToIndexPathArray(inserts);
         _deletedBodyComponentIndexPaths = HUBIndexSetToIndexPathArray(deletes);
         _reloadedBodyComponentIndexPaths = HUBIndexSetToIndexPathArray(reloads);
+        _movedBodyComponentIndexPaths = [moves copy];
+        _childComponentDiffs = @{};
+        _insertedOverlayComponentIndexes = [NSIndexSet indexSet];
+        _deletedOverlayComponentIndexes = [NSIndexSet indexSet];
+        _reloadedOverlayComponentIndexes = [NSIndexSet indexSet];
     }
     return self;
 }
@@ -61,10 +117,34 @@ static inline NSArray<NSIndexPath *> *HUBIndexSetToIndexPathArray(NSIndexSet *in
 + (instancetype)diffFromViewModel:(id<HUBViewModel>)fromViewModel
                       toViewModel:(id<HUBViewModel>)toViewModel
                         algorithm:(HUBDiffAlgorithm)algorithm
+{
+    HUBViewModelDiff * const diff = [self diffFromViewModel:fromViewModel
+                                                toViewModel:toViewModel
+                                                  algorithm:algorithm
+                                        maximumEditDistance:NSUIntegerMax];
+    NSAssert(diff != nil, @"Diffing algorithms should always return a diff when the edit distance is unlimited");
+    return diff;
+}
+
++ (nullable instancetype)diffFromViewModel:(id<HUBViewModel>)fromViewModel
+                               toViewModel:(id<HUBViewModel>)toViewModel
+                                 algorithm:(HUBDiffAlgorithm)algorithm
+                       maximumEditDistance:(NSUInteger)maximumEditDistance
 {
     NSParameterAssert(algorithm);
-    HUBViewModelDiff *diff =  algorithm(fromViewModel, toViewModel);
+    HUBViewModelDiff * const diff = [self trimmedDiffFromViewModel:fromViewModel
+                                                       toViewModel:toViewModel
+                                                         algorithm:algorithm
+                                               maximumEditDistance:maximumEditDistance];
+
+    if (diff == nil) {
+        return nil;
+    }
+
+    [diff calculateMovesFromViewModel:fromViewModel toViewModel:toViewModel];
     [diff calculateHeaderChangesFromViewModel:fromViewModel toViewModel:toViewModel];
+    [diff calculateChildChangesFromViewModel:fromViewModel toViewModel:toViewModel algorithm:algorithm];
+    [diff calculateOverlayChangesFromViewModel:fromViewModel toViewModel:toViewModel];
     return diff;
 }
 
@@ -74,14 +154,166 @@ static inline NSArray<NSIndexPath *> *HUBIndexSetToIndexPathArray(NSIndexSet *in
     return [self diffFromViewModel:fromViewModel toViewModel:toViewModel algorithm:HUBDiffMyersAlgorithm];
 }
 
+/**
+ * Trim the common prefix and suffix of the body components before running the diffing algorithm
+ *
+ * Components with equal identifiers at the start and end of both view models are always matched with each other, so
+ * the algorithm only has to run on the components in between. When that range is empty in either view model, which
+ * is the case when a page is appended to a paginated view model, no algorithm has to run at all.
+ *
+ * Component models at the start that are the same instances in both view models are known to be unchanged. When a
+ * page is appended and all previous component models were reused, the diff therefore only consists of insertions,
+ * and is found with one pointer comparison per previous component instead of any equality checks.
+ */
++ (nullable instancetype)trimmedDiffFromViewModel:(id<HUBViewModel>)fromViewModel
+                                      toViewModel:(id<HUBViewModel>)toViewModel
+                                        algorithm:(HUBDiffAlgorithm)algorithm
+                              maximumEditDistance:(NSUInteger)maximumEditDistance
+{
+    NSArray<id<HUBComponentModel>> * const fromModels = fromViewModel.bodyComponentModels;
+    NSArray<id<HUBComponentModel>> * const toModels = toViewModel.bodyComponentModels;
+    NSUInteger const fromCount = fromModels.count;
+    NSUInteger const toCount = toModels.count;
+    NSUInteger const maximumTrimmedCount = MIN(fromCount, toCount);
+
+    NSUInteger identicalPrefixCount = 0;
+    while (identicalPrefixCount < maximumTrimmedCount && fromModels[identicalPrefixCount] == toModels[identicalPrefixCount]) {
+        identicalPrefixCount++;
+    }
+
+    if (identicalPrefixCount == fromCount) {
+        if (toCount - fromCount > maximumEditDistance) {
+            return nil;
+        }
+
+        return [[HUBViewModelDiff alloc] initWithInserts:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(fromCount, toCount - fromCount)]
+                                                 deletes:[NSIndexSet indexSet]
+                                                 reloads:[NSIndexSet indexSet]];
+    }
+
+    NSUInteger prefixCount = identicalPrefixCount;
+    while (prefixCount < maximumTrimmedCount && HUBDiffComponentIdentifiersAreEqual(fromModels[prefixCount], toModels[prefixCount])) {
+        prefixCount++;
+    }
+
+    NSUInteger suffixCount = 0;
+    while (prefixCount + suffixCount < maximumTrimmedCount
+           && HUBDiffComponentIdentifiersAreEqual(fromModels[fromCount - suffixCount - 1], toModels[toCount - suffixCount - 1])) {
+        suffixCount++;
+    }
+
+    if (prefixCount == 0 && suffixCount == 0) {
+        return algorithm(fromViewModel, toViewModel, maximumEditDistance);
+    }
+
+    NSRange const fromRange = NSMakeRange(prefixCount, fromCount - prefixCount - suffixCount);
+    NSRange const toRange = NSMakeRange(prefixCount, toCount - prefixCount - suffixCount);
+    NSMutableIndexSet * const insertions = [NSMutableIndexSet indexSet];
+    NSMutableIndexSet * const deletions = [NSMutableIndexSet indexSet];
+    NSMutableIndexSet * const reloads = [NSMutableIndexSet indexSet];
+    NSMutableDictionary<NSIndexPath *, NSIndexPath *> * const moves = [NSMutableDictionary new];
+
+    if (fromRange.length == 0 || toRange.length == 0) {
+        if (fromRange.length + toRange.length > maximumEditDistance) {
+            return nil;
+        }
+
+        [insertions addIndexesInRange:toRange];
+        [deletions addIndexesInRange:fromRange];
+    } else {
+        id<HUBViewModel> const trimmedFromViewModel = HUBDiffViewModelWithComponentModels([fromModels subarrayWithRange:fromRange]);
+        id<HUBViewModel> const trimmedToViewModel = HUBDiffViewModelWithComponentModels([toModels subarrayWithRange:toRange]);
+        HUBViewModelDiff * const trimmedDiff = algorithm(trimmedFromViewModel, trimmedToViewModel, maximumEditDistance);
+
+        if (trimmedDiff == nil) {
+            return nil;
+        }
+
+        for (NSIndexPath * const indexPath in trimmedDiff.insertedBodyComponentIndexPaths) {
+            [insertions addIndex:(NSUInteger)indexPath.item + toRange.location];
+        }
+
+        for (NSIndexPath * const indexPath in trimmedDiff.deletedBodyComponentIndexPaths) {
+            [deletions addIndex:(NSUInteger)indexPath.item + fromRange.location];
+        }
+
+        for (NSIndexPath * const indexPath in trimmedDiff.reloadedBodyComponentIndexPaths) {
+            [reloads addIndex:(NSUInteger)indexPath.item + fromRange.location];
+        }
+
+        [trimmedDiff.movedBodyComponentIndexPaths enumerateKeysAndObjectsUsingBlock:^(NSIndexPath *fromIndexPath, NSIndexPath *toIndexPath, BOOL *stop) {
+            NSIndexPath * const offsetFromIndexPath = [NSIndexPath indexPathForItem:fromIndexPath.item + (NSInteger)fromRange.location inSection:0];
+            moves[offsetFromIndexPath] = [NSIndexPath indexPathForItem:toIndexPath.item + (NSInteger)toRange.location inSection:0];
+        }];
+    }
+
+    // The trimmed components keep their relative positions, so they only need to be checked for changes
+    for (NSUInteger index = identicalPrefixCount; index < prefixCount; index++) {
+        if (!HUBDiffComponentModelsAreEqual(fromModels[index], toModels[index])) {
+            [reloads addIndex:index];
+        }
+    }
+
+    for (NSUInteger offset = 1; offset <= suffixCount; offset++) {
+        if (!HUBDiffComponentModelsAreEqual(fromModels[fromCount - offset], toModels[toCount - offset])) {
+            [reloads addIndex:fromCount - offset];
+        }
+    }
+
+    return [[HUBViewModelDiff alloc] initWithInserts:insertions deletes:deletions reloads:reloads moves:moves];
+}
+
 - (BOOL)hasChanges
 {
     return self.insertedBodyComponentIndexPaths.count > 0
         || self.deletedBodyComponentIndexPaths.count > 0
         || self.reloadedBodyComponentIndexPaths.count > 0
+        || self.movedBodyComponentIndexPaths.count > 0
         || self.headerComponentHasChanged;
 }
 
+- (void)calculateMovesFromViewModel:(id<HUBViewModel>)fromViewModel toViewModel:(id<HUBViewModel>)toViewModel
+{
+    if (self.insertedBodyComponentIndexPaths.count == 0 || self.deletedBodyComponentIndexPaths.count == 0) {
+        return;
+    }
+
+    NSArray<id<HUBComponentModel>> * const fromModels = fromViewModel.bodyComponentModels;
+    NSArray<id<HUBComponentModel>> * const toModels = toViewModel.bodyComponentModels;
+    NSMutableDictionary<NSString *, NSIndexPath *> * const deletedIndexPathsByIdentifier = [NSMutableDictionary dictionaryWithCapacity:self.deletedBodyComponentIndexPaths.count];
+
+    for (NSIndexPath * const indexPath in self.deletedBodyComponentIndexPaths) {
+        deletedIndexPathsByIdentifier[fromModels[(NSUInteger)indexPath.item].identifier] = indexPath;
+    }
+
+    NSMutableDictionary<NSIndexPath *, NSIndexPath *> * const moves = [NSMutableDictionary new];
+    NSMutableArray<NSIndexPath *> * const insertions = [NSMutableArray arrayWithCapacity:self.insertedBodyComponentIndexPaths.count];
+
+    // A component that was deleted from one position and inserted at another, without any changes, is a move.
+    for (NSIndexPath * const indexPath in self.insertedBodyComponentIndexPaths) {
+        id<HUBComponentModel> const target = toModels[(NSUInteger)indexPath.item];
+        NSIndexPath * const fromIndexPath = deletedIndexPathsByIdentifier[target.identifier];
+
+        if (fromIndexPath != nil && HUBDiffComponentModelsAreEqual(fromModels[(NSUInteger)fromIndexPath.item], target)) {
+            moves[fromIndexPath] = indexPath;
+            deletedIndexPathsByIdentifier[target.identifier] = nil;
+        } else {
+            [insertions addObject:indexPath];
+        }
+    }
+
+    if (moves.count == 0) {
+        return;
+    }
+
+    NSMutableArray<NSIndexPath *> * const deletions = [self.deletedBodyComponentIndexPaths mutableCopy];
+    [deletions removeObjectsInArray:moves.allKeys];
+
+    self.insertedBodyComponentIndexPaths = [insertions copy];
+    self.deletedBodyComponentIndexPaths = [deletions copy];
+    self.movedBodyComponentIndexPaths = [moves copy];
+}
+
 - (void)calculateHeaderChangesFromViewModel:(id<HUBViewModel>)fromViewModel toViewModel:(id<HUBViewModel>)toViewModel
 {
     id<HUBComponentModel> fromHeaderModel = fromViewModel.headerComponentModel;
@@ -96,34 +328,170 @@ static inline NSArray<NSIndexPath *> *HUBIndexSetToIndexPathArray(NSIndexSet *in
     }
 }
 
+- (void)calculateOverlayChangesFromViewModel:(id<HUBViewModel>)fromViewModel toViewModel:(id<HUBViewModel>)toViewModel
+{
+    NSArray<id<HUBComponentModel>> * const fromModels = fromViewModel.overlayComponentModels;
+    NSArray<id<HUBComponentModel>> * const toModels = toViewModel.overlayComponentModels;
+    NSUInteger const commonCount = MIN(fromModels.count, toModels.count);
+
+    // Overlay components are rendered by position, so they are compared by index rather than by identifier
+    NSMutableIndexSet * const reloads = [NSMutableIndexSet new];
+
+    for (NSUInteger index = 0; index < commonCount; index++) {
+        if (!HUBDiffComponentModelsAreEqual(fromModels[index], toModels[index])) {
+            [reloads addIndex:index];
+        }
+    }
+
+    if (toModels.count > commonCount) {
+        self.insertedOverlayComponentIndexes = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(commonCount, toModels.count - commonCount)];
+    }
+
+    if (fromModels.count > commonCount) {
+        self.deletedOverlayComponentIndexes = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(commonCount, fromModels.count - commonCount)];
+    }
+
+    self.reloadedOverlayComponentIndexes = [reloads copy];
+}
+
+- (void)calculateChildChangesFromViewModel:(id<HUBViewModel>)fromViewModel
+                               toViewModel:(id<HUBViewModel>)toViewModel
+                                 algorithm:(HUBDiffAlgorithm)algorithm
+{
+    if (self.reloadedBodyComponentIndexPaths.count == 0) {
+        return;
+    }
+
+    NSArray<id<HUBComponentModel>> * const fromModels = fromViewModel.bodyComponentModels;
+    NSArray<id<HUBComponentModel>> * const toModels = toViewModel.bodyComponentModels;
+    NSMutableDictionary<NSString *, id<HUBComponentModel>> * const toModelsByIdentifier = [NSMutableDictionary dictionaryWithCapacity:toModels.count];
+
+    for (id<HUBComponentModel> const model in toModels) {
+        toModelsByIdentifier[model.identifier] = model;
+    }
+
+    NSSet<NSString *> * const childrenPropertyNames = [NSSet setWithObject:HUBKeyPath((id<HUBComponentModel>)nil, children)];
+    NSMutableDictionary<NSIndexPath *, HUBViewModelDiff *> * const childComponentDiffs = [NSMutableDictionary new];
+
+    for (NSIndexPath * const indexPath in self.reloadedBodyComponentIndexPaths) {
+        id<HUBComponentModel> const fromModel = fromModels[(NSUInteger)indexPath.item];
+        id<HUBComponentModel> const toModel = toModelsByIdentifier[fromModel.identifier];
+
+        if (toModel == nil || (fromModel.children.count == 0 && toModel.children.count == 0)) {
+            continue;
+        }
+
+        // Only models that are able to compare themselves while ignoring their children can be partially updated
+        if (![fromModel isKindOfClass:[HUBAutoEquatable class]]) {
+            continue;
+        }
+
+        if (![(HUBAutoEquatable *)fromModel isEqual:toModel ignoringPropertyNames:childrenPropertyNames]) {
+            continue;
+        }
+
+        HUBViewModelDiff * const childDiff = [HUBViewModelDiff diffFromViewModel:HUBDiffViewModelWithComponentModels(fromModel.children)
+                                                                     toViewModel:HUBDiffViewModelWithComponentModels(toModel.children)
+                                                                       algorithm:algorithm];
+        childDiff.parentComponentModel = toModel;
+        childComponentDiffs[indexPath] = childDiff;
+    }
+
+    self.childComponentDiffs = [childComponentDiffs copy];
+}
+
 - (NSString *)debugDescription
 {
     return [NSString stringWithFormat:@"\t{\n\
         deletions: %@\n\
         insertions: %@\n\
         reloads: %@\n\
+        moves: %@\n\
+        children: %@\n\
         header: %d\n\
-    \t}", self.deletedBodyComponentIndexPaths, self.insertedBodyComponentIndexPaths, self.reloadedBodyComponentIndexPaths, self.headerComponentHasChanged];
+        overlay deletions: %@\n\
+        overlay insertions: %@\n\
+        overlay reloads: %@\n\
+    \t}", self.deletedBodyComponentIndexPaths, self.insertedBodyComponentIndexPaths, self.reloadedBodyComponentIndexPaths, self.movedBodyComponentIndexPaths, self.childComponentDiffs, self.headerComponentHasChanged, self.deletedOverlayComponentIndexes, self.insertedOverlayComponentIndexes, self.reloadedOverlayComponentIndexes];
 }
 
 @end
 
-#pragma mark - Longest common subsequence
+#pragma mark - Identifier interning
 
-static NSArray<NSString *> *HUBDiffComponentIdentifiersFromViewModel(id<HUBViewModel> viewModel) {
-    NSMutableArray *identifiers = [NSMutableArray arrayWithCapacity:viewModel.bodyComponentModels.count];
-    for (id<HUBComponentModel> model in viewModel.bodyComponentModels) {
-        [identifiers addObject:model.identifier];
+static inline NSUInteger HUBDiffInternIdentifier(CFMutableDictionaryRef internedIdentifiers, NSString *identifier, NSUInteger *distinctIdentifierCount) {
+    const void *internedIdentifier = NULL;
+
+    if (CFDictionaryGetValueIfPresent(internedIdentifiers, (__bridge const void *)identifier, &internedIdentifier)) {
+        return (NSUInteger)(uintptr_t)internedIdentifier;
     }
-    return identifiers;
+
+    NSUInteger const newIdentifier = (*distinctIdentifierCount)++;
+    CFDictionarySetValue(internedIdentifiers, (__bridge const void *)identifier, (const void *)(uintptr_t)newIdentifier);
+    return newIdentifier;
 }
 
-HUBViewModelDiff *HUBDiffLCSAlgorithm(id<HUBViewModel> fromViewModel, id<HUBViewModel> toViewModel) {
-    NSArray<NSString *> *firstIdentifiers = HUBDiffComponentIdentifiersFromViewModel(fromViewModel);
-    NSArray<NSString *> *secondIdentifiers = HUBDiffComponentIdentifiersFromViewModel(toViewModel);
+/**
+ * Interning the body component identifiers of two view models into dense integers, so that the diffing algorithms
+ * can compare plain integers in their inner loops rather than sending isEqualToString: to each pair of strings.
+ *
+ * Two components share the same integer if, and only if, their identifiers are equal. The returned buffers are owned
+ * by the caller and must be freed. The return value is the number of distinct identifiers across both view models.
+ */
+static NSUInteger HUBDiffInternComponentIdentifiers(id<HUBViewModel> fromViewModel,
+                                                    id<HUBViewModel> toViewModel,
+                                                    NSUInteger * _Nonnull * _Nonnull fromIdentifiers,
+                                                    NSUInteger * _Nonnull * _Nonnull toIdentifiers) {
+    NSArray<id<HUBComponentModel>> * const fromModels = fromViewModel.bodyComponentModels;
+    NSArray<id<HUBComponentModel>> * const toModels = toViewModel.bodyComponentModels;
+    NSUInteger const fromCount = fromModels.count;
+    NSUInteger const toCount = toModels.count;
+
+    *fromIdentifiers = malloc(sizeof(NSUInteger) * MAX(fromCount, 1u));
+    *toIdentifiers = malloc(sizeof(NSUInteger) * MAX(toCount, 1u));
+    NSCAssert(*fromIdentifiers != NULL && *toIdentifiers != NULL, @"Unable to allocate memory.");
+
+    // Values are stored unboxed, so that interning doesn't allocate an NSNumber per component.
+    CFMutableDictionaryRef const internedIdentifiers = CFDictionaryCreateMutable(kCFAllocatorDefault,
+                                                                                 (CFIndex)(fromCount + toCount),
+                                                                                 &kCFTypeDictionaryKeyCallBacks,
+                                                                                 NULL);
+    NSUInteger distinctIdentifierCount = 0;
+
+    for (NSUInteger i = 0; i < fromCount; i++) {
+        (*fromIdentifiers)[i] = HUBDiffInternIdentifier(internedIdentifiers, fromModels[i].identifier, &distinctIdentifierCount);
+    }
+
+    for (NSUInteger j = 0; j < toCount; j++) {
+        (*toIdentifiers)[j] = HUBDiffInternIdentifier(internedIdentifiers, toModels[j].identifier, &distinctIdentifierCount);
+    }
+
+    CFRelease(internedIdentifiers);
+
+    return distinctIdentifierCount;
+}
+
+/// The lower bound of the edit distance between the body components of two view models
+static inline NSUInteger HUBDiffMinimumEditDistance(id<HUBViewModel> fromViewModel, id<HUBViewModel> toViewModel) {
+    NSUInteger const fromCount = fromViewModel.bodyComponentModels.count;
+    NSUInteger const toCount = toViewModel.bodyComponentModels.count;
+    return fromCount > toCount ? fromCount - toCount : toCount - fromCount;
+}
+
+#pragma mark - Longest common subsequence
+
+HUBViewModelDiff * _Nullable HUBDiffLCSAlgorithm(id<HUBViewModel> fromViewModel, id<HUBViewModel> toViewModel, NSUInteger maximumEditDistance) {
+    // At the very least, the difference in length has to be made up by insertions or deletions
+    if (HUBDiffMinimumEditDistance(fromViewModel, toViewModel) > maximumEditDistance) {
+        return nil;
+    }
+
+    NSUInteger *firstIdentifiers;
+    NSUInteger *secondIdentifiers;
+    HUBDiffInternComponentIdentifiers(fromViewModel, toViewModel, &firstIdentifiers, &secondIdentifiers);
 
-    const NSUInteger fromViewModelCount = firstIdentifiers.count;
-    const NSUInteger toViewModelCount = secondIdentifiers.count;
+    const NSUInteger fromViewModelCount = fromViewModel.bodyComponentModels.count;
+    const NSUInteger toViewModelCount = toViewModel.bodyComponentModels.count;
     const NSUInteger matrixHeight = toViewModelCount + 1;
 
     // The matrix containing all the subproblem results
@@ -135,7 +503,7 @@ HUBViewModelDiff *HUBDiffLCSAlgorithm(id<HUBViewModel> fromViewModel, id<HUBView
         for (NSUInteger j = toViewModelCount; j < NSUIntegerMax; j--) {
             if (i == fromViewModelCount || j == toViewModelCount) {
                 subsequenceMatrix[matrixHeight * i + j] = 0;
-            } else if ([firstIdentifiers[i] isEqualToString:secondIdentifiers[j]]) {
+            } else if (firstIdentifiers[i] == secondIdentifiers[j]) {
                 subsequenceMatrix[matrixHeight * i + j] = 1 + subsequenceMatrix[matrixHeight * (i + 1) + (j + 1)];
             } else {
                 subsequenceMatrix[matrixHeight * i + j] = MAX(subsequenceMatrix[matrixHeight * (i + 1) + j], subsequenceMatrix[matrixHeight * i + (j + 1)]);
@@ -143,17 +511,27 @@ HUBViewModelDiff *HUBDiffLCSAlgorithm(id<HUBViewModel> fromViewModel, id<HUBView
         }
     }
 
+    // Every element that is not part of the longest common subsequence is either inserted or deleted
+    if (fromViewModelCount + toViewModelCount - 2 * subsequenceMatrix[0] > maximumEditDistance) {
+        free(subsequenceMatrix);
+        free(firstIdentifiers);
+        free(secondIdentifiers);
+        return nil;
+    }
+
     NSMutableIndexSet *reloads = [NSMutableIndexSet indexSet];
 
     // Finding the longest common subsequence
     NSMutableIndexSet *commonIndexSet = [NSMutableIndexSet indexSet];
+    NSMutableIndexSet *commonTargetIndexSet = [NSMutableIndexSet indexSet];
     for (NSUInteger i = 0, j = 0 ; i < fromViewModelCount && j < toViewModelCount; ) {
-        if ([firstIdentifiers[i] isEqualToString:secondIdentifiers[j]]) {
-            if (![fromViewModel.bodyComponentModels[i] isEqual:toViewModel.bodyComponentModels[j]]) {
+        if (firstIdentifiers[i] == secondIdentifiers[j]) {
+            if (!HUBDiffComponentModelsAreEqual(fromViewModel.bodyComponentModels[i], toViewModel.bodyComponentModels[j])) {
                 [reloads addIndex:i];
             }
 
             [commonIndexSet addIndex:i];
+            [commonTargetIndexSet addIndex:j];
             i++;
             j++;
         } else if (subsequenceMatrix[matrixHeight * (i + 1) + j] >= subsequenceMatrix[matrixHeight * i + (j + 1)]) {
@@ -164,6 +542,8 @@ HUBViewModelDiff *HUBDiffLCSAlgorithm(id<HUBViewModel> fromViewModel, id<HUBView
     }
     
     free(subsequenceMatrix);
+    free(firstIdentifiers);
+    free(secondIdentifiers);
     
     NSMutableIndexSet *insertions = [NSMutableIndexSet indexSet];
     NSMutableIndexSet *deletions = [NSMutableIndexSet indexSet];
@@ -175,18 +555,10 @@ HUBViewModelDiff *HUBDiffLCSAlgorithm(id<HUBViewModel> fromViewModel, id<HUBView
         }
     }
 
-    NSArray<id<HUBComponentModel>> *commonObjects = [fromViewModel.bodyComponentModels objectsAtIndexes:commonIndexSet];
-
-    /* Comparing second model indices to find reloads (if identifiers match but deep comparison fails) or
-       insertions (if identifiers differ). */
-    for (NSUInteger i = 0, j = 0; i < commonObjects.count || j < toViewModelCount; ) {
-        if (i < commonObjects.count && j < toViewModelCount &&
-            [commonObjects[i].identifier isEqualToString:secondIdentifiers[j]]) {
-            i++;
-            j++;
-        } else {
+    // Comparing the second model indices to the common indices to find insertions
+    for (NSUInteger j = 0; j < toViewModelCount; j++) {
+        if (![commonTargetIndexSet containsIndex:j]) {
             [insertions addIndex:j];
-            j++;
         }
     }
 
@@ -198,270 +570,415 @@ HUBViewModelDiff *HUBDiffLCSAlgorithm(id<HUBViewModel> fromViewModel, id<HUBView
 #pragma mark - Myers algorithm
 
 /**
- * A point representing movement within the acyclic edit graph, with x being the position in the sequence being,
- * transitioned from and y the position in the sequence transitioned to.
- */ 
+ * The state shared by each recursive step of the linear space Myers algorithm. All buffers are plain C arrays that
+ * are allocated once per diff, and the endpoint buffers are reused by every step.
+ */
 typedef struct {
-    NSInteger x;
-    NSInteger y;
-} HUBDiffPoint;
+    const NSUInteger *fromIdentifiers;
+    const NSUInteger *toIdentifiers;
+    NSInteger *toIndexForFromIndex;
+    NSInteger *forwardEndpoints;
+    NSInteger *backwardEndpoints;
+    BOOL exceededMaximumEditDistance;
+} HUBDiffMyersContext;
 
-static inline HUBDiffPoint HUBDiffPointMake(NSInteger x, NSInteger y) {
-    return (HUBDiffPoint){ .x = x, .y = y };
-}
+/**
+ * Matching the elements within [fromStart, fromEnd) of the sequence being transitioned from to the elements within
+ * [toStart, toEnd) of the sequence being transitioned to, recording each match in toIndexForFromIndex.
+ *
+ * The algorithm can be visualized with an acyclic graph where the elements of the first sequence are along the x-axis
+ * and the second sequence along the y-axis. The goal is to find the shortest path from the top left (x0, y0) to the
+ * bottom right (xn, ym). A horizontal movement (x+1) represents a deletion from the first sequence, and a vertical
+ * movement (y+1) represents an insertion from the second sequence. A diagonal movement (x+1, y+1) represents a match
+ * between the two sequences.
+ *
+ * Rather than keeping every explored path around for backtracking, the shortest path is searched for from both
+ * corners of the graph at the same time, until the two searches overlap on the "middle snake". The graph is then
+ * split at that point, and each half is solved recursively. This way, only the furthest reaching endpoints of the
+ * current step need to be stored, giving a space complexity of O(N + M).
+ *
+ * Since the search stops at the first overlap, the number of steps taken bounds the edit distance of the range. If it
+ * grows beyond maximumEditDistance, the search is abandoned and exceededMaximumEditDistance is set. The edit distances
+ * of the two halves add up to the one of the whole range, so only the outermost step needs to check the limit.
+ */
+static void HUBDiffMyersMatchRange(HUBDiffMyersContext *context, NSInteger fromStart, NSInteger fromEnd, NSInteger toStart, NSInteger toEnd, NSInteger maximumEditDistance) {
+    const NSUInteger * const a = context->fromIdentifiers;
+    const NSUInteger * const b = context->toIdentifiers;
 
-typedef NS_ENUM(NSUInteger, HUBDiffStepType) {
-    HUBDiffStepTypeInsert,
-    HUBDiffStepTypeDelete,
-    HUBDiffStepTypeMatchPoint
-};
-
-static inline HUBDiffStepType HUBDiffStepTypeInfer(NSInteger k, NSInteger d, NSInteger previousX, NSInteger nextX) {
-    // k = -d and k = +d are edge cases which can only be reached through vertical and horizontal movement, respectively
-    if (k == -d) {
-        return HUBDiffStepTypeInsert;
-    } else if (k == d) {
-        return HUBDiffStepTypeDelete;
-    } else {
-        // If the next x is greater than the previous, it is a horizontal movement and thus an insertion.
-        if (previousX < nextX) {
-            return HUBDiffStepTypeInsert;
-        } else {
-            return HUBDiffStepTypeDelete;
-        }
+    // Any common prefix or suffix is matched straight away, only leaving the part in between to be searched.
+    while (fromStart < fromEnd && toStart < toEnd && a[fromStart] == b[toStart]) {
+        context->toIndexForFromIndex[fromStart++] = toStart++;
     }
-}
 
-@interface HUBDiffStep : NSObject
+    while (fromStart < fromEnd && toStart < toEnd && a[fromEnd - 1] == b[toEnd - 1]) {
+        context->toIndexForFromIndex[--fromEnd] = --toEnd;
+    }
 
-@property (nonatomic, assign, readonly) HUBDiffPoint from;
-@property (nonatomic, assign, readonly) HUBDiffPoint to;
-@property (nonatomic, assign, readonly) HUBDiffStepType type;
+    NSInteger const fromCount = fromEnd - fromStart;
+    NSInteger const toCount = toEnd - toStart;
 
-@end
+    // When either range is empty, the remaining elements are all insertions or all deletions.
+    if (fromCount == 0 || toCount == 0) {
+        context->exceededMaximumEditDistance = (fromCount + toCount > maximumEditDistance);
+        return;
+    }
 
-@implementation HUBDiffStep
+    if (labs(fromCount - toCount) > maximumEditDistance) {
+        context->exceededMaximumEditDistance = YES;
+        return;
+    }
 
-- (instancetype)initWithFromPoint:(HUBDiffPoint)fromPoint toPoint:(HUBDiffPoint)toPoint
-{
-    self = [super init];
-    if (self) {
-        _from = fromPoint;
-        _to = toPoint;
+    /**
+     * d represents the number of non-diagonal steps taken in each direction, and k represents a diagonal "k-line"
+     * through the graph defined by the equation y = x - k. Only the x-point of the furthest reaching path on each
+     * k-line needs to be stored, since y can be inferred with y = x - k. The backward search stores its endpoints
+     * mirrored, as distances from the bottom right corner.
+     */
+    NSInteger const maxD = (fromCount + toCount + 1) / 2;
+    NSInteger const offset = maxD;
+    NSInteger const endpointCount = 2 * maxD;
+    NSInteger * const forward = context->forwardEndpoints;
+    NSInteger * const backward = context->backwardEndpoints;
+
+    for (NSInteger index = 0; index < endpointCount; index++) {
+        forward[index] = -1;
+        backward[index] = -1;
     }
-    return self;
-}
+    forward[offset + 1] = 0;
+    backward[offset + 1] = 0;
+
+    // When the difference in length is odd, the forward search is the one that will find the overlap.
+    NSInteger const delta = fromCount - toCount;
+    BOOL const forwardSearchFindsOverlap = (delta % 2 != 0);
+
+    // k-lines that have run off the edges of the graph don't need to be explored any further.
+    NSInteger forwardStartTrim = 0;
+    NSInteger forwardEndTrim = 0;
+    NSInteger backwardStartTrim = 0;
+    NSInteger backwardEndTrim = 0;
+
+    for (NSInteger d = 0; d < maxD; d++) {
+        // Any overlap found from this step onwards means an edit distance of at least 2d - 1.
+        if (2 * d - 1 > maximumEditDistance) {
+            context->exceededMaximumEditDistance = YES;
+            return;
+        }
 
-- (HUBDiffStepType)type
-{
-    // Diagonal movement, the two elements match.
-    if (self.from.x + 1 == self.to.x && self.from.y + 1 == self.to.y) {
-        return HUBDiffStepTypeMatchPoint;
-    // Vertical movement, insertion
-    } else if (self.from.y < self.to.y) {
-        return HUBDiffStepTypeInsert;
-    // Horizontal movement, insertion
-    } else {
-        return HUBDiffStepTypeDelete;
+        for (NSInteger k = -d + forwardStartTrim; k <= d - forwardEndTrim; k += 2) {
+            NSInteger const index = offset + k;
+            NSInteger x;
+
+            // Moving from the adjacent k-line that reaches furthest, either vertically (insertion) or horizontally (deletion).
+            if (k == -d || (k != d && forward[index - 1] < forward[index + 1])) {
+                x = forward[index + 1];
+            } else {
+                x = forward[index - 1] + 1;
+            }
+
+            NSInteger y = x - k;
+
+            // Following the diagonal for as long as the elements match.
+            while (x < fromCount && y < toCount && a[fromStart + x] == b[toStart + y]) {
+                x++;
+                y++;
+            }
+
+            forward[index] = x;
+
+            if (x > fromCount) {
+                forwardEndTrim += 2;
+            } else if (y > toCount) {
+                forwardStartTrim += 2;
+            } else if (forwardSearchFindsOverlap) {
+                NSInteger const backwardIndex = offset + delta - k;
+
+                if (backwardIndex >= 0 && backwardIndex < endpointCount && backward[backwardIndex] != -1) {
+                    if (x >= fromCount - backward[backwardIndex]) {
+                        HUBDiffMyersMatchRange(context, fromStart, fromStart + x, toStart, toStart + y, NSIntegerMax);
+                        HUBDiffMyersMatchRange(context, fromStart + x, fromEnd, toStart + y, toEnd, NSIntegerMax);
+                        return;
+                    }
+                }
+            }
+        }
+
+        for (NSInteger k = -d + backwardStartTrim; k <= d - backwardEndTrim; k += 2) {
+            NSInteger const index = offset + k;
+            NSInteger x;
+
+            if (k == -d || (k != d && backward[index - 1] < backward[index + 1])) {
+                x = backward[index + 1];
+            } else {
+                x = backward[index - 1] + 1;
+            }
+
+            NSInteger y = x - k;
+
+            while (x < fromCount && y < toCount && a[fromEnd - x - 1] == b[toEnd - y - 1]) {
+                x++;
+                y++;
+            }
+
+            backward[index] = x;
+
+            if (x > fromCount) {
+                backwardEndTrim += 2;
+            } else if (y > toCount) {
+                backwardStartTrim += 2;
+            } else if (!forwardSearchFindsOverlap) {
+                NSInteger const forwardIndex = offset + delta - k;
+
+                if (forwardIndex >= 0 && forwardIndex < endpointCount && forward[forwardIndex] != -1) {
+                    NSInteger const forwardX = forward[forwardIndex];
+                    NSInteger const forwardY = offset + forwardX - forwardIndex;
+
+                    if (forwardX >= fromCount - x) {
+                        HUBDiffMyersMatchRange(context, fromStart, fromStart + forwardX, toStart, toStart + forwardY, NSIntegerMax);
+                        HUBDiffMyersMatchRange(context, fromStart + forwardX, fromEnd, toStart + forwardY, toEnd, NSIntegerMax);
+                        return;
+                    }
+                }
+            }
+        }
     }
+
+    // Unless the searches overlap, there are no common elements left, and everything is an insertion or deletion.
+    context->exceededMaximumEditDistance = (fromCount + toCount > maximumEditDistance);
 }
 
-@end
+HUBViewModelDiff * _Nullable HUBDiffMyersAlgorithm(id<HUBViewModel> fromViewModel, id<HUBViewModel> toViewModel, NSUInteger maximumEditDistance) {
+    if (HUBDiffMinimumEditDistance(fromViewModel, toViewModel) > maximumEditDistance) {
+        return nil;
+    }
+
+    NSArray<id<HUBComponentModel>> * const fromModels = fromViewModel.bodyComponentModels;
+    NSArray<id<HUBComponentModel>> * const toModels = toViewModel.bodyComponentModels;
+    NSUInteger const fromCount = fromModels.count;
+    NSUInteger const toCount = toModels.count;
+
+    NSUInteger *fromIdentifiers;
+    NSUInteger *toIdentifiers;
+    HUBDiffInternComponentIdentifiers(fromViewModel, toViewModel, &fromIdentifiers, &toIdentifiers);
+
+    HUBDiffMyersContext context = {
+        .fromIdentifiers = fromIdentifiers,
+        .toIdentifiers = toIdentifiers,
+        .toIndexForFromIndex = malloc(sizeof(NSInteger) * MAX(fromCount, 1u)),
+        .forwardEndpoints = malloc(sizeof(NSInteger) * (fromCount + toCount + 2)),
+        .backwardEndpoints = malloc(sizeof(NSInteger) * (fromCount + toCount + 2)),
+        .exceededMaximumEditDistance = NO
+    };
+    BOOL * const isMatchedToIndex = calloc(MAX(toCount, 1u), sizeof(BOOL));
+    NSCAssert(context.toIndexForFromIndex != NULL && context.forwardEndpoints != NULL && context.backwardEndpoints != NULL && isMatchedToIndex != NULL,
+              @"Unable to allocate memory.");
+
+    for (NSUInteger i = 0; i < fromCount; i++) {
+        context.toIndexForFromIndex[i] = NSNotFound;
+    }
 
-// Optimization – when going from an empty sequence, everything is an insertion.
-static NSArray<HUBDiffStep *> *HUBDiffInsertionTracesFromViewModel(id<HUBViewModel> viewModel) {
-    NSInteger toCount = (NSInteger)viewModel.bodyComponentModels.count;
-    NSMutableArray<HUBDiffStep *> *traces = [NSMutableArray arrayWithCapacity:(NSUInteger)toCount];
+    HUBDiffMyersMatchRange(&context, 0, (NSInteger)fromCount, 0, (NSInteger)toCount, (NSInteger)MIN(maximumEditDistance, (NSUInteger)NSIntegerMax));
 
-    for (NSInteger i = 0; i < toCount; i++) {
-        HUBDiffStep *trace = [[HUBDiffStep alloc] initWithFromPoint:HUBDiffPointMake(0, i) toPoint:HUBDiffPointMake(0, i + 1)];
-        [traces addObject:trace];
+    free(context.forwardEndpoints);
+    free(context.backwardEndpoints);
+    free(fromIdentifiers);
+    free(toIdentifiers);
+
+    if (context.exceededMaximumEditDistance) {
+        free(context.toIndexForFromIndex);
+        free(isMatchedToIndex);
+        return nil;
     }
 
-    return traces;
-}
+    NSMutableIndexSet *insertions = [NSMutableIndexSet indexSet];
+    NSMutableIndexSet *deletions = [NSMutableIndexSet indexSet];
+    NSMutableIndexSet *reloads = [NSMutableIndexSet indexSet];
+
+    // Converting the matches to insert|delete|reload indexes
+    for (NSUInteger i = 0; i < fromCount; i++) {
+        NSInteger const j = context.toIndexForFromIndex[i];
+
+        if (j == NSNotFound) {
+            [deletions addIndex:i];
+            continue;
+        }
 
-// Optimization – when going to an empty sequence, everything is a deletion.
-static NSArray<HUBDiffStep *> *HUBDiffDeletionTracesFromViewModel(id<HUBViewModel> viewModel) {
-    NSInteger fromCount = (NSInteger)viewModel.bodyComponentModels.count;
-    NSMutableArray<HUBDiffStep *> *traces = [NSMutableArray arrayWithCapacity:(NSUInteger)fromCount];
+        isMatchedToIndex[j] = YES;
 
-    for (NSInteger i = 0; i < fromCount; i++) {
-        HUBDiffStep *trace = [[HUBDiffStep alloc] initWithFromPoint:HUBDiffPointMake(i, 0) toPoint:HUBDiffPointMake(i + 1, 0)];
-        [traces addObject:trace];
+        // Here we perform the deep equality check to determine if the element has actually changed.
+        if (!HUBDiffComponentModelsAreEqual(fromModels[i], toModels[(NSUInteger)j])) {
+            [reloads addIndex:i];
+        }
     }
-    
-    return traces;
+
+    for (NSUInteger j = 0; j < toCount; j++) {
+        if (!isMatchedToIndex[j]) {
+            [insertions addIndex:j];
+        }
+    }
+
+    free(context.toIndexForFromIndex);
+    free(isMatchedToIndex);
+
+    return [[HUBViewModelDiff alloc] initWithInserts:insertions deletes:deletions reloads:reloads];
 }
 
-// Calculating the different paths between the two sequences.
-static NSArray<HUBDiffStep *> *HUBDiffMyersTracesBetweenViewModels(id<HUBViewModel> fromViewModel, id<HUBViewModel> toViewModel) {
-    NSInteger fromCount = (NSInteger)fromViewModel.bodyComponentModels.count;
-    NSInteger toCount = (NSInteger)toViewModel.bodyComponentModels.count;
-    NSInteger max = fromCount + toCount;
+#pragma mark - Heckel algorithm
+
+HUBViewModelDiff * _Nullable HUBDiffHeckelAlgorithm(id<HUBViewModel> fromViewModel, id<HUBViewModel> toViewModel, NSUInteger maximumEditDistance) {
+    if (HUBDiffMinimumEditDistance(fromViewModel, toViewModel) > maximumEditDistance) {
+        return nil;
+    }
+
+    NSArray<id<HUBComponentModel>> * const fromModels = fromViewModel.bodyComponentModels;
+    NSArray<id<HUBComponentModel>> * const toModels = toViewModel.bodyComponentModels;
+    NSUInteger const fromCount = fromModels.count;
+    NSUInteger const toCount = toModels.count;
+
+    NSUInteger *fromIdentifiers;
+    NSUInteger *toIdentifiers;
+    NSUInteger const identifierCount = HUBDiffInternComponentIdentifiers(fromViewModel, toViewModel, &fromIdentifiers, &toIdentifiers);
 
     /**
-     * The algorithm can be visualized with an acyclic graph where the elements of the first sequence are
-     * along the x-axis and the second sequence along the y-axis. The goal is to find the shortest path
-     * from the top left (x0, y0) to the bottom right (xn, ym). A horizontal movement (x+1) represents
-     * a deletion from the first sequence, and a vertical movement (y+1) represents an insertion from the
-     * second sequence. A diagonal movement  (x+1, y+1) represents a match between the two sequences.
+     * The symbol table maps each interned identifier to the first unmatched index at which it occurs in the old
+     * sequence. Any further occurrences of the same identifier are chained through nextFromIndexes, so that duplicates
+     * are matched in order rather than collapsed.
      */
-    NSMutableArray *steps = [NSMutableArray arrayWithCapacity:(NSUInteger)max];
+    NSInteger * const symbolTable = malloc(sizeof(NSInteger) * MAX(identifierCount, 1u));
+    NSInteger * const nextFromIndexes = malloc(sizeof(NSInteger) * MAX(fromCount, 1u));
+    NSInteger * const fromIndexForToIndex = malloc(sizeof(NSInteger) * MAX(toCount, 1u));
+    NSInteger * const toIndexForFromIndex = malloc(sizeof(NSInteger) * MAX(fromCount, 1u));
+    NSCAssert(symbolTable != NULL && nextFromIndexes != NULL && fromIndexForToIndex != NULL && toIndexForFromIndex != NULL, @"Unable to allocate memory.");
+
+    for (NSUInteger identifier = 0; identifier < identifierCount; identifier++) {
+        symbolTable[identifier] = NSNotFound;
+    }
 
-    NSUInteger endpointCount = 2 * (NSUInteger)max + 1;
-    NSInteger *endpoints = malloc(sizeof(NSInteger) * endpointCount);
-    for (NSUInteger i = 0; i < endpointCount; i++) {
-        endpoints[i] = -1;
+    for (NSUInteger i = fromCount; i > 0; i--) {
+        NSUInteger const identifier = fromIdentifiers[i - 1];
+        nextFromIndexes[i - 1] = symbolTable[identifier];
+        toIndexForFromIndex[i - 1] = NSNotFound;
+        symbolTable[identifier] = (NSInteger)(i - 1);
     }
-    endpoints[max + 1] = 0;
 
-    /**
-     * d represents the number of non-diagonal steps taken. The algorithm is iterative and explores every
-     * path one step at a time (with the exception of diagonal steps).
-     */
-    for (NSInteger d = 0; d <= max; d++) {
-        /**
-         * k represents the diagonal movement within the graph, with a "k-line" being a diagonal line through the graph
-         * defined by the equation y = x - k. k can be bounded between [-d...d] since certain k-lines can only be
-         * reached with a certain number of edits. E.g. the line k = -2 starts at (x0, y2), meaning it must be 
-         * preceded by two vertical movements.
-         */
-        for (NSInteger k = -d; k <= d; k += 2) {
-            /**
-             * The goal here is to find the furthest reaching path for the given k-line. To get to this k-line from an
-             * earlier step, we must move from the adjacent k-lines (either k - 1 or k + 1). These points are retrieved
-             * from earlier iterations in the endpoints array.
-             */
-            NSInteger index = k + max;
-
-            NSInteger previousX = endpoints[index - 1];
-            NSInteger nextX = endpoints[index + 1];
-            HUBDiffStepType type = HUBDiffStepTypeInfer(k, d, previousX, nextX);
-
-            // Once the type of edit is determined, the next step can be taken.
-            HUBDiffStep *step = nil;
-            if (type == HUBDiffStepTypeInsert) {
-                NSInteger x = nextX;
-                step = [[HUBDiffStep alloc] initWithFromPoint:HUBDiffPointMake(x, x - k - 1) toPoint:HUBDiffPointMake(x, x - k)];
-            } else {
-                NSInteger x = previousX + 1;
-                step = [[HUBDiffStep alloc] initWithFromPoint:HUBDiffPointMake(x - 1, x - k) toPoint:HUBDiffPointMake(x, x - k)];
-            }
-            
-            /// Here the goal is to follow the diagonal line with additional steps to find the longest common sequence
-            if (step.to.x <= fromCount && step.to.y <= toCount) {
-                [steps addObject:step];
-
-                NSInteger x = step.to.x;
-                NSInteger y = step.to.y;
-                
-                while (x >= 0 && y >= 0 && x < fromCount && y < toCount) {
-                    id<HUBComponentModel> target = toViewModel.bodyComponentModels[(NSUInteger)y];
-                    id<HUBComponentModel> base = fromViewModel.bodyComponentModels[(NSUInteger)x];
-
-                    /**
-                     * Only the element's identity is compared here, as equality is checked later in order to determine
-                     * the location of updates.
-                     */ 
-                    if ([base.identifier isEqual:target.identifier]) {
-                        // A match is found and another step can be taken diagonally.
-                        x += 1;
-                        y += 1;
-
-                        HUBDiffStep *nextStep = [[HUBDiffStep alloc] initWithFromPoint:HUBDiffPointMake(x - 1, y - 1) toPoint:HUBDiffPointMake(x, y)];
-                        
-                        [steps addObject:nextStep];
-                    } else {
-                        break;
-                    }
-                }
+    // Pairing every element of the new sequence with the first unmatched occurrence of its identifier.
+    NSUInteger matchCount = 0;
+    for (NSUInteger j = 0; j < toCount; j++) {
+        NSUInteger const identifier = toIdentifiers[j];
+        NSInteger const i = symbolTable[identifier];
 
-                // Only the x-point needs to be stored since y can be inferred with y = x - k
-                endpoints[index] = x;
+        fromIndexForToIndex[j] = i;
 
-                // The end of the graph has been reached, and a solution has been found.
-                if (x >= fromCount && y >= toCount) {
-                    free(endpoints);
-                    return steps;
-                }
-            }
+        if (i != NSNotFound) {
+            toIndexForFromIndex[i] = (NSInteger)j;
+            symbolTable[identifier] = nextFromIndexes[i];
+            matchCount++;
         }
     }
 
-    // Unless there is an early return, no solution was found. This should never happen.
-    free(endpoints);
-    return @[];
-}
+    free(symbolTable);
+    free(fromIdentifiers);
+    free(toIdentifiers);
+    free(nextFromIndexes);
 
-/**
- * Filtering out any steps not part of the solution path (or "snake").
- */
-static NSArray<HUBDiffStep *> *HUBDiffFindPathFromSteps(NSArray<HUBDiffStep *> *steps) {
-    if (steps.count == 0) {
-        return steps;
+    // Every unmatched element is an insertion or a deletion, regardless of how many of the matched ones have moved.
+    if (fromCount + toCount - 2 * matchCount > maximumEditDistance) {
+        free(fromIndexForToIndex);
+        free(toIndexForFromIndex);
+        return nil;
     }
 
-    NSMutableArray<HUBDiffStep *> *pathSteps = [NSMutableArray array];
+    NSMutableIndexSet *insertions = [NSMutableIndexSet indexSet];
+    NSMutableIndexSet *deletions = [NSMutableIndexSet indexSet];
+    NSMutableIndexSet *reloads = [NSMutableIndexSet indexSet];
+    NSMutableDictionary<NSIndexPath *, NSIndexPath *> *moves = [NSMutableDictionary new];
 
-    HUBDiffStep *lastStep = steps.lastObject;
-    [pathSteps addObject:lastStep];
+    for (NSUInteger i = 0; i < fromCount; i++) {
+        if (toIndexForFromIndex[i] == NSNotFound) {
+            [deletions addIndex:i];
+        }
+    }
 
-    // Starting with the last step (being the last step of the solution) and tracing the path backwards.
-    if (lastStep.from.x != 0 || lastStep.from.y != 0) {
-        for (HUBDiffStep *step in steps.reverseObjectEnumerator) {
-            if (step.to.x == lastStep.from.x && step.to.y == lastStep.from.y) {
-                [pathSteps insertObject:step atIndex:0];
-                lastStep = step;
+    free(toIndexForFromIndex);
 
-                if (step.from.x == 0 && step.from.y == 0) {
-                    break;
-                }
+    /**
+     * The matched elements that can stay in place are the longest run of them that is in the same order in both
+     * sequences, i.e. the longest increasing subsequence of their old indexes when ordered by their new indexes.
+     * Every other matched element has been moved. Finding the subsequence is O(K log K) for K matched elements.
+     */
+    NSInteger * const tailToIndexes = malloc(sizeof(NSInteger) * MAX(toCount, 1u));
+    NSInteger * const predecessorToIndexes = malloc(sizeof(NSInteger) * MAX(toCount, 1u));
+    BOOL * const isStationary = calloc(MAX(toCount, 1u), sizeof(BOOL));
+    NSCAssert(tailToIndexes != NULL && predecessorToIndexes != NULL && isStationary != NULL, @"Unable to allocate memory.");
+
+    NSUInteger subsequenceLength = 0;
+    for (NSUInteger j = 0; j < toCount; j++) {
+        NSInteger const i = fromIndexForToIndex[j];
+
+        if (i == NSNotFound) {
+            continue;
+        }
+
+        NSUInteger lowerBound = 0;
+        NSUInteger upperBound = subsequenceLength;
+        while (lowerBound < upperBound) {
+            NSUInteger const middle = lowerBound + (upperBound - lowerBound) / 2;
+            if (fromIndexForToIndex[tailToIndexes[middle]] < i) {
+                lowerBound = middle + 1;
+            } else {
+                upperBound = middle;
             }
         }
+
+        predecessorToIndexes[j] = lowerBound > 0 ? tailToIndexes[lowerBound - 1] : NSNotFound;
+        tailToIndexes[lowerBound] = (NSInteger)j;
+
+        if (lowerBound == subsequenceLength) {
+            subsequenceLength++;
+        }
     }
 
-    return pathSteps;
-}
+    for (NSInteger j = subsequenceLength > 0 ? tailToIndexes[subsequenceLength - 1] : NSNotFound; j != NSNotFound; j = predecessorToIndexes[j]) {
+        isStationary[j] = YES;
+    }
 
-static NSArray<HUBDiffStep *> *HUBDiffStepsBetweenViewModels(id<HUBViewModel> fromViewModel, id<HUBViewModel> toViewModel) {
-    if (fromViewModel.bodyComponentModels.count == 0 && toViewModel.bodyComponentModels.count == 0) {
-        return @[];
-    } else if (fromViewModel.bodyComponentModels.count == 0) {
-        return HUBDiffInsertionTracesFromViewModel(toViewModel);
-    } else if (toViewModel.bodyComponentModels.count == 0) {
-        return HUBDiffDeletionTracesFromViewModel(fromViewModel);
-    } else {
-        return HUBDiffMyersTracesBetweenViewModels(fromViewModel, toViewModel);
+    free(tailToIndexes);
+    free(predecessorToIndexes);
+
+    // Each moved element counts as both a deletion and an insertion, just like in the other algorithms.
+    if (fromCount + toCount - 2 * subsequenceLength > maximumEditDistance) {
+        free(isStationary);
+        free(fromIndexForToIndex);
+        return nil;
     }
-}
 
-HUBViewModelDiff *HUBDiffMyersAlgorithm(id<HUBViewModel> fromViewModel, id<HUBViewModel> toViewModel) {
-    NSArray<HUBDiffStep *> *steps = HUBDiffStepsBetweenViewModels(fromViewModel, toViewModel);
-    NSArray<HUBDiffStep *> *path = HUBDiffFindPathFromSteps(steps);
+    for (NSUInteger j = 0; j < toCount; j++) {
+        NSInteger const i = fromIndexForToIndex[j];
 
-    NSMutableIndexSet *insertions = [NSMutableIndexSet indexSet];
-    NSMutableIndexSet *deletions = [NSMutableIndexSet indexSet];
-    NSMutableIndexSet *reloads = [NSMutableIndexSet indexSet];
+        if (i == NSNotFound) {
+            [insertions addIndex:j];
+            continue;
+        }
+
+        // Here we perform the deep equality check to determine if the element has actually changed.
+        BOOL const isEqual = HUBDiffComponentModelsAreEqual(fromModels[(NSUInteger)i], toModels[j]);
 
-    // Converting the edit path to insert|delete|reload indexes
-    for (HUBDiffStep *step in path) {
-        HUBDiffStepType type = step.type;
-        if (type == HUBDiffStepTypeInsert) {
-            [insertions addIndex:(NSUInteger)step.from.y];
-        } else if (type == HUBDiffStepTypeDelete) {
-            [deletions addIndex:(NSUInteger)step.from.x];
-        } else if (type == HUBDiffStepTypeMatchPoint) {
-            // Here we perform the deep equality check to determine if the element has actually changed.
-            id<HUBComponentModel> base = fromViewModel.bodyComponentModels[(NSUInteger)step.from.x];
-            id<HUBComponentModel> target = toViewModel.bodyComponentModels[(NSUInteger)step.from.y];
-            if (![target isEqual:base]) {
-                [reloads addIndex:(NSUInteger)step.from.x];
+        if (isStationary[j]) {
+            if (!isEqual) {
+                [reloads addIndex:(NSUInteger)i];
             }
+        } else if (isEqual) {
+            moves[[NSIndexPath indexPathForItem:i inSection:0]] = [NSIndexPath indexPathForItem:(NSInteger)j inSection:0];
+        } else {
+            // A collection view can't move and reload the same item, so changed elements are replaced instead.
+            [deletions addIndex:(NSUInteger)i];
+            [insertions addIndex:j];
         }
     }
 
-    return [[HUBViewModelDiff alloc] initWithInserts:insertions deletes:deletions reloads:reloads];
+    free(isStationary);
+    free(fromIndexForToIndex);
+
+    return [[HUBViewModelDiff alloc] initWithInserts:insertions deletes:deletions reloads:reloads moves:moves];
 }
 
 NS_ASSUME_NONNULL_END
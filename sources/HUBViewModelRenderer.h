@@ -21,15 +21,96 @@
 
 #import <UIKit/UIKit.h>
 #import "HUBViewModel.h"
+#import "HUBViewModelDiff.h"
 #import "HUBHeaderMacros.h"
 
+@class HUBViewModelRenderer;
+
 NS_ASSUME_NONNULL_BEGIN
 
+/// Enum describing the ways in which a view model can be applied to a collection view
+typedef NS_ENUM(NSUInteger, HUBViewModelRenderMode) {
+    /// The collection view was reloaded, since batch updates weren't used or nothing had been rendered before
+    HUBViewModelRenderModeReload,
+    /// The collection view was updated using batch updates
+    HUBViewModelRenderModeBatchUpdates,
+    /// The collection view was reloaded, since the view model changed too much for batch updates to be worthwhile
+    HUBViewModelRenderModeReloadForExceededDiffBudget
+};
+
+/**
+ *  Block type for completion blocks used when rendering view models
+ *
+ *  @param rendered Whether the view model was rendered. This is `NO` if the render was discarded before being applied
+ *         to the collection view, because a newer view model was rendered in the meantime.
+ */
+typedef void(^HUBViewModelRendererCompletionBlock)(BOOL rendered);
+
+/// Delegate protocol for `HUBViewModelRenderer`
+@protocol HUBViewModelRendererDelegate <NSObject>
+
+/**
+ *  Notify the delegate that a view model is about to be rendered
+ *
+ *  @param renderer The renderer that is about to render a view model
+ *  @param viewModel The view model that is about to be rendered
+ *  @param diff The changes from the previously rendered view model, or nil if no view model was previously rendered
+ *
+ *  This method is called before the collection view is updated, and can be used to update any views that are not
+ *  managed by the renderer, such as overlay components, according to the diff.
+ */
+- (void)viewModelRenderer:(HUBViewModelRenderer *)renderer
+      willRenderViewModel:(id<HUBViewModel>)viewModel
+                     diff:(nullable HUBViewModelDiff *)diff;
+
+/**
+ *  Ask the delegate to apply changes to the children of a rendered component in place
+ *
+ *  @param renderer The renderer that is about to render a new view model
+ *  @param childComponentDiff The changes to the component's children. Its `parentComponentModel` is the new model
+ *         of the component.
+ *  @param indexPath The index path of the component in the currently rendered view model
+ *
+ *  This method is called before any batch updates are performed, for components that were modified only by changes
+ *  to their children. Return `YES` if the changes were applied, in which case the component won't be reloaded, or
+ *  `NO` to have it be reloaded.
+ */
+- (BOOL)viewModelRenderer:(HUBViewModelRenderer *)renderer
+  applyChildComponentDiff:(HUBViewModelDiff *)childComponentDiff
+   toComponentAtIndexPath:(NSIndexPath *)indexPath;
+
+@end
+
 /**
  *  A class used to render view models in a collection view.
  */
 @interface HUBViewModelRenderer : NSObject
 
+/// The renderer's delegate. See `HUBViewModelRendererDelegate` for more info.
+@property (nonatomic, weak, nullable) id<HUBViewModelRendererDelegate> delegate;
+
+/**
+ *  The maximum fraction of body components that may change between two rendered view models to use batch updates
+ *
+ *  The fraction is the number of body component insertions and deletions relative to the total number of body components
+ *  in both view models, so a value of 1 (the default) means that batch updates are always used. When a diff exceeds it,
+ *  its calculation is stopped as early as possible, and the collection view is reloaded instead.
+ */
+@property (nonatomic, assign) CGFloat maximumChangedFraction;
+
+/// The way in which the last view model was applied to the collection view. Can be used for telemetry.
+@property (nonatomic, assign, readonly) HUBViewModelRenderMode lastRenderMode;
+
+/**
+ *  Initialize an instance of this class with the algorithm to use to diff view models
+ *
+ *  @param diffAlgorithm The algorithm to use to calculate the changes between two subsequently rendered view models
+ */
+- (instancetype)initWithDiffAlgorithm:(HUBDiffAlgorithm)diffAlgorithm NS_DESIGNATED_INITIALIZER;
+
+/// Initialize an instance of this class that diffs view models using `HUBDiffMyersAlgorithm`
+- (instancetype)init;
+
 /**
  *  Renders the provided view model in the collection view.
  * 
@@ -39,13 +120,30 @@ NS_ASSUME_NONNULL_BEGIN
  *  @param animated Whether the renderer should render with animations or not.
  *  @param addHeaderMargin Whether margin should be added to account for any header component
  *  @param completionBlock The block to be called once the rendering is completed.
+ *
+ *  When using batch updates, the changes from the previously rendered view model are calculated on a background
+ *  queue, and the collection view is updated once they are available. If another view model is rendered in the
+ *  meantime, those changes are discarded without being applied, and the completion block is called asynchronously on
+ *  the main queue with `rendered` set to `NO`, since it may itself start another render. The same happens if the
+ *  renderer is deallocated before the changes are available. If `discardPendingRender` is called instead, the
+ *  completion block is called synchronously from that method. Rendering the view model that was last rendered again,
+ *  for example after the collection view was resized, is always done synchronously.
  */
 - (void)renderViewModel:(id<HUBViewModel>)viewModel
        inCollectionView:(UICollectionView *)collectionView
       usingBatchUpdates:(BOOL)usingBatchUpdates
                animated:(BOOL)animated
         addHeaderMargin:(BOOL)addHeaderMargin
-             completion:(void(^)(void))completionBlock;
+             completion:(HUBViewModelRendererCompletionBlock)completionBlock;
+
+/**
+ *  Discard any render that is waiting for its changes to be calculated in the background
+ *
+ *  The completion block of the discarded render is called synchronously, before this method returns, with `rendered`
+ *  set to `NO`. Call this when a newer view model is about to be rendered, to avoid waiting for changes that would
+ *  never be applied.
+ */
+- (void)discardPendingRender;
 
 @end
 
@@ -20,21 +20,155 @@
  */
 
 #import "HUBViewModelRenderer.h"
-#import "HUBViewModelDiff.h"
 #import "HUBCollectionViewLayout.h"
+#import "HUBCollectionViewLayoutCalculator.h"
+#import "HUBCollectionViewLayoutSnapshot.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
 @interface HUBViewModelRenderer ()
 
+@property (nonatomic, assign, readonly) HUBDiffAlgorithm *diffAlgorithm;
 @property (nonatomic, strong, nullable) id<HUBViewModel> lastRenderedViewModel;
+@property (nonatomic, strong, readonly) dispatch_queue_t diffQueue;
+@property (nonatomic, assign) NSUInteger latestRenderRequestIdentifier;
+@property (nonatomic, copy, nullable) HUBViewModelRendererCompletionBlock pendingRenderCompletionBlock;
+@property (nonatomic, assign, readwrite) HUBViewModelRenderMode lastRenderMode;
 
 @end
 
 @implementation HUBViewModelRenderer
 
+- (instancetype)initWithDiffAlgorithm:(HUBDiffAlgorithm)diffAlgorithm
+{
+    NSParameterAssert(diffAlgorithm != NULL);
+
+    self = [super init];
+
+    if (self) {
+        _diffAlgorithm = diffAlgorithm;
+        _maximumChangedFraction = 1;
+        _diffQueue = dispatch_queue_create("HUBViewModelRenderer", dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_USER_INITIATED, 0));
+    }
+
+    return self;
+}
+
+- (instancetype)init
+{
+    return [self initWithDiffAlgorithm:HUBDiffMyersAlgorithm];
+}
+
 - (void)renderViewModel:(id<HUBViewModel>)viewModel
        inCollectionView:(UICollectionView *)collectionView
+      usingBatchUpdates:(BOOL)usingBatchUpdates
+               animated:(BOOL)animated
+        addHeaderMargin:(BOOL)addHeaderMargin
+             completion:(HUBViewModelRendererCompletionBlock)completionBlock
+{
+    // A pending render is superseded by this one. It is completed asynchronously, since its completion may render again.
+    HUBViewModelRendererCompletionBlock const discardedCompletionBlock = [self removePendingRender];
+    if (discardedCompletionBlock != nil) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            discardedCompletionBlock(NO);
+        });
+    }
+
+    NSUInteger const renderRequestIdentifier = ++self.latestRenderRequestIdentifier;
+    id<HUBViewModel> const lastRenderedViewModel = self.lastRenderedViewModel;
+
+    // Re-rendering the same view model, for example after a resize, has no changes worth diffing in the background
+    if (!usingBatchUpdates || lastRenderedViewModel == nil || viewModel == lastRenderedViewModel) {
+        HUBViewModelDiff *diff;
+        if (lastRenderedViewModel != nil) {
+            diff = [HUBViewModelDiff diffFromViewModel:lastRenderedViewModel
+                                           toViewModel:viewModel
+                                             algorithm:self.diffAlgorithm
+                                   maximumEditDistance:[self maximumEditDistanceFromViewModel:lastRenderedViewModel toViewModel:viewModel]];
+        }
+
+        [self renderViewModel:viewModel
+                         diff:diff
+               layoutSnapshot:nil
+             inCollectionView:collectionView
+            usingBatchUpdates:usingBatchUpdates
+                     animated:animated
+              addHeaderMargin:addHeaderMargin
+                   completion:^{
+                       completionBlock(YES);
+                   }];
+        return;
+    }
+
+    // View models are immutable, so they can be diffed in the background. Only the batch update needs the main thread.
+    HUBDiffAlgorithm * const diffAlgorithm = self.diffAlgorithm;
+    NSUInteger const maximumEditDistance = [self maximumEditDistanceFromViewModel:lastRenderedViewModel toViewModel:viewModel];
+    __weak __typeof(self) weakSelf = self;
+
+    // If all components support it, the layout is computed in the background too, right after the diff
+    HUBCollectionViewLayout * const layout = (HUBCollectionViewLayout *)collectionView.collectionViewLayout;
+    HUBCollectionViewLayoutCalculator * const layoutCalculator = [layout backgroundCalculatorForCollectionViewSize:collectionView.frame.size
+                                                                                                         viewModel:viewModel
+                                                                                                 previousViewModel:lastRenderedViewModel
+                                                                                                   addHeaderMargin:addHeaderMargin];
+
+    self.pendingRenderCompletionBlock = completionBlock;
+
+    dispatch_async(self.diffQueue, ^{
+        HUBViewModelDiff * const diff = [HUBViewModelDiff diffFromViewModel:lastRenderedViewModel
+                                                                toViewModel:viewModel
+                                                                  algorithm:diffAlgorithm
+                                                        maximumEditDistance:maximumEditDistance];
+
+        HUBCollectionViewLayoutSnapshot *layoutSnapshot;
+        if (layoutCalculator != nil && (diff == nil || diff.hasChanges)) {
+            layoutSnapshot = [layoutCalculator computeSnapshotWithDiff:diff];
+        }
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            __strong __typeof(self) strongSelf = weakSelf;
+
+            if (strongSelf == nil) {
+                completionBlock(NO);
+                return;
+            }
+
+            // If the render was discarded, its completion block has already been called
+            if (strongSelf.latestRenderRequestIdentifier != renderRequestIdentifier) {
+                return;
+            }
+
+            strongSelf.pendingRenderCompletionBlock = nil;
+
+            [strongSelf renderViewModel:viewModel
+                                   diff:diff
+                         layoutSnapshot:layoutSnapshot
+                       inCollectionView:collectionView
+                      usingBatchUpdates:usingBatchUpdates
+                               animated:animated
+                        addHeaderMargin:addHeaderMargin
+                             completion:^{
+                                 completionBlock(YES);
+                             }];
+        });
+    });
+}
+
+- (void)discardPendingRender
+{
+    HUBViewModelRendererCompletionBlock const completionBlock = [self removePendingRender];
+
+    if (completionBlock != nil) {
+        completionBlock(NO);
+    }
+}
+
+#pragma mark - Private utilities
+
+- (void)renderViewModel:(id<HUBViewModel>)viewModel
+                   diff:(nullable HUBViewModelDiff *)diff
+         layoutSnapshot:(nullable HUBCollectionViewLayoutSnapshot *)layoutSnapshot
+       inCollectionView:(UICollectionView *)collectionView
       usingBatchUpdates:(BOOL)usingBatchUpdates
                animated:(BOOL)animated
         addHeaderMargin:(BOOL)addHeaderMargin
@@ -44,6 +178,8 @@ NS_ASSUME_NONNULL_BEGIN
     void (^renderBlock)(void) = ^{
         __strong __typeof(self) strongSelf = weakSelf;
         [strongSelf renderViewModel:viewModel
+                               diff:diff
+                     layoutSnapshot:layoutSnapshot
                    inCollectionView:collectionView
                   usingBatchUpdates:usingBatchUpdates
                     addHeaderMargin:addHeaderMargin
@@ -58,17 +194,26 @@ NS_ASSUME_NONNULL_BEGIN
 }
 
 - (void)renderViewModel:(id<HUBViewModel>)viewModel
+                   diff:(nullable HUBViewModelDiff *)diff
+         layoutSnapshot:(nullable HUBCollectionViewLayoutSnapshot *)layoutSnapshot
        inCollectionView:(UICollectionView *)collectionView
       usingBatchUpdates:(BOOL)usingBatchUpdates
         addHeaderMargin:(BOOL)addHeaderMargin
              completion:(void (^)(void))completionBlock
 {
-    HUBViewModelDiff *diff;
-    if (self.lastRenderedViewModel != nil) {
-        id<HUBViewModel> nonnullViewModel = self.lastRenderedViewModel;
-        diff = [HUBViewModelDiff diffFromViewModel:nonnullViewModel toViewModel:viewModel];
+    [self.delegate viewModelRenderer:self willRenderViewModel:viewModel diff:diff];
+
+    // A diff is only ever missing after a previous render if it exceeded the maximum edit distance
+    if (diff != nil && usingBatchUpdates) {
+        self.lastRenderMode = HUBViewModelRenderModeBatchUpdates;
+    } else if (usingBatchUpdates && self.lastRenderedViewModel != nil) {
+        self.lastRenderMode = HUBViewModelRenderModeReloadForExceededDiffBudget;
+    } else {
+        self.lastRenderMode = HUBViewModelRenderModeReload;
     }
 
+    self.lastRenderedViewModel = viewModel;
+
     BOOL const hasDiffChanges = (diff == nil || diff.hasChanges);
     HUBCollectionViewLayout * const layout = (HUBCollectionViewLayout *)collectionView.collectionViewLayout;
 
@@ -78,16 +223,19 @@ NS_ASSUME_NONNULL_BEGIN
      tried to separate that logic out into 2 block methods: layoutBlock and postLayoutBlock.
      */
     void (^layoutBlock)(void) = ^{
+        // A snapshot computed in the background is only valid if the collection view hasn't been resized since
+        if (layoutSnapshot != nil && CGSizeEqualToSize(layoutSnapshot.collectionViewSize, collectionView.frame.size)) {
+            [layout applySnapshot:layoutSnapshot diff:diff];
+            return;
+        }
+
         [layout computeForCollectionViewSize:collectionView.frame.size
                                    viewModel:viewModel
                                         diff:diff
                              addHeaderMargin:addHeaderMargin];
     };
 
-    __weak __typeof(self) weakSelf = self;
     void (^postLayoutBlock)(void) = ^{
-        __strong __typeof(self) strongSelf = weakSelf;
-        strongSelf.lastRenderedViewModel = viewModel;
         completionBlock();
     };
 
@@ -113,10 +261,16 @@ NS_ASSUME_NONNULL_BEGIN
         postLayoutBlock();
     } else {
         if (hasDiffChanges) {
+            NSArray<NSIndexPath *> * const reloadedIndexPaths = [self reloadedIndexPathsForDiff:diff];
+
             [collectionView performBatchUpdates:^{
                 [collectionView insertItemsAtIndexPaths:diff.insertedBodyComponentIndexPaths];
                 [collectionView deleteItemsAtIndexPaths:diff.deletedBodyComponentIndexPaths];
-                [collectionView reloadItemsAtIndexPaths:diff.reloadedBodyComponentIndexPaths];
+                [collectionView reloadItemsAtIndexPaths:reloadedIndexPaths];
+
+                [diff.movedBodyComponentIndexPaths enumerateKeysAndObjectsUsingBlock:^(NSIndexPath *fromIndexPath, NSIndexPath *toIndexPath, BOOL *stop) {
+                    [collectionView moveItemAtIndexPath:fromIndexPath toIndexPath:toIndexPath];
+                }];
 
                 layoutBlock();
             } completion:^(BOOL finished) {
@@ -129,6 +283,53 @@ NS_ASSUME_NONNULL_BEGIN
     }
 }
 
+- (nullable HUBViewModelRendererCompletionBlock)removePendingRender
+{
+    HUBViewModelRendererCompletionBlock const completionBlock = self.pendingRenderCompletionBlock;
+
+    if (completionBlock == nil) {
+        return nil;
+    }
+
+    // Makes sure that the background result of the pending render is ignored once it arrives
+    self.pendingRenderCompletionBlock = nil;
+    self.latestRenderRequestIdentifier++;
+    return completionBlock;
+}
+
+- (NSUInteger)maximumEditDistanceFromViewModel:(id<HUBViewModel>)fromViewModel toViewModel:(id<HUBViewModel>)toViewModel
+{
+    if (self.maximumChangedFraction >= 1) {
+        return NSUIntegerMax;
+    }
+
+    NSUInteger const componentCount = fromViewModel.bodyComponentModels.count + toViewModel.bodyComponentModels.count;
+    return (NSUInteger)floor(MAX(self.maximumChangedFraction, 0) * componentCount);
+}
+
+- (NSArray<NSIndexPath *> *)reloadedIndexPathsForDiff:(HUBViewModelDiff *)diff
+{
+    id<HUBViewModelRendererDelegate> const delegate = self.delegate;
+
+    if (delegate == nil || diff.childComponentDiffs.count == 0) {
+        return diff.reloadedBodyComponentIndexPaths;
+    }
+
+    NSMutableArray<NSIndexPath *> * const reloadedIndexPaths = [NSMutableArray arrayWithCapacity:diff.reloadedBodyComponentIndexPaths.count];
+
+    for (NSIndexPath * const indexPath in diff.reloadedBodyComponentIndexPaths) {
+        HUBViewModelDiff * const childComponentDiff = diff.childComponentDiffs[indexPath];
+
+        if (childComponentDiff != nil && [delegate viewModelRenderer:self applyChildComponentDiff:childComponentDiff toComponentAtIndexPath:indexPath]) {
+            continue;
+        }
+
+        [reloadedIndexPaths addObject:indexPath];
+    }
+
+    return [reloadedIndexPaths copy];
+}
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -0,0 +1,162 @@
+/*
+ *  Copyright (c) 2016 Spotify AB.
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ */
+
+#import <XCTest/XCTest.h>
+#import <UIKit/UIKit.h>
+
+#import "HUBAutoEquatable.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Auto equatable class with a mix of object and scalar properties
+@interface HUBAutoEquatableTestModel : HUBAutoEquatable
+
+@property (nonatomic, copy, nullable) NSString *title;
+@property (nonatomic, assign) NSInteger count;
+@property (nonatomic, assign, getter=isEnabled) BOOL enabled;
+@property (nonatomic, assign) double ratio;
+@property (nonatomic, assign) CGSize size;
+@property (nonatomic, copy, nullable) NSDictionary<NSString *, id> *customData;
+
+@end
+
+@implementation HUBAutoEquatableTestModel
+
+@end
+
+/// Auto equatable class that is only used by the concurrency test, so that its comparator is created there
+@interface HUBAutoEquatableConcurrencyTestModel : HUBAutoEquatable
+
+@property (nonatomic, copy, nullable) NSString *title;
+@property (nonatomic, assign) NSInteger count;
+
+@end
+
+@implementation HUBAutoEquatableConcurrencyTestModel
+
+@end
+
+@interface HUBAutoEquatableTests : XCTestCase
+
+@end
+
+@implementation HUBAutoEquatableTests
+
+#pragma mark - Tests
+
+- (void)testEqualInstancesAreEqualAndHaveEqualHashes
+{
+    HUBAutoEquatableTestModel * const modelA = [self createModel];
+    HUBAutoEquatableTestModel * const modelB = [self createModel];
+
+    XCTAssertEqualObjects(modelA, modelB);
+    XCTAssertEqual(modelA.hash, modelB.hash);
+}
+
+- (void)testEachPropertyAffectsEquality
+{
+    NSArray<void(^)(HUBAutoEquatableTestModel *)> * const modifications = @[
+        ^(HUBAutoEquatableTestModel *model) { model.title = @"Other title"; },
+        ^(HUBAutoEquatableTestModel *model) { model.count = 7; },
+        ^(HUBAutoEquatableTestModel *model) { model.enabled = NO; },
+        ^(HUBAutoEquatableTestModel *model) { model.ratio = 0.75; },
+        ^(HUBAutoEquatableTestModel *model) { model.size = CGSizeMake(1, 2); },
+        ^(HUBAutoEquatableTestModel *model) { model.customData = @{@"key": @"other value"}; }
+    ];
+
+    for (void(^modification)(HUBAutoEquatableTestModel *) in modifications) {
+        HUBAutoEquatableTestModel * const model = [self createModel];
+        HUBAutoEquatableTestModel * const modifiedModel = [self createModel];
+        modification(modifiedModel);
+
+        XCTAssertNotEqualObjects(model, modifiedModel);
+    }
+}
+
+- (void)testIgnoringPropertyNames
+{
+    HUBAutoEquatableTestModel * const model = [self createModel];
+    HUBAutoEquatableTestModel * const modifiedModel = [self createModel];
+    modifiedModel.title = @"Other title";
+
+    XCTAssertTrue([model isEqual:modifiedModel ignoringPropertyNames:[NSSet setWithObject:@"title"]]);
+    XCTAssertFalse([model isEqual:modifiedModel ignoringPropertyNames:[NSSet setWithObject:@"count"]]);
+}
+
+- (void)testConcurrentFirstUse
+{
+    NSUInteger const iterationCount = 64;
+    NSMutableIndexSet * const equalIterations = [NSMutableIndexSet indexSet];
+
+    dispatch_apply(iterationCount, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t iteration) {
+        HUBAutoEquatableConcurrencyTestModel * const modelA = [HUBAutoEquatableConcurrencyTestModel new];
+        modelA.title = @"Title";
+        modelA.count = (NSInteger)iteration;
+
+        HUBAutoEquatableConcurrencyTestModel * const modelB = [HUBAutoEquatableConcurrencyTestModel new];
+        modelB.title = @"Title";
+        modelB.count = (NSInteger)iteration;
+
+        BOOL const isEqual = [modelA isEqual:modelB];
+
+        @synchronized (equalIterations) {
+            if (isEqual) {
+                [equalIterations addIndex:iteration];
+            }
+        }
+    });
+
+    XCTAssertEqual(equalIterations.count, iterationCount);
+}
+
+#pragma mark - Performance tests
+
+// Measures the per-call cost of looking up the comparator and comparing every property, since the hash can't be used
+- (void)testEqualityIgnoringPropertyNamesPerformance
+{
+    HUBAutoEquatableTestModel * const modelA = [self createModel];
+    HUBAutoEquatableTestModel * const modelB = [self createModel];
+    NSSet<NSString *> * const ignoredPropertyNames = [NSSet set];
+
+    [self measureBlock:^{
+        for (NSUInteger iteration = 0; iteration < 100000; iteration++) {
+            [modelA isEqual:modelB ignoringPropertyNames:ignoredPropertyNames];
+        }
+    }];
+}
+
+#pragma mark - Utilities
+
+- (HUBAutoEquatableTestModel *)createModel
+{
+    HUBAutoEquatableTestModel * const model = [HUBAutoEquatableTestModel new];
+    model.title = @"Title";
+    model.count = 3;
+    model.enabled = YES;
+    model.ratio = 0.5;
+    model.size = CGSizeMake(100, 50);
+    model.customData = @{@"key": @"value"};
+    return model;
+}
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,299 @@
+/*
+ *  Copyright (c) 2016 Spotify AB.
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ */
+
+#import <XCTest/XCTest.h>
+#import <UIKit/UIKit.h>
+
+#import "HUBCollectionViewLayout.h"
+#import "HUBComponentRegistryImplementation.h"
+#import "HUBDefaultComponentLayoutManager.h"
+#import "HUBComponentMock.h"
+#import "HUBComponentFactoryMock.h"
+#import "HUBComponentFallbackHandlerMock.h"
+#import "HUBComponentDefaults+Testing.h"
+#import "HUBJSONSchemaRegistryImplementation.h"
+#import "HUBIdentifier.h"
+#import "HUBComponentModel.h"
+#import "HUBViewModel.h"
+#import "HUBViewModelUtilities.h"
+#import "HUBAllocationCounter.h"
+
+/// The environment variable that enables the benchmark report, which is too slow to run as a part of the regular suite
+static NSString * const HUBCollectionViewLayoutBenchmarkEnvironmentKey = @"HUB_LAYOUT_BENCHMARK";
+
+/// The namespace of the stub components used by the benchmark
+static NSString * const HUBCollectionViewLayoutBenchmarkComponentNamespace = @"benchmark";
+
+/// The kinds of content that synthetic view models are made of
+typedef NS_ENUM(NSUInteger, HUBCollectionViewLayoutBenchmarkScenario) {
+    /// Full width rows, like a track list
+    HUBCollectionViewLayoutBenchmarkScenarioList,
+    /// Compact width components, laid out in a grid
+    HUBCollectionViewLayoutBenchmarkScenarioGrid,
+    /// Small centered components, grouped into centered rows
+    HUBCollectionViewLayoutBenchmarkScenarioCenteredRows,
+    /// Stackable full width components, with a regular component every ten components
+    HUBCollectionViewLayoutBenchmarkScenarioStackables
+};
+
+@interface HUBCollectionViewLayoutBenchmarkTests : XCTestCase
+
+@property (nonatomic) CGSize collectionViewSize;
+@property (nonatomic, strong) HUBComponentRegistryImplementation *componentRegistry;
+@property (nonatomic, strong) HUBDefaultComponentLayoutManager *componentLayoutManager;
+
+@end
+
+@implementation HUBCollectionViewLayoutBenchmarkTests
+
+#pragma mark - XCTestCase
+
+- (void)setUp
+{
+    [super setUp];
+    
+    self.collectionViewSize = CGSizeMake(320, 568);
+    
+    HUBComponentMock * const listComponent = [self componentWithLayoutTraits:@[HUBComponentLayoutTraitFullWidth] preferredViewSize:CGSizeMake(320, 60)];
+    HUBComponentMock * const gridComponent = [self componentWithLayoutTraits:@[HUBComponentLayoutTraitCompactWidth] preferredViewSize:CGSizeMake(90, 120)];
+    HUBComponentMock * const centeredComponent = [self componentWithLayoutTraits:@[HUBComponentLayoutTraitCentered] preferredViewSize:CGSizeMake(50, 50)];
+    HUBComponentMock * const stackableComponent = [self componentWithLayoutTraits:@[HUBComponentLayoutTraitFullWidth, HUBComponentLayoutTraitStackable]
+                                                                preferredViewSize:CGSizeMake(320, 44)];
+    
+    HUBComponentFactoryMock * const componentFactory = [[HUBComponentFactoryMock alloc] initWithComponents:@{
+        @"list": listComponent,
+        @"grid": gridComponent,
+        @"centered": centeredComponent,
+        @"stackable": stackableComponent
+    }];
+    
+    HUBComponentDefaults * const componentDefaults = [HUBComponentDefaults defaultsForTesting];
+    id<HUBComponentFallbackHandler> const componentFallbackHandler = [[HUBComponentFallbackHandlerMock alloc] initWithComponentDefaults:componentDefaults];
+    HUBJSONSchemaRegistryImplementation * const JSONSchemaRegistry = [[HUBJSONSchemaRegistryImplementation alloc] initWithComponentDefaults:componentDefaults
+                                                                                                                          iconImageResolver:nil];
+    
+    self.componentRegistry = [[HUBComponentRegistryImplementation alloc] initWithFallbackHandler:componentFallbackHandler
+                                                                               componentDefaults:componentDefaults
+                                                                                      JSONSchema:JSONSchemaRegistry.defaultSchema
+                                                                               iconImageResolver:nil];
+    
+    [self.componentRegistry registerComponentFactory:componentFactory forNamespace:HUBCollectionViewLayoutBenchmarkComponentNamespace];
+    
+    self.componentLayoutManager = [[HUBDefaultComponentLayoutManager alloc] initWithMargin:10];
+}
+
+#pragma mark - Benchmarks
+
+- (void)testListComputePerformanceWithTenThousandComponents
+{
+    [self runComputePerformanceTestWithScenario:HUBCollectionViewLayoutBenchmarkScenarioList componentCount:10000];
+}
+
+- (void)testGridComputePerformanceWithTenThousandComponents
+{
+    [self runComputePerformanceTestWithScenario:HUBCollectionViewLayoutBenchmarkScenarioGrid componentCount:10000];
+}
+
+- (void)testGridQueryPerformanceWithTenThousandComponents
+{
+    id<HUBViewModel> const viewModel = [self viewModelForScenario:HUBCollectionViewLayoutBenchmarkScenarioGrid componentCount:10000];
+    HUBCollectionViewLayout * const layout = [self computeLayoutForViewModel:viewModel virtualized:NO];
+    NSArray<NSValue *> * const rects = [self queryRectsForLayout:layout];
+    
+    [self measureBlock:^{
+        for (NSValue * const rect in rects) {
+            [layout layoutAttributesForElementsInRect:rect.CGRectValue];
+        }
+    }];
+}
+
+- (void)runComputePerformanceTestWithScenario:(HUBCollectionViewLayoutBenchmarkScenario)scenario componentCount:(NSUInteger)componentCount
+{
+    id<HUBViewModel> const viewModel = [self viewModelForScenario:scenario componentCount:componentCount];
+    
+    [self measureBlock:^{
+        HUBCollectionViewLayout * const layout = [self computeLayoutForViewModel:viewModel virtualized:NO];
+        XCTAssertGreaterThan(layout.collectionViewContentSize.height, 0);
+    }];
+}
+
+/**
+ *  Logs the cost of computing and querying the layout for every combination of scenario and component count
+ *
+ *  For each combination, the time per `computeForCollectionViewSize:` call and per `layoutAttributesForElementsInRect:`
+ *  query is logged, along with the number of heap allocations that each of them makes. The layouts are created before
+ *  being computed, so that only the computations themselves are timed and counted. Layouts are computed with new
+ *  layouts, so that no preferred view sizes are cached, both with and without virtualization. Since the larger sizes take a long time to
+ *  run, the report is only generated when the HUB_LAYOUT_BENCHMARK environment variable is set.
+ */
+- (void)testBenchmarkReport
+{
+    if (NSProcessInfo.processInfo.environment[HUBCollectionViewLayoutBenchmarkEnvironmentKey] == nil) {
+        return;
+    }
+    
+    NSArray<NSString *> * const scenarioNames = @[@"list", @"grid", @"centered rows", @"stackables"];
+    NSArray<NSNumber *> * const componentCounts = @[@10, @100, @1000, @10000, @20000];
+    NSUInteger const iterationCount = 5;
+    
+    for (NSNumber * const componentCount in componentCounts) {
+        for (HUBCollectionViewLayoutBenchmarkScenario scenario = HUBCollectionViewLayoutBenchmarkScenarioList; scenario <= HUBCollectionViewLayoutBenchmarkScenarioStackables; scenario++) {
+            id<HUBViewModel> const viewModel = [self viewModelForScenario:scenario componentCount:componentCount.unsignedIntegerValue];
+            
+            for (NSUInteger virtualized = 0; virtualized <= 1; virtualized++) {
+                BOOL const isVirtualized = (virtualized == 1);
+                CFAbsoluteTime computeTime = 0;
+                HUBCollectionViewLayout *layout;
+                
+                for (NSUInteger iteration = 0; iteration < iterationCount; iteration++) {
+                    @autoreleasepool {
+                        layout = [self layoutWithVirtualization:isVirtualized];
+                        CFAbsoluteTime const startTime = CFAbsoluteTimeGetCurrent();
+                        [layout computeForCollectionViewSize:self.collectionViewSize viewModel:viewModel diff:nil addHeaderMargin:NO];
+                        computeTime += CFAbsoluteTimeGetCurrent() - startTime;
+                    }
+                }
+                
+                NSArray<NSValue *> * const rects = [self queryRectsForLayout:layout];
+                CFAbsoluteTime queryTime = 0;
+                
+                for (NSValue * const rect in rects) {
+                    @autoreleasepool {
+                        CFAbsoluteTime const startTime = CFAbsoluteTimeGetCurrent();
+                        [layout layoutAttributesForElementsInRect:rect.CGRectValue];
+                        queryTime += CFAbsoluteTimeGetCurrent() - startTime;
+                    }
+                }
+                
+                // Counted separately, since counting slows down every allocation
+                NSUInteger computeAllocationCount = 0;
+                NSUInteger queryAllocationCount = 0;
+                
+                @autoreleasepool {
+                    HUBCollectionViewLayout * const countedLayout = [self layoutWithVirtualization:isVirtualized];
+                    
+                    computeAllocationCount = [HUBAllocationCounter countAllocationsInBlock:^{
+                        [countedLayout computeForCollectionViewSize:self.collectionViewSize viewModel:viewModel diff:nil addHeaderMargin:NO];
+                    }];
+                    
+                    queryAllocationCount = [HUBAllocationCounter countAllocationsInBlock:^{
+                        for (NSValue * const rect in rects) {
+                            @autoreleasepool {
+                                [countedLayout layoutAttributesForElementsInRect:rect.CGRectValue];
+                            }
+                        }
+                    }];
+                }
+                
+                NSLog(@"[HUBCollectionViewLayout] %@ components, %@%@: compute took %.3f ms (%@ allocations), query took %.3f ms (%@ allocations)",
+                      componentCount,
+                      scenarioNames[scenario],
+                      isVirtualized ? @", virtualized" : @"",
+                      computeTime / (CFAbsoluteTime)iterationCount * 1000,
+                      @(computeAllocationCount),
+                      queryTime / (CFAbsoluteTime)rects.count * 1000,
+                      @(queryAllocationCount / rects.count));
+            }
+        }
+    }
+}
+
+#pragma mark - Utilities
+
+- (HUBComponentMock *)componentWithLayoutTraits:(NSArray<HUBComponentLayoutTrait> *)layoutTraits preferredViewSize:(CGSize)preferredViewSize
+{
+    HUBComponentMock * const component = [HUBComponentMock new];
+    [component.layoutTraits addObjectsFromArray:layoutTraits];
+    component.preferredViewSize = preferredViewSize;
+    return component;
+}
+
+- (NSString *)componentNameForScenario:(HUBCollectionViewLayoutBenchmarkScenario)scenario componentIndex:(NSUInteger)componentIndex
+{
+    NSString *componentName = @"list";
+    
+    switch (scenario) {
+        case HUBCollectionViewLayoutBenchmarkScenarioList:
+            break;
+        case HUBCollectionViewLayoutBenchmarkScenarioGrid:
+            componentName = @"grid";
+            break;
+        case HUBCollectionViewLayoutBenchmarkScenarioCenteredRows:
+            componentName = @"centered";
+            break;
+        case HUBCollectionViewLayoutBenchmarkScenarioStackables:
+            componentName = (componentIndex % 10 == 0) ? @"list" : @"stackable";
+            break;
+    }
+    
+    return componentName;
+}
+
+- (id<HUBViewModel>)viewModelForScenario:(HUBCollectionViewLayoutBenchmarkScenario)scenario componentCount:(NSUInteger)componentCount
+{
+    NSMutableArray<id<HUBComponentModel>> * const componentModels = [NSMutableArray arrayWithCapacity:componentCount];
+    
+    for (NSUInteger index = 0; index < componentCount; index++) {
+        NSString * const componentName = [self componentNameForScenario:scenario componentIndex:index];
+        HUBIdentifier * const componentIdentifier = [[HUBIdentifier alloc] initWithNamespace:HUBCollectionViewLayoutBenchmarkComponentNamespace
+                                                                                        name:componentName];
+        
+        [componentModels addObject:[HUBViewModelUtilities createComponentModelWithIdentifier:[NSString stringWithFormat:@"component-%@", @(index)]
+                                                                                         type:HUBComponentTypeBody
+                                                                          componentIdentifier:componentIdentifier
+                                                                                   customData:nil]];
+    }
+    
+    return [HUBViewModelUtilities createViewModelWithIdentifier:@"Benchmark" components:componentModels];
+}
+
+- (HUBCollectionViewLayout *)layoutWithVirtualization:(BOOL)virtualized
+{
+    HUBCollectionViewLayout * const layout = [[HUBCollectionViewLayout alloc] initWithComponentRegistry:self.componentRegistry
+                                                                                 componentLayoutManager:self.componentLayoutManager];
+    layout.virtualized = virtualized;
+    return layout;
+}
+
+- (HUBCollectionViewLayout *)computeLayoutForViewModel:(id<HUBViewModel>)viewModel virtualized:(BOOL)virtualized
+{
+    HUBCollectionViewLayout * const layout = [self layoutWithVirtualization:virtualized];
+    [layout computeForCollectionViewSize:self.collectionViewSize viewModel:viewModel diff:nil addHeaderMargin:NO];
+    return layout;
+}
+
+/// Returns viewport sized rects spread evenly across the content of a layout, like the ones queried while scrolling
+- (NSArray<NSValue *> *)queryRectsForLayout:(HUBCollectionViewLayout *)layout
+{
+    NSUInteger const rectCount = 100;
+    CGFloat const scrollableHeight = MAX(layout.collectionViewContentSize.height - self.collectionViewSize.height, 0);
+    NSMutableArray<NSValue *> * const rects = [NSMutableArray arrayWithCapacity:rectCount];
+    
+    for (NSUInteger index = 0; index < rectCount; index++) {
+        CGFloat const offset = scrollableHeight * (CGFloat)index / (CGFloat)(rectCount - 1);
+        CGRect const rect = {.origin = CGPointMake(0, offset), .size = self.collectionViewSize};
+        [rects addObject:[NSValue valueWithCGRect:rect]];
+    }
+    
+    return rects;
+}
+
+@end
@@ -24,9 +24,13 @@
 #import "HUBIdentifier.h"
 #import "HUBComponentRegistryImplementation.h"
 #import "HUBCollectionViewLayout.h"
+#import "HUBCollectionViewLayoutCalculator.h"
+#import "HUBCollectionViewLayoutSnapshot.h"
+#import "HUBCollectionViewLayoutInvalidationContext.h"
 #import "HUBViewModelBuilderImplementation.h"
 #import "HUBViewModelImplementation.h"
 #import "HUBComponentLayoutManagerMock.h"
+#import "HUBDefaultComponentLayoutManager.h"
 #import "HUBComponentMock.h"
 #import "HUBComponentFactoryMock.h"
 #import "HUBComponentModelBuilder.h"
@@ -38,6 +42,54 @@
 #import "HUBCollectionViewMock.h"
 #import "HUBViewModelDiff.h"
 #import "HUBTestUtilities.h"
+#import "HUBComponentWithDynamicSize.h"
+#import "HUBComponentWithThreadSafeSize.h"
+#import "HUBComponentWithContentOffsetDependentLayout.h"
+
+/// Component mock that opts out of having its preferred view sizes cached
+@interface HUBDynamicSizeComponentMock : HUBComponentMock <HUBComponentWithDynamicSize>
+
+@end
+
+@implementation HUBDynamicSizeComponentMock
+
+@end
+
+/// Component mock that declares that its size calculation is thread safe
+@interface HUBThreadSafeSizeComponentMock : HUBComponentMock <HUBComponentWithThreadSafeSize>
+
+@end
+
+@implementation HUBThreadSafeSizeComponentMock
+
+@end
+
+/// Component mock that declares that its layout depends on the content offset
+@interface HUBContentOffsetDependentComponentMock : HUBComponentMock <HUBComponentWithContentOffsetDependentLayout>
+
+@end
+
+@implementation HUBContentOffsetDependentComponentMock
+
+@end
+
+/// Default component layout manager that counts how many vertical margins it has been asked to compute
+@interface HUBVerticalMarginCountingComponentLayoutManager : HUBDefaultComponentLayoutManager
+
+@property (nonatomic) NSUInteger numberOfVerticalMarginRequests;
+
+@end
+
+@implementation HUBVerticalMarginCountingComponentLayoutManager
+
+- (CGFloat)verticalMarginForComponentWithLayoutTraitMask:(HUBComponentLayoutTraitMask)layoutTraitMask
+                       precedingComponentLayoutTraitMask:(HUBComponentLayoutTraitMask)precedingComponentLayoutTraitMask
+{
+    self.numberOfVerticalMarginRequests++;
+    return [super verticalMarginForComponentWithLayoutTraitMask:layoutTraitMask precedingComponentLayoutTraitMask:precedingComponentLayoutTraitMask];
+}
+
+@end
 
 @interface HUBCollectionViewLayoutTests : XCTestCase
 
@@ -428,6 +480,510 @@
     HUBAssertEqualCGFloatValues([layout targetContentOffsetForProposedContentOffset:collectionView.contentOffset].y, expectedOffset);
 }
 
+- (void)testLayoutAttributesForElementsInRect
+{
+    for (NSUInteger i = 0; i < 20; i++) {
+        [self addBodyComponentWithIdentifier:self.compactComponentIdentifier];
+        [self addBodyComponentWithIdentifier:self.centeredComponentIdentifier];
+        [self addBodyComponentWithIdentifier:self.fullWidthComponentIdentifier];
+    }
+    
+    self.componentLayoutManager.verticalComponentMarginsForLayoutTraits[self.compactComponent.layoutTraits] = @(20);
+    
+    HUBCollectionViewLayout * const layout = [self computeLayoutWithHeaderMargin:NO];
+    NSUInteger const componentCount = 60;
+    
+    NSArray<NSValue *> * const rects = @[
+        [NSValue valueWithCGRect:CGRectMake(0, 0, self.collectionViewSize.width, 1)],
+        [NSValue valueWithCGRect:CGRectMake(0, 450, self.collectionViewSize.width, 400)],
+        [NSValue valueWithCGRect:CGRectMake(150, 1000, 10, 1000)],
+        [NSValue valueWithCGRect:CGRectMake(0, layout.collectionViewContentSize.height - 10, self.collectionViewSize.width, 400)],
+        [NSValue valueWithCGRect:CGRectMake(0, layout.collectionViewContentSize.height + 10, self.collectionViewSize.width, 400)]
+    ];
+    
+    for (NSValue * const rectValue in rects) {
+        CGRect const rect = rectValue.CGRectValue;
+        NSMutableSet<NSIndexPath *> * const expectedIndexPaths = [NSMutableSet new];
+        
+        for (NSUInteger index = 0; index < componentCount; index++) {
+            NSIndexPath * const indexPath = [NSIndexPath indexPathForItem:(NSInteger)index inSection:0];
+            
+            if (CGRectIntersectsRect(rect, [layout layoutAttributesForItemAtIndexPath:indexPath].frame)) {
+                [expectedIndexPaths addObject:indexPath];
+            }
+        }
+        
+        NSArray<UICollectionViewLayoutAttributes *> * const layoutAttributes = [layout layoutAttributesForElementsInRect:rect];
+        NSSet<NSIndexPath *> * const actualIndexPaths = [NSSet setWithArray:[layoutAttributes valueForKey:@"indexPath"]];
+        
+        XCTAssertEqual(layoutAttributes.count, expectedIndexPaths.count);
+        XCTAssertEqualObjects(actualIndexPaths, expectedIndexPaths);
+    }
+}
+
+- (void)testLayoutAttributesCreatedLazilyAndReusedUntilRecomputing
+{
+    [self addBodyComponentWithIdentifier:self.fullWidthComponentIdentifier];
+    
+    id<HUBViewModel> const viewModel = [self.viewModelBuilder build];
+    HUBCollectionViewLayout * const layout = [self computeLayoutForViewModel:viewModel];
+    NSIndexPath * const indexPath = [NSIndexPath indexPathForItem:0 inSection:0];
+    
+    UICollectionViewLayoutAttributes * const layoutAttributes = [layout layoutAttributesForItemAtIndexPath:indexPath];
+    XCTAssertEqual([layout layoutAttributesForItemAtIndexPath:indexPath], layoutAttributes);
+    XCTAssertEqual([layout layoutAttributesForElementsInRect:layoutAttributes.frame].firstObject, layoutAttributes);
+    
+    self.fullWidthComponent.preferredViewSize = CGSizeMake(self.collectionViewSize.width, 200);
+    [self.viewModelBuilder allBodyComponentModelBuilders].firstObject.title = @"Changed";
+    [layout computeForCollectionViewSize:self.collectionViewSize viewModel:[self.viewModelBuilder build] diff:nil addHeaderMargin:NO];
+    
+    UICollectionViewLayoutAttributes * const recomputedLayoutAttributes = [layout layoutAttributesForItemAtIndexPath:indexPath];
+    XCTAssertNotEqual(recomputedLayoutAttributes, layoutAttributes);
+    HUBAssertEqualCGFloatValues(CGRectGetHeight(recomputedLayoutAttributes.frame), 200);
+}
+
+- (void)testIncrementalLayoutAfterAppendingComponents
+{
+    [self addMixedBodyComponentsWithCount:30];
+    
+    id<HUBViewModel> const viewModel = [self.viewModelBuilder build];
+    HUBCollectionViewLayout * const layout = [self computeLayoutForViewModel:viewModel];
+    NSUInteger const initialSizeRequestCount = [self numberOfPreferredViewSizeRequests];
+    
+    [self addMixedBodyComponentsWithCount:6];
+    
+    id<HUBViewModel> const newViewModel = [self.viewModelBuilder build];
+    HUBViewModelDiff * const diff = [HUBViewModelDiff diffFromViewModel:viewModel toViewModel:newViewModel];
+    [layout computeForCollectionViewSize:self.collectionViewSize viewModel:newViewModel diff:diff addHeaderMargin:NO];
+    
+    // Only the last row and the appended components should have been measured
+    XCTAssertLessThanOrEqual([self numberOfPreferredViewSizeRequests] - initialSizeRequestCount, 8u);
+    [self assertLayout:layout isEqualToLayoutComputedForViewModel:newViewModel];
+}
+
+- (void)testIncrementalLayoutAfterInsertingComponentInTheMiddle
+{
+    [self addMixedBodyComponentsWithCount:60];
+    
+    id<HUBViewModel> const viewModel = [self.viewModelBuilder build];
+    HUBCollectionViewLayout * const layout = [self computeLayoutForViewModel:viewModel];
+    NSUInteger const initialSizeRequestCount = [self numberOfPreferredViewSizeRequests];
+    
+    [self addBodyComponentWithIdentifier:self.fullWidthComponentIdentifier preferredIndex:20];
+    
+    id<HUBViewModel> const newViewModel = [self.viewModelBuilder build];
+    HUBViewModelDiff * const diff = [HUBViewModelDiff diffFromViewModel:viewModel toViewModel:newViewModel];
+    [layout computeForCollectionViewSize:self.collectionViewSize viewModel:newViewModel diff:diff addHeaderMargin:NO];
+    
+    // The rows after the inserted component should be shifted rather than measured again
+    XCTAssertLessThan([self numberOfPreferredViewSizeRequests] - initialSizeRequestCount, 10u);
+    [self assertLayout:layout isEqualToLayoutComputedForViewModel:newViewModel];
+}
+
+- (void)testIncrementalLayoutAfterRemovingComponents
+{
+    [self addMixedBodyComponentsWithCount:30];
+    
+    id<HUBViewModel> const viewModel = [self.viewModelBuilder build];
+    HUBCollectionViewLayout * const layout = [self computeLayoutForViewModel:viewModel];
+    
+    NSArray<id<HUBComponentModelBuilder>> * const builders = [self.viewModelBuilder allBodyComponentModelBuilders];
+    [self.viewModelBuilder removeBuilderForBodyComponentModelWithIdentifier:builders[0].modelIdentifier];
+    [self.viewModelBuilder removeBuilderForBodyComponentModelWithIdentifier:builders[13].modelIdentifier];
+    
+    id<HUBViewModel> const newViewModel = [self.viewModelBuilder build];
+    HUBViewModelDiff * const diff = [HUBViewModelDiff diffFromViewModel:viewModel toViewModel:newViewModel];
+    [layout computeForCollectionViewSize:self.collectionViewSize viewModel:newViewModel diff:diff addHeaderMargin:NO];
+    
+    [self assertLayout:layout isEqualToLayoutComputedForViewModel:newViewModel];
+}
+
+- (void)testPreferredViewSizesCachedAcrossLayoutComputations
+{
+    [self addMixedBodyComponentsWithCount:12];
+    
+    id<HUBViewModel> const viewModel = [self.viewModelBuilder build];
+    HUBCollectionViewLayout * const layout = [self computeLayoutForViewModel:viewModel];
+    NSUInteger const initialSizeRequestCount = [self numberOfPreferredViewSizeRequests];
+    CGSize const rotatedCollectionViewSize = CGSizeMake(self.collectionViewSize.height, self.collectionViewSize.width);
+    
+    [layout computeForCollectionViewSize:self.collectionViewSize viewModel:viewModel diff:nil addHeaderMargin:NO];
+    XCTAssertEqual([self numberOfPreferredViewSizeRequests], initialSizeRequestCount);
+    
+    [layout computeForCollectionViewSize:rotatedCollectionViewSize viewModel:viewModel diff:nil addHeaderMargin:NO];
+    NSUInteger const rotatedSizeRequestCount = [self numberOfPreferredViewSizeRequests];
+    XCTAssertGreaterThan(rotatedSizeRequestCount, initialSizeRequestCount);
+    
+    // Rotating back should reuse the sizes from the first computation
+    [layout computeForCollectionViewSize:self.collectionViewSize viewModel:viewModel diff:nil addHeaderMargin:NO];
+    XCTAssertEqual([self numberOfPreferredViewSizeRequests], rotatedSizeRequestCount);
+}
+
+- (void)testPreferredViewSizeOfComponentWithDynamicSizeNotCached
+{
+    HUBDynamicSizeComponentMock * const component = [HUBDynamicSizeComponentMock new];
+    component.preferredViewSize = CGSizeMake(100, 100);
+    self.componentFactory.components[@"dynamic"] = component;
+    
+    [self.viewModelBuilder builderForBodyComponentModelWithIdentifier:@"dynamic"].componentName = @"dynamic";
+    
+    id<HUBViewModel> const viewModel = [self.viewModelBuilder build];
+    HUBCollectionViewLayout * const layout = [self computeLayoutForViewModel:viewModel];
+    XCTAssertEqual(component.numberOfPreferredViewSizeRequests, 1u);
+    
+    component.preferredViewSize = CGSizeMake(100, 200);
+    [layout computeForCollectionViewSize:self.collectionViewSize viewModel:viewModel diff:nil addHeaderMargin:NO];
+    
+    XCTAssertEqual(component.numberOfPreferredViewSizeRequests, 2u);
+    HUBAssertEqualCGFloatValues([layout layoutAttributesForItemAtIndexPath:[NSIndexPath indexPathForItem:0 inSection:0]].frame.size.height, 200);
+}
+
+- (void)testPreferredViewSizesRemeasuredAfterContentSizeCategoryChange
+{
+    for (NSUInteger index = 0; index < 5; index++) {
+        [self addBodyComponentWithIdentifier:self.fullWidthComponentIdentifier];
+    }
+    
+    id<HUBViewModel> const viewModel = [self.viewModelBuilder build];
+    HUBCollectionViewLayout * const layout = [self computeLayoutForViewModel:viewModel];
+    NSUInteger const initialSizeRequestCount = self.fullWidthComponent.numberOfPreferredViewSizeRequests;
+    
+    // Simulate the component measuring larger text
+    self.fullWidthComponent.preferredViewSize = CGSizeMake(self.collectionViewSize.width, 120);
+    [[NSNotificationCenter defaultCenter] postNotificationName:UIContentSizeCategoryDidChangeNotification object:nil];
+    
+    // Even though nothing changed in the view model, no rows can be reused from the previous computation
+    HUBViewModelDiff * const diff = [HUBViewModelDiff diffFromViewModel:viewModel toViewModel:viewModel];
+    [layout computeForCollectionViewSize:self.collectionViewSize viewModel:viewModel diff:diff addHeaderMargin:NO];
+    
+    XCTAssertEqual(self.fullWidthComponent.numberOfPreferredViewSizeRequests, initialSizeRequestCount + viewModel.bodyComponentModels.count);
+    HUBAssertEqualCGFloatValues([layout layoutAttributesForItemAtIndexPath:[NSIndexPath indexPathForItem:4 inSection:0]].frame.size.height, 120);
+}
+
+- (void)testLayoutWithLayoutManagerUsingLayoutTraitMasks
+{
+    [self.fullWidthComponent.layoutTraits addObject:@"customTrait"];
+    
+    [self addBodyComponentWithIdentifier:self.compactComponentIdentifier];
+    [self addBodyComponentWithIdentifier:self.compactComponentIdentifier];
+    [self addBodyComponentWithIdentifier:self.fullWidthComponentIdentifier];
+    
+    id<HUBViewModel> const viewModel = [self.viewModelBuilder build];
+    id<HUBComponentLayoutManager> const componentLayoutManager = [[HUBDefaultComponentLayoutManager alloc] initWithMargin:10];
+    HUBCollectionViewLayout * const layout = [[HUBCollectionViewLayout alloc] initWithComponentRegistry:self.componentRegistry
+                                                                                 componentLayoutManager:componentLayoutManager];
+    
+    [layout computeForCollectionViewSize:self.collectionViewSize viewModel:viewModel diff:nil addHeaderMargin:NO];
+    
+    // The full width component has a custom trait, so its margins are computed using the set based methods
+    CGRect const firstFrame = [layout layoutAttributesForItemAtIndexPath:[NSIndexPath indexPathForItem:0 inSection:0]].frame;
+    CGRect const secondFrame = [layout layoutAttributesForItemAtIndexPath:[NSIndexPath indexPathForItem:1 inSection:0]].frame;
+    CGRect const thirdFrame = [layout layoutAttributesForItemAtIndexPath:[NSIndexPath indexPathForItem:2 inSection:0]].frame;
+    
+    XCTAssertTrue(CGRectEqualToRect(firstFrame, CGRectMake(10, 10, 100, 100)));
+    XCTAssertTrue(CGRectEqualToRect(secondFrame, CGRectMake(120, 10, 100, 100)));
+    XCTAssertTrue(CGRectEqualToRect(thirdFrame, CGRectMake(0, 120, self.collectionViewSize.width, 100)));
+}
+
+- (void)testVerticalMarginsComputedOncePerDistinctLayoutTraitMaskPair
+{
+    for (NSUInteger index = 0; index < 40; index++) {
+        [self addBodyComponentWithIdentifier:self.compactComponentIdentifier preferredIndex:index];
+    }
+    
+    id<HUBViewModel> const viewModel = [self.viewModelBuilder build];
+    HUBVerticalMarginCountingComponentLayoutManager * const componentLayoutManager = [[HUBVerticalMarginCountingComponentLayoutManager alloc] initWithMargin:10];
+    HUBCollectionViewLayout * const layout = [[HUBCollectionViewLayout alloc] initWithComponentRegistry:self.componentRegistry
+                                                                                 componentLayoutManager:componentLayoutManager];
+    
+    [layout computeForCollectionViewSize:self.collectionViewSize viewModel:viewModel diff:nil addHeaderMargin:NO];
+    
+    XCTAssertEqual(componentLayoutManager.numberOfVerticalMarginRequests, 1u);
+    
+    // Two compact components fit on each row, and each row is placed below the previous one, including margins
+    for (NSUInteger index = 0; index < viewModel.bodyComponentModels.count; index++) {
+        CGRect const frame = [layout layoutAttributesForItemAtIndexPath:[NSIndexPath indexPathForItem:(NSInteger)index inSection:0]].frame;
+        CGFloat const expectedX = (index % 2 == 0) ? 10 : 120;
+        CGFloat const expectedY = 10 + 110 * (CGFloat)(index / 2);
+        XCTAssertTrue(CGRectEqualToRect(frame, CGRectMake(expectedX, expectedY, 100, 100)), @"Unexpected frame for component at index %@", @(index));
+    }
+}
+
+- (void)testBackgroundCalculatorNotCreatedForComponentsWithoutThreadSafeSize
+{
+    [self addBodyComponentWithIdentifier:self.compactComponentIdentifier];
+    
+    id<HUBViewModel> const viewModel = [self.viewModelBuilder build];
+    HUBCollectionViewLayout * const layout = [[HUBCollectionViewLayout alloc] initWithComponentRegistry:self.componentRegistry
+                                                                                 componentLayoutManager:self.componentLayoutManager];
+    
+    XCTAssertNil([layout backgroundCalculatorForCollectionViewSize:self.collectionViewSize
+                                                         viewModel:viewModel
+                                                 previousViewModel:nil
+                                                   addHeaderMargin:NO]);
+}
+
+- (void)testSnapshotComputedInBackgroundEqualToLayoutComputedOnMainQueue
+{
+    HUBThreadSafeSizeComponentMock * const compactComponent = [HUBThreadSafeSizeComponentMock new];
+    [compactComponent.layoutTraits addObject:HUBComponentLayoutTraitCompactWidth];
+    compactComponent.preferredViewSize = CGSizeMake(100, 100);
+    self.componentFactory.components[@"threadSafeCompact"] = compactComponent;
+    
+    HUBThreadSafeSizeComponentMock * const fullWidthComponent = [HUBThreadSafeSizeComponentMock new];
+    [fullWidthComponent.layoutTraits addObject:HUBComponentLayoutTraitFullWidth];
+    fullWidthComponent.preferredViewSize = CGSizeMake(self.collectionViewSize.width, 100);
+    self.componentFactory.components[@"threadSafeFullWidth"] = fullWidthComponent;
+    
+    for (NSUInteger index = 0; index < 20; index++) {
+        NSString * const componentName = (index % 3 == 0) ? @"threadSafeFullWidth" : @"threadSafeCompact";
+        [self.viewModelBuilder builderForBodyComponentModelWithIdentifier:[NSUUID UUID].UUIDString].componentName = componentName;
+    }
+    
+    id<HUBViewModel> const viewModel = [self.viewModelBuilder build];
+    HUBCollectionViewLayout * const layout = [[HUBCollectionViewLayout alloc] initWithComponentRegistry:self.componentRegistry
+                                                                                 componentLayoutManager:self.componentLayoutManager];
+    
+    HUBCollectionViewLayoutCalculator * const calculator = [layout backgroundCalculatorForCollectionViewSize:self.collectionViewSize
+                                                                                                   viewModel:viewModel
+                                                                                           previousViewModel:nil
+                                                                                             addHeaderMargin:NO];
+    
+    XCTAssertNotNil(calculator);
+    
+    __weak XCTestExpectation * const expectation = [self expectationWithDescription:@"The snapshot should be computed in the background"];
+    
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        HUBCollectionViewLayoutSnapshot * const snapshot = [calculator computeSnapshotWithDiff:nil];
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [layout applySnapshot:snapshot diff:nil];
+            [expectation fulfill];
+        });
+    });
+    
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    
+    [self assertLayout:layout isEqualToLayoutComputedForViewModel:viewModel];
+}
+
+- (void)testVirtualizedLayoutOnlyMeasuresComponentsCloseToVisibleArea
+{
+    for (NSUInteger index = 0; index < 100; index++) {
+        [self addBodyComponentWithIdentifier:self.fullWidthComponentIdentifier preferredIndex:index];
+    }
+    
+    id<HUBViewModel> const viewModel = [self.viewModelBuilder build];
+    HUBCollectionViewLayout * const layout = [[HUBCollectionViewLayout alloc] initWithComponentRegistry:self.componentRegistry
+                                                                                 componentLayoutManager:self.componentLayoutManager];
+    layout.virtualized = YES;
+    
+    [layout computeForCollectionViewSize:self.collectionViewSize viewModel:viewModel diff:nil addHeaderMargin:NO];
+    
+    XCTAssertLessThan(self.fullWidthComponent.numberOfPreferredViewSizeRequests, 100u);
+    
+    // All components have the same size, so the estimates are exact
+    [self assertLayout:layout isEqualToLayoutComputedForViewModel:viewModel];
+}
+
+- (void)testVirtualizedLayoutRefinesEstimatedComponentsWhenScrollingWithoutMovingVisibleContent
+{
+    for (NSUInteger index = 0; index < 100; index++) {
+        [self addBodyComponentWithIdentifier:self.fullWidthComponentIdentifier preferredIndex:index];
+    }
+    
+    id<HUBViewModel> const viewModel = [self.viewModelBuilder build];
+    HUBCollectionViewLayout * const layout = [[HUBCollectionViewLayout alloc] initWithComponentRegistry:self.componentRegistry
+                                                                                 componentLayoutManager:self.componentLayoutManager];
+    layout.virtualized = YES;
+    
+    CGRect const collectionViewFrame = {.origin = CGPointZero, .size = self.collectionViewSize};
+    HUBCollectionViewMock * const collectionView = [[HUBCollectionViewMock alloc] initWithFrame:collectionViewFrame
+                                                                           collectionViewLayout:layout];
+    collectionView.contentOffset = CGPointMake(0, 5000);
+    
+    [layout computeForCollectionViewSize:self.collectionViewSize viewModel:viewModel diff:nil addHeaderMargin:NO];
+    
+    UICollectionViewLayoutAttributes * const anchorLayoutAttributes = [layout layoutAttributesForElementsInRect:collectionView.bounds].firstObject;
+    NSIndexPath * const anchorIndexPath = anchorLayoutAttributes.indexPath;
+    CGRect const previousAnchorFrame = anchorLayoutAttributes.frame;
+    CGFloat const previousContentHeight = layout.collectionViewContentSize.height;
+    NSUInteger const previousSizeRequestCount = self.fullWidthComponent.numberOfPreferredViewSizeRequests;
+    
+    // Components that haven't been measured yet turn out to be taller than estimated
+    self.fullWidthComponent.preferredViewSize = CGSizeMake(self.collectionViewSize.width, 200);
+    
+    CGRect const newBounds = CGRectOffset(collectionView.bounds, 0, -1000);
+    XCTAssertTrue([layout shouldInvalidateLayoutForBoundsChange:newBounds]);
+    
+    HUBCollectionViewLayoutInvalidationContext * const context = (HUBCollectionViewLayoutInvalidationContext *)[layout invalidationContextForBoundsChange:newBounds];
+    XCTAssertTrue(context.invalidatedEstimatedComponents);
+    XCTAssertFalse(context.invalidatedCollectionViewWidth);
+    
+    XCTAssertGreaterThan(self.fullWidthComponent.numberOfPreferredViewSizeRequests, previousSizeRequestCount);
+    XCTAssertGreaterThan(layout.collectionViewContentSize.height, previousContentHeight);
+    HUBAssertEqualCGFloatValues(context.contentSizeAdjustment.height, layout.collectionViewContentSize.height - previousContentHeight);
+    
+    CGRect const anchorFrame = [layout layoutAttributesForItemAtIndexPath:anchorIndexPath].frame;
+    XCTAssertGreaterThan(CGRectGetMinY(anchorFrame), CGRectGetMinY(previousAnchorFrame));
+    HUBAssertEqualCGFloatValues(context.contentOffsetAdjustment.y, CGRectGetMinY(anchorFrame) - CGRectGetMinY(previousAnchorFrame));
+}
+
+- (void)testLayoutOnlyInvalidatedForBoundsChangesThatChangeWidth
+{
+    for (NSUInteger index = 0; index < 20; index++) {
+        [self addBodyComponentWithIdentifier:self.fullWidthComponentIdentifier preferredIndex:index];
+    }
+    
+    id<HUBViewModel> const viewModel = [self.viewModelBuilder build];
+    HUBCollectionViewLayout * const layout = [[HUBCollectionViewLayout alloc] initWithComponentRegistry:self.componentRegistry
+                                                                                 componentLayoutManager:self.componentLayoutManager];
+    
+    CGRect const collectionViewFrame = {.origin = CGPointZero, .size = self.collectionViewSize};
+    HUBCollectionViewMock * const collectionView = [[HUBCollectionViewMock alloc] initWithFrame:collectionViewFrame
+                                                                           collectionViewLayout:layout];
+    
+    [layout computeForCollectionViewSize:self.collectionViewSize viewModel:viewModel diff:nil addHeaderMargin:NO];
+    
+    XCTAssertFalse([layout shouldInvalidateLayoutForBoundsChange:CGRectOffset(collectionView.bounds, 0, 300)]);
+    
+    CGRect const resizedBounds = {.origin = CGPointZero, .size = CGSizeMake(self.collectionViewSize.height, self.collectionViewSize.width)};
+    XCTAssertTrue([layout shouldInvalidateLayoutForBoundsChange:resizedBounds]);
+    
+    HUBCollectionViewLayoutInvalidationContext * const context = (HUBCollectionViewLayoutInvalidationContext *)[layout invalidationContextForBoundsChange:resizedBounds];
+    XCTAssertTrue([context isKindOfClass:[HUBCollectionViewLayoutInvalidationContext class]]);
+    XCTAssertTrue(context.invalidatedCollectionViewWidth);
+    XCTAssertFalse(context.invalidatedEstimatedComponents);
+    
+    layout.invalidatesLayoutOnContentOffsetChange = YES;
+    XCTAssertTrue([layout shouldInvalidateLayoutForBoundsChange:CGRectOffset(collectionView.bounds, 0, 300)]);
+}
+
+- (void)testLayoutInvalidatedForContentOffsetChangesWhileContainingContentOffsetDependentComponent
+{
+    HUBContentOffsetDependentComponentMock * const component = [HUBContentOffsetDependentComponentMock new];
+    component.preferredViewSize = CGSizeMake(self.collectionViewSize.width, 100);
+    self.componentFactory.components[@"offsetDependent"] = component;
+    
+    for (NSUInteger index = 0; index < 20; index++) {
+        [self addBodyComponentWithIdentifier:self.fullWidthComponentIdentifier preferredIndex:index];
+    }
+    
+    id<HUBViewModel> const viewModelWithoutDependentComponent = [self.viewModelBuilder build];
+    [self.viewModelBuilder builderForBodyComponentModelWithIdentifier:@"offsetDependent"].componentName = @"offsetDependent";
+    id<HUBViewModel> const viewModelWithDependentComponent = [self.viewModelBuilder build];
+    
+    HUBCollectionViewLayout * const layout = [[HUBCollectionViewLayout alloc] initWithComponentRegistry:self.componentRegistry
+                                                                                 componentLayoutManager:self.componentLayoutManager];
+    
+    CGRect const collectionViewFrame = {.origin = CGPointZero, .size = self.collectionViewSize};
+    HUBCollectionViewMock * const collectionView = [[HUBCollectionViewMock alloc] initWithFrame:collectionViewFrame
+                                                                           collectionViewLayout:layout];
+    
+    CGRect const scrolledBounds = CGRectOffset(collectionView.bounds, 0, 300);
+    
+    [layout computeForCollectionViewSize:self.collectionViewSize viewModel:viewModelWithDependentComponent diff:nil addHeaderMargin:NO];
+    XCTAssertTrue([layout shouldInvalidateLayoutForBoundsChange:scrolledBounds]);
+    
+    HUBCollectionViewLayoutInvalidationContext * const context = (HUBCollectionViewLayoutInvalidationContext *)[layout invalidationContextForBoundsChange:scrolledBounds];
+    XCTAssertTrue(context.invalidatedContentOffset);
+    XCTAssertFalse(context.invalidatedCollectionViewWidth);
+    
+    [layout computeForCollectionViewSize:self.collectionViewSize viewModel:viewModelWithoutDependentComponent diff:nil addHeaderMargin:NO];
+    XCTAssertFalse([layout shouldInvalidateLayoutForBoundsChange:scrolledBounds]);
+}
+
+- (void)testLayoutPrecomputedForOtherCollectionViewSizeCommittedWhenResizing
+{
+    for (NSUInteger index = 0; index < 20; index++) {
+        [self addBodyComponentWithIdentifier:self.fullWidthComponentIdentifier preferredIndex:index];
+    }
+    
+    id<HUBViewModel> const viewModel = [self.viewModelBuilder build];
+    HUBCollectionViewLayout * const layout = [self computeLayoutForViewModel:viewModel];
+    CGSize const rotatedCollectionViewSize = CGSizeMake(self.collectionViewSize.height, self.collectionViewSize.width);
+    NSUInteger const initialSizeRequestCount = [self numberOfPreferredViewSizeRequests];
+    
+    [layout precomputeForCollectionViewSizes:@[[NSValue valueWithCGSize:rotatedCollectionViewSize]]];
+    
+    // The components don't support background layout, so the layout is precomputed on the main run loop
+    NSPredicate * const predicate = [NSPredicate predicateWithBlock:^BOOL(HUBCollectionViewLayoutTests *testCase, NSDictionary *bindings) {
+        return [testCase numberOfPreferredViewSizeRequests] == initialSizeRequestCount + viewModel.bodyComponentModels.count;
+    }];
+    
+    [self expectationForPredicate:predicate evaluatedWithObject:self handler:nil];
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+    
+    [layout computeForCollectionViewSize:rotatedCollectionViewSize viewModel:viewModel diff:nil addHeaderMargin:NO];
+    XCTAssertEqual([self numberOfPreferredViewSizeRequests], initialSizeRequestCount + viewModel.bodyComponentModels.count);
+    HUBAssertEqualCGFloatValues(layout.collectionViewContentSize.width, rotatedCollectionViewSize.width);
+    
+    // The layout for the original size is kept, so resizing back doesn't compute anything either
+    [layout computeForCollectionViewSize:self.collectionViewSize viewModel:viewModel diff:nil addHeaderMargin:NO];
+    HUBAssertEqualCGFloatValues(layout.collectionViewContentSize.width, self.collectionViewSize.width);
+    [self assertLayout:layout isEqualToLayoutComputedForViewModel:viewModel];
+}
+
+- (void)testLayoutPrecomputedForWidthCommittedWhenResizingToOtherHeight
+{
+    for (NSUInteger index = 0; index < 20; index++) {
+        [self addBodyComponentWithIdentifier:self.fullWidthComponentIdentifier preferredIndex:index];
+    }
+    
+    id<HUBViewModel> const viewModel = [self.viewModelBuilder build];
+    HUBCollectionViewLayout * const layout = [self computeLayoutForViewModel:viewModel];
+    CGSize const rotatedCollectionViewSize = CGSizeMake(self.collectionViewSize.height, self.collectionViewSize.width);
+    NSUInteger const initialSizeRequestCount = [self numberOfPreferredViewSizeRequests];
+    
+    // Sizes with the same width share a single precomputed layout
+    [layout precomputeForCollectionViewSizes:@[
+        [NSValue valueWithCGSize:rotatedCollectionViewSize],
+        [NSValue valueWithCGSize:CGSizeMake(rotatedCollectionViewSize.width, rotatedCollectionViewSize.height - 50)]
+    ]];
+    
+    NSPredicate * const predicate = [NSPredicate predicateWithBlock:^BOOL(HUBCollectionViewLayoutTests *testCase, NSDictionary *bindings) {
+        return [testCase numberOfPreferredViewSizeRequests] == initialSizeRequestCount + viewModel.bodyComponentModels.count;
+    }];
+    
+    [self expectationForPredicate:predicate evaluatedWithObject:self handler:nil];
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+    
+    // A view controller that isn't full screen is resized to a different height than the precomputed one
+    CGSize const resizedCollectionViewSize = CGSizeMake(rotatedCollectionViewSize.width, rotatedCollectionViewSize.height - 100);
+    [layout computeForCollectionViewSize:resizedCollectionViewSize viewModel:viewModel diff:nil addHeaderMargin:NO];
+    XCTAssertEqual([self numberOfPreferredViewSizeRequests], initialSizeRequestCount + viewModel.bodyComponentModels.count);
+    HUBAssertEqualCGFloatValues(layout.collectionViewContentSize.width, resizedCollectionViewSize.width);
+}
+
+- (void)testCancelledPrecomputationNotPerformed
+{
+    for (NSUInteger index = 0; index < 20; index++) {
+        [self addBodyComponentWithIdentifier:self.fullWidthComponentIdentifier preferredIndex:index];
+    }
+    
+    id<HUBViewModel> const viewModel = [self.viewModelBuilder build];
+    HUBCollectionViewLayout * const layout = [self computeLayoutForViewModel:viewModel];
+    CGSize const rotatedCollectionViewSize = CGSizeMake(self.collectionViewSize.height, self.collectionViewSize.width);
+    NSUInteger const initialSizeRequestCount = [self numberOfPreferredViewSizeRequests];
+    
+    [layout precomputeForCollectionViewSizes:@[[NSValue valueWithCGSize:rotatedCollectionViewSize]]];
+    [layout cancelPendingPrecomputations];
+    
+    // Let the run loop become idle a few times
+    XCTestExpectation * const expectation = [self expectationWithDescription:@"Run loop spun"];
+    
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.2 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        [expectation fulfill];
+    });
+    
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+    
+    XCTAssertEqual([self numberOfPreferredViewSizeRequests], initialSizeRequestCount);
+    
+    [layout computeForCollectionViewSize:rotatedCollectionViewSize viewModel:viewModel diff:nil addHeaderMargin:NO];
+    XCTAssertEqual([self numberOfPreferredViewSizeRequests], initialSizeRequestCount + viewModel.bodyComponentModels.count);
+}
+
 #pragma mark - Utilities
 
 - (void)addBodyComponentWithIdentifier:(HUBIdentifier *)componentIdentifier preferredIndex:(NSUInteger)preferredIndex
@@ -456,6 +1012,55 @@
     }
 }
 
+- (void)addMixedBodyComponentsWithCount:(NSUInteger)count
+{
+    NSArray<HUBIdentifier *> * const componentIdentifiers = @[
+        self.compactComponentIdentifier,
+        self.centeredComponentIdentifier,
+        self.fullWidthComponentIdentifier,
+        self.compactComponentIdentifier
+    ];
+    
+    for (NSUInteger index = 0; index < count; index++) {
+        [self addBodyComponentWithIdentifier:componentIdentifiers[index % componentIdentifiers.count]];
+    }
+}
+
+- (NSUInteger)numberOfPreferredViewSizeRequests
+{
+    return self.compactComponent.numberOfPreferredViewSizeRequests
+        + self.centeredComponent.numberOfPreferredViewSizeRequests
+        + self.fullWidthComponent.numberOfPreferredViewSizeRequests;
+}
+
+- (HUBCollectionViewLayout *)computeLayoutForViewModel:(id<HUBViewModel>)viewModel
+{
+    HUBCollectionViewLayout * const layout = [[HUBCollectionViewLayout alloc] initWithComponentRegistry:self.componentRegistry
+                                                                                 componentLayoutManager:self.componentLayoutManager];
+    
+    [layout computeForCollectionViewSize:self.collectionViewSize viewModel:viewModel diff:nil addHeaderMargin:NO];
+    
+    return layout;
+}
+
+- (void)assertLayout:(HUBCollectionViewLayout *)layout isEqualToLayoutComputedForViewModel:(id<HUBViewModel>)viewModel
+{
+    HUBCollectionViewLayout * const expectedLayout = [self computeLayoutForViewModel:viewModel];
+    
+    XCTAssertTrue(CGSizeEqualToSize(layout.collectionViewContentSize, expectedLayout.collectionViewContentSize));
+    
+    for (NSUInteger index = 0; index < viewModel.bodyComponentModels.count; index++) {
+        NSIndexPath * const indexPath = [NSIndexPath indexPathForItem:(NSInteger)index inSection:0];
+        CGRect const frame = [layout layoutAttributesForItemAtIndexPath:indexPath].frame;
+        CGRect const expectedFrame = [expectedLayout layoutAttributesForItemAtIndexPath:indexPath].frame;
+        
+        XCTAssertTrue(CGRectEqualToRect(frame, expectedFrame), @"Unexpected frame for component at index %@", @(index));
+    }
+    
+    CGRect const contentRect = CGRectMake(0, 0, self.collectionViewSize.width, expectedLayout.collectionViewContentSize.height);
+    XCTAssertEqual([layout layoutAttributesForElementsInRect:contentRect].count, viewModel.bodyComponentModels.count);
+}
+
 - (HUBCollectionViewLayout *)computeLayoutWithHeaderMargin:(BOOL)addHeaderMargin
 {
     id<HUBViewModel> const viewModel = [self.viewModelBuilder build];
@@ -610,6 +610,59 @@
     XCTAssertEqualObjects(copiedCustomImageDataBuilder.placeholderIconIdentifier, @"customPlaceholder");
 }
 
+- (void)testUnmodifiedBuilderReusesPreviouslyBuiltModel
+{
+    self.builder.title = @"title";
+    [self.builder builderForChildWithIdentifier:@"child"].title = @"child";
+    
+    id<HUBComponentModel> const model = [self.builder buildForIndex:0 parent:nil];
+    
+    XCTAssertTrue([self.builder buildForIndex:0 parent:nil] == model);
+    XCTAssertFalse([self.builder buildForIndex:1 parent:nil] == model);
+}
+
+- (void)testModifiedBuilderBuildsNewModel
+{
+    self.builder.title = @"title";
+    id<HUBComponentModel> const model = [self.builder buildForIndex:0 parent:nil];
+    
+    self.builder.title = @"new title";
+    id<HUBComponentModel> const newModel = [self.builder buildForIndex:0 parent:nil];
+    
+    XCTAssertFalse(newModel == model);
+    XCTAssertEqualObjects(newModel.title, @"new title");
+}
+
+- (void)testModifiedChildBuilderCausesParentToBuildNewModel
+{
+    id<HUBComponentModelBuilder> const childBuilder = [self.builder builderForChildWithIdentifier:@"child"];
+    childBuilder.title = @"child";
+    
+    id<HUBComponentModel> const model = [self.builder buildForIndex:0 parent:nil];
+    
+    childBuilder.title = @"new child";
+    id<HUBComponentModel> const newModel = [self.builder buildForIndex:0 parent:nil];
+    
+    XCTAssertFalse(newModel == model);
+    XCTAssertEqualObjects(newModel.children.firstObject.title, @"new child");
+}
+
+- (void)testCopyOfUnmodifiedBuilderReusesPreviouslyBuiltModel
+{
+    self.builder.title = @"title";
+    [self.builder builderForChildWithIdentifier:@"child"].title = @"child";
+    
+    HUBComponentModelBuilderImplementation * const builderCopy = [self.builder copy];
+    id<HUBComponentModel> const model = [self.builder buildForIndex:0 parent:nil];
+    
+    XCTAssertTrue([builderCopy buildForIndex:0 parent:nil] == model);
+    
+    [builderCopy builderForChildWithIdentifier:@"child"].title = @"new child";
+    
+    XCTAssertFalse([builderCopy buildForIndex:0 parent:nil] == model);
+    XCTAssertTrue([self.builder buildForIndex:0 parent:nil] == model);
+}
+
 - (void)testBuildersForChildrenInGroupWhenAddingChildBuilder
 {
     NSString * const firstChildModelIdentifier = @"firstIdentifier";
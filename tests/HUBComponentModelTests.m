@@ -113,7 +113,11 @@
                                                                     parent:nil];
     };
     
-    XCTAssertEqualObjects(createComponentModel(), createComponentModel());
+    id<HUBComponentModel> const componentModelA = createComponentModel();
+    id<HUBComponentModel> const componentModelB = createComponentModel();
+    
+    XCTAssertEqualObjects(componentModelA, componentModelB);
+    XCTAssertEqual(componentModelA.hash, componentModelB.hash);
 }
 
 - (void)testNonIdenticalInstancesAreNotEqual
@@ -182,6 +186,55 @@
     XCTAssertEqualObjects(grandchild.indexPath, [NSIndexPath indexPathWithIndexes:grandchildIndexPathArray length:3]);
 }
 
+- (void)testScalarAndCategoryPropertiesAffectEquality
+{
+    id<HUBComponentModel> (^createComponentModel)(HUBComponentType, HUBComponentCategory) = ^(HUBComponentType type, HUBComponentCategory category) {
+        HUBIdentifier * const componentIdentifier = [[HUBIdentifier alloc] initWithNamespace:@"namespace" name:@"name"];
+        
+        return [[HUBComponentModelImplementation alloc] initWithIdentifier:@"id"
+                                                                      type:type
+                                                                     index:0
+                                                           groupIdentifier:nil
+                                                       componentIdentifier:componentIdentifier
+                                                         componentCategory:category
+                                                                     title:nil
+                                                                  subtitle:nil
+                                                            accessoryTitle:nil
+                                                           descriptionText:nil
+                                                             mainImageData:nil
+                                                       backgroundImageData:nil
+                                                           customImageData:@{}
+                                                                      icon:nil
+                                                                    target:nil
+                                                                  metadata:nil
+                                                               loggingData:nil
+                                                                customData:nil
+                                                                    parent:nil];
+    };
+    
+    XCTAssertEqualObjects(createComponentModel(HUBComponentTypeBody, HUBComponentCategoryRow),
+                          createComponentModel(HUBComponentTypeBody, HUBComponentCategoryRow));
+    XCTAssertNotEqualObjects(createComponentModel(HUBComponentTypeBody, HUBComponentCategoryRow),
+                             createComponentModel(HUBComponentTypeHeader, HUBComponentCategoryRow));
+    XCTAssertNotEqualObjects(createComponentModel(HUBComponentTypeBody, HUBComponentCategoryRow),
+                             createComponentModel(HUBComponentTypeBody, HUBComponentCategoryCard));
+}
+
+- (void)testHashCoversChildren
+{
+    HUBComponentModelImplementation * const parentA = [self createComponentModelWithIdentifier:@"parent" index:0];
+    parentA.children = @[[self createComponentModelWithIdentifier:@"child" index:0 parent:parentA]];
+    HUBComponentModelImplementation * const parentB = [self createComponentModelWithIdentifier:@"parent" index:0];
+    parentB.children = @[[self createComponentModelWithIdentifier:@"otherChild" index:0 parent:parentB]];
+    HUBComponentModelImplementation * const parentC = [self createComponentModelWithIdentifier:@"parent" index:0];
+    parentC.children = @[[self createComponentModelWithIdentifier:@"child" index:0 parent:parentC]];
+    
+    XCTAssertNotEqual(parentA.hash, parentB.hash);
+    XCTAssertNotEqualObjects(parentA, parentB);
+    XCTAssertEqual(parentA.hash, parentC.hash);
+    XCTAssertEqualObjects(parentA, parentC);
+}
+
 - (void)testPropertiesThatDoNotAffectEquality
 {
     HUBComponentModelImplementation * const parent1 = [self createComponentModelWithIdentifier:@"parent1" index:0];
@@ -195,8 +248,9 @@
     XCTAssertNotEqual(child1.index, child2.index);
     XCTAssertNotEqualObjects(child1.indexPath, child2.indexPath);
 
-    // The parents, indices and index paths should not affect the children's equality.
+    // The parents, indices and index paths should not affect the children's equality, or their hashes.
     XCTAssertEqualObjects(child1, child2);
+    XCTAssertEqual(child1.hash, child2.hash);
 }
 
 #pragma mark - Utilities
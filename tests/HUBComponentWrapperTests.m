@@ -29,6 +29,8 @@
 #import "HUBComponentMock.h"
 #import "HUBIdentifier.h"
 #import "HUBSingleGestureRecognizerSynchronizer.h"
+#import "HUBViewModelDiff.h"
+#import "HUBViewModelUtilities.h"
 
 /**
  *  Class extension used to expose the method that the component wrapper uses to handle its gesture recognizer
@@ -41,6 +43,27 @@
 
 @end
 
+/// Component mock that displays new child components in place of any reloaded children
+@interface HUBChildUpdatingComponentMock : HUBComponentMock <HUBComponentWithChildUpdates>
+
+@end
+
+@implementation HUBChildUpdatingComponentMock
+
+- (void)updateViewForChildChangesInModel:(id<HUBComponentModel>)model
+                    insertedChildIndexes:(NSIndexSet *)insertedChildIndexes
+                     deletedChildIndexes:(NSIndexSet *)deletedChildIndexes
+                    reloadedChildIndexes:(NSIndexSet *)reloadedChildIndexes
+                       movedChildIndexes:(NSDictionary<NSNumber *, NSNumber *> *)movedChildIndexes
+{
+    [reloadedChildIndexes enumerateIndexesUsingBlock:^(NSUInteger childIndex, BOOL *stop) {
+        [self.childDelegate component:self childComponentForModel:model.children[childIndex]];
+        [self.childDelegate component:self willDisplayChildAtIndex:childIndex view:[UIView new]];
+    }];
+}
+
+@end
+
 @interface HUBComponentWrapperTests : XCTestCase <HUBComponentWrapperDelegate>
 
 @property (nonatomic, strong) HUBComponentUIStateManager *UIStateManager;
@@ -161,6 +184,43 @@
     XCTAssertEqualObjects(superview.gestureRecognizers, @[]);
 }
 
+- (void)testReloadingVisibleChildReplacesChildComponent
+{
+    HUBChildUpdatingComponentMock * const component = [HUBChildUpdatingComponentMock new];
+    id<HUBComponentModel> const model = [self componentModelWithIdentifier:@"carousel" childTitles:@[@"A", @"B", @"C"]];
+    HUBComponentWrapper * const componentWrapper = [self componentWrapperForComponent:component model:model];
+    [componentWrapper loadView];
+    [componentWrapper configureViewWithModel:model containerViewSize:CGSizeMake(320.0, 480.0)];
+    
+    for (NSUInteger childIndex = 0; childIndex < model.children.count; childIndex++) {
+        [component.childDelegate component:component childComponentForModel:model.children[childIndex]];
+        [component.childDelegate component:component willDisplayChildAtIndex:childIndex view:[UIView new]];
+    }
+    
+    HUBComponentWrapper * const reloadedChild = [componentWrapper visibleChildComponentAtIndex:1];
+    HUBComponentWrapper * const unchangedChild = [componentWrapper visibleChildComponentAtIndex:2];
+    XCTAssertEqual(reloadedChild.parent, componentWrapper);
+    
+    id<HUBComponentModel> const newModel = [self componentModelWithIdentifier:@"carousel" childTitles:@[@"A", @"B2", @"C"]];
+    id<HUBViewModel> const viewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"view" components:@[model]];
+    id<HUBViewModel> const newViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"view" components:@[newModel]];
+    HUBViewModelDiff * const diff = [HUBViewModelDiff diffFromViewModel:viewModel toViewModel:newViewModel];
+    HUBViewModelDiff * const childDiff = diff.childComponentDiffs[[NSIndexPath indexPathForItem:0 inSection:0]];
+    XCTAssertEqualObjects(childDiff.reloadedBodyComponentIndexPaths, @[[NSIndexPath indexPathForItem:1 inSection:0]]);
+    
+    [componentWrapper updateViewForChildChangesInModel:newModel diff:childDiff];
+    
+    HUBComponentWrapper * const newChild = [componentWrapper visibleChildComponentAtIndex:1];
+    XCTAssertNotNil(newChild);
+    XCTAssertNotEqual(newChild, reloadedChild);
+    XCTAssertEqualObjects(newChild.model.title, @"B2");
+    XCTAssertEqual([componentWrapper visibleChildComponentAtIndex:2], unchangedChild);
+    
+    // The replaced child component is torn down rather than keeping a reference to its previous parent
+    XCTAssertNil(reloadedChild.parent);
+    XCTAssertEqual(unchangedChild.parent, componentWrapper);
+}
+
 #pragma mark - Utility
 
 - (HUBComponentWrapper *)componentWrapperForComponent:(id<HUBComponent>)component
@@ -175,15 +235,34 @@
 }
 
 - (id<HUBComponentModel>)componentModelWithIdentifier:(NSString *)identifier
+{
+    return [self componentModelWithIdentifier:identifier index:0 title:@"title"];
+}
+
+- (id<HUBComponentModel>)componentModelWithIdentifier:(NSString *)identifier childTitles:(NSArray<NSString *> *)childTitles
+{
+    HUBComponentModelImplementation * const componentModel = (HUBComponentModelImplementation *)[self componentModelWithIdentifier:identifier];
+    NSMutableArray<id<HUBComponentModel>> * const children = [NSMutableArray new];
+    
+    for (NSUInteger childIndex = 0; childIndex < childTitles.count; childIndex++) {
+        NSString * const childIdentifier = [NSString stringWithFormat:@"%@-child-%@", identifier, @(childIndex)];
+        [children addObject:[self componentModelWithIdentifier:childIdentifier index:childIndex title:childTitles[childIndex]]];
+    }
+    
+    componentModel.children = children;
+    return componentModel;
+}
+
+- (id<HUBComponentModel>)componentModelWithIdentifier:(NSString *)identifier index:(NSUInteger)index title:(NSString *)title
 {
     HUBIdentifier * const componentIdentifier = [[HUBIdentifier alloc] initWithNamespace:@"namespace" name:@"name"];
     return [[HUBComponentModelImplementation alloc] initWithIdentifier:identifier
                                                                   type:HUBComponentTypeBody
-                                                                 index:0
+                                                                 index:index
                                                        groupIdentifier:nil
                                                    componentIdentifier:componentIdentifier
                                                      componentCategory:HUBComponentCategoryBanner
-                                                                 title:@"title"
+                                                                 title:title
                                                               subtitle:@"subtitle"
                                                         accessoryTitle:nil
                                                        descriptionText:nil
@@ -234,7 +313,7 @@
                                            UIStateManager:self.UIStateManager
                                                  delegate:self
                                         gestureRecognizer:self.gestureRecognizer
-                                                   parent:nil];
+                                                   parent:componentWrapper];
 }
 
 - (void)componentWrapper:(HUBComponentWrapper *)componentWrapper childComponent:(HUBComponentWrapper *)childComponent childView:(UIView *)childView willAppearAtIndex:(NSUInteger)childIndex
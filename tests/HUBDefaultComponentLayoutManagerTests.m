@@ -153,4 +153,72 @@
     HUBAssertEqualCGFloatValues(offset, 145);
 }
 
+- (void)testLayoutTraitMaskFromLayoutTraits
+{
+    NSSet * const layoutTraits = [NSSet setWithObjects:HUBComponentLayoutTraitFullWidth, HUBComponentLayoutTraitStackable, nil];
+    HUBComponentLayoutTraitMask const expectedMask = HUBComponentLayoutTraitMaskFullWidth | HUBComponentLayoutTraitMaskStackable;
+    
+    XCTAssertEqual(HUBComponentLayoutTraitMaskFromLayoutTraits(layoutTraits), expectedMask);
+    XCTAssertEqual(HUBComponentLayoutTraitMaskFromLayoutTraits([NSSet set]), HUBComponentLayoutTraitMaskNone);
+    
+    NSSet * const customLayoutTraits = [NSSet setWithObjects:HUBComponentLayoutTraitCentered, @"custom", nil];
+    HUBComponentLayoutTraitMask const expectedCustomMask = HUBComponentLayoutTraitMaskCentered | HUBComponentLayoutTraitMaskCustom;
+    XCTAssertEqual(HUBComponentLayoutTraitMaskFromLayoutTraits(customLayoutTraits), expectedCustomMask);
+}
+
+- (void)testLayoutTraitMaskMarginsEqualToLayoutTraitMargins
+{
+    HUBDefaultComponentLayoutManager * const manager = [[HUBDefaultComponentLayoutManager alloc] initWithMargin:10];
+    NSArray<NSSet<HUBComponentLayoutTrait> *> * const allLayoutTraits = @[
+        [NSSet setWithObject:HUBComponentLayoutTraitCompactWidth],
+        [NSSet setWithObject:HUBComponentLayoutTraitFullWidth],
+        [NSSet setWithObjects:HUBComponentLayoutTraitFullWidth, HUBComponentLayoutTraitStackable, nil],
+        [NSSet setWithObject:HUBComponentLayoutTraitCentered],
+        [NSSet setWithObject:HUBComponentLayoutTraitAlwaysStackUpwards]
+    ];
+    
+    for (NSSet<HUBComponentLayoutTrait> * const layoutTraits in allLayoutTraits) {
+        HUBComponentLayoutTraitMask const layoutTraitMask = HUBComponentLayoutTraitMaskFromLayoutTraits(layoutTraits);
+        
+        HUBAssertEqualCGFloatValues([manager marginBetweenComponentWithLayoutTraitMask:layoutTraitMask andContentEdge:HUBComponentLayoutContentEdgeTop],
+                                    [manager marginBetweenComponentWithLayoutTraits:layoutTraits andContentEdge:HUBComponentLayoutContentEdgeTop]);
+        HUBAssertEqualCGFloatValues([manager marginBetweenComponentWithLayoutTraitMask:layoutTraitMask andContentEdge:HUBComponentLayoutContentEdgeLeft],
+                                    [manager marginBetweenComponentWithLayoutTraits:layoutTraits andContentEdge:HUBComponentLayoutContentEdgeLeft]);
+        
+        for (NSSet<HUBComponentLayoutTrait> * const precedingLayoutTraits in allLayoutTraits) {
+            HUBComponentLayoutTraitMask const precedingLayoutTraitMask = HUBComponentLayoutTraitMaskFromLayoutTraits(precedingLayoutTraits);
+            
+            HUBAssertEqualCGFloatValues([manager horizontalMarginForComponentWithLayoutTraitMask:layoutTraitMask
+                                                               precedingComponentLayoutTraitMask:precedingLayoutTraitMask],
+                                        [manager horizontalMarginForComponentWithLayoutTraits:layoutTraits
+                                                               precedingComponentLayoutTraits:precedingLayoutTraits]);
+            
+            HUBAssertEqualCGFloatValues([manager verticalMarginForComponentWithLayoutTraitMask:layoutTraitMask
+                                                             precedingComponentLayoutTraitMask:precedingLayoutTraitMask],
+                                        [manager verticalMarginForComponentWithLayoutTraits:layoutTraits
+                                                             precedingComponentLayoutTraits:precedingLayoutTraits]);
+        }
+    }
+}
+
+- (void)testCenteringWithLayoutTraitMasks
+{
+    HUBDefaultComponentLayoutManager * const manager = [[HUBDefaultComponentLayoutManager alloc] initWithMargin:10];
+    HUBComponentLayoutTraitMask const centeredLayoutTraitMasks[] = {HUBComponentLayoutTraitMaskCentered, HUBComponentLayoutTraitMaskCentered};
+    HUBComponentLayoutTraitMask const mixedLayoutTraitMasks[] = {HUBComponentLayoutTraitMaskCentered, HUBComponentLayoutTraitMaskCompactWidth};
+    
+    CGFloat const centeredOffset = [manager horizontalOffsetForComponentsWithLayoutTraitMasks:centeredLayoutTraitMasks
+                                                                                        count:2
+                                                        firstComponentLeadingHorizontalOffset:10
+                                                        lastComponentTrailingHorizontalOffset:300];
+    
+    CGFloat const mixedOffset = [manager horizontalOffsetForComponentsWithLayoutTraitMasks:mixedLayoutTraitMasks
+                                                                                     count:2
+                                                     firstComponentLeadingHorizontalOffset:10
+                                                     lastComponentTrailingHorizontalOffset:300];
+    
+    HUBAssertEqualCGFloatValues(centeredOffset, 145);
+    HUBAssertEqualCGFloatValues(mixedOffset, 0);
+}
+
 @end
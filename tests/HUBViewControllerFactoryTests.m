@@ -41,6 +41,24 @@
 #import "HUBComponentModel.h"
 #import "HUBComponentModelBuilder.h"
 #import "HUBActionContext.h"
+#import "HUBViewModelRenderer.h"
+#import "HUBViewModelDiff.h"
+#import "HUBCollectionViewLayout.h"
+#import "HUBCollectionContainerView.h"
+#import "HUBTestUtilities.h"
+#import "UIViewController+HUBSimulateLayoutCycle.h"
+
+@interface HUBViewControllerImplementation (HUBExposeInternalsForTesting)
+
+@property (nonatomic, strong, readonly) HUBViewModelRenderer *viewModelRenderer;
+
+@end
+
+@interface HUBViewModelRenderer (HUBExposeInternalsForTesting)
+
+@property (nonatomic, assign, readonly) HUBDiffAlgorithm *diffAlgorithm;
+
+@end
 
 @interface HUBViewControllerFactoryTests : XCTestCase
 
@@ -107,6 +125,19 @@
                                                         options:options];
 }
 
+- (HUBViewControllerImplementation *)createStandardViewControllerForViewURI:(NSURL *)viewURI
+                                                                    options:(nullable NSDictionary<NSString *, NSString *> *)options
+{
+    [self registerFeatureWithViewURI:viewURI options:options];
+    
+    HUBViewController * const viewController = [self.manager.viewControllerFactory createViewControllerForViewURI:viewURI];
+    XCTAssertTrue([viewController isKindOfClass:[HUBViewControllerImplementation class]]);
+    
+    [self.manager.featureRegistry unregisterFeatureWithIdentifier:@"feature"];
+    
+    return (HUBViewControllerImplementation *)viewController;
+}
+
 - (void)testCreatingViewControllerWithoutOptions
 {
     NSURL * const viewURI = [NSURL URLWithString:@"spotify:hub:framework"];
@@ -137,6 +168,58 @@
     XCTAssertTrue([viewController isKindOfClass:[HUBViewControllerExperimentalImplementation class]]);
 }
 
+- (void)testCreatingViewControllerWithDiffAlgorithmOptions
+{
+    NSURL * const viewURI = [NSURL URLWithString:@"spotify:hub:framework"];
+    HUBViewControllerImplementation * const defaultViewController = [self createStandardViewControllerForViewURI:viewURI options:nil];
+    XCTAssertTrue(defaultViewController.viewModelRenderer.diffAlgorithm == HUBDiffMyersAlgorithm);
+    
+    HUBViewControllerImplementation * const heckelViewController = [self createStandardViewControllerForViewURI:viewURI
+                                                                                                         options:@{@"HUBViewModelDiff" : @"heckel"}];
+    XCTAssertTrue(heckelViewController.viewModelRenderer.diffAlgorithm == HUBDiffHeckelAlgorithm);
+    
+    HUBViewControllerImplementation * const lcsViewController = [self createStandardViewControllerForViewURI:viewURI
+                                                                                                      options:@{@"HUBViewModelDiff" : @"lcs"}];
+    XCTAssertTrue(lcsViewController.viewModelRenderer.diffAlgorithm == HUBDiffLCSAlgorithm);
+}
+
+- (void)testCreatingViewControllerWithMaximumChangedFractionOption
+{
+    NSURL * const viewURI = [NSURL URLWithString:@"spotify:hub:framework"];
+    HUBViewControllerImplementation * const defaultViewController = [self createStandardViewControllerForViewURI:viewURI options:nil];
+    HUBAssertEqualCGFloatValues(defaultViewController.viewModelRenderer.maximumChangedFraction, 1);
+    
+    HUBViewControllerImplementation * const viewController = [self createStandardViewControllerForViewURI:viewURI
+                                                                                                   options:@{@"HUBViewModelDiffMaximumChangedFraction" : @"0.25"}];
+    HUBAssertEqualCGFloatValues(viewController.viewModelRenderer.maximumChangedFraction, (CGFloat)0.25);
+}
+
+- (void)testCreatingViewControllerWithVirtualizedLayoutOption
+{
+    NSURL * const viewURI = [NSURL URLWithString:@"spotify:hub:framework"];
+    HUBViewControllerImplementation * const defaultViewController = [self createStandardViewControllerForViewURI:viewURI options:nil];
+    XCTAssertFalse(defaultViewController.usesVirtualizedLayout);
+    
+    HUBViewControllerImplementation * const viewController = [self createStandardViewControllerForViewURI:viewURI
+                                                                                                   options:@{@"HUBCollectionViewLayout" : @"virtualized"}];
+    XCTAssertTrue(viewController.usesVirtualizedLayout);
+    
+    // The layout is created once the first view model is rendered
+    [viewController hub_simulateLayoutCycle];
+    
+    UICollectionView * const collectionView = ((HUBCollectionContainerView *)viewController.view).contentView;
+    XCTAssertNotNil(collectionView);
+    
+    NSPredicate * const predicate = [NSPredicate predicateWithBlock:^BOOL(UICollectionView *evaluatedCollectionView, NSDictionary *bindings) {
+        return [evaluatedCollectionView.collectionViewLayout isKindOfClass:[HUBCollectionViewLayout class]];
+    }];
+    
+    [self expectationForPredicate:predicate evaluatedWithObject:collectionView handler:nil];
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+    
+    XCTAssertTrue(((HUBCollectionViewLayout *)collectionView.collectionViewLayout).isVirtualized);
+}
+
 - (void)testCreatingViewControllerForValidViewURI
 {
     NSURL * const viewURI = [NSURL URLWithString:@"spotify:hub:framework"];
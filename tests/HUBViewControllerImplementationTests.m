@@ -307,7 +307,14 @@
     };
 
     [self.contentOperation.delegate contentOperationRequiresRescheduling:self.contentOperation];
-    XCTAssertEqual([dataSource collectionView:self.collectionView numberOfItemsInSection:0], 2);
+
+    // Batch updates are applied once the diff has been calculated in the background
+    NSPredicate * const predicate = [NSPredicate predicateWithBlock:^BOOL(id<UICollectionViewDataSource> evaluatedDataSource, NSDictionary *bindings) {
+        return [evaluatedDataSource collectionView:self.collectionView numberOfItemsInSection:0] == 2;
+    }];
+
+    [self expectationForPredicate:predicate evaluatedWithObject:dataSource handler:nil];
+    [self waitForExpectationsWithTimeout:2 handler:nil];
 }
 
 - (void)testDelegateNotifiedOfUpdatedViewModel
@@ -2746,6 +2753,35 @@
     XCTAssertTrue(CGPointEqualToPoint(expectedOffset, self.collectionView.appliedScrollViewOffset));
 }
 
+- (void)testRenderDiscardedForNewerViewModelDoesNotFinishRendering
+{
+    __block NSUInteger loadCount = 0;
+    self.contentOperation.contentLoadingBlock = ^(id<HUBViewModelBuilder> viewModelBuilder) {
+        [viewModelBuilder builderForBodyComponentModelWithIdentifier:@"component"].title = [NSString stringWithFormat:@"%@", @(loadCount)];
+        loadCount++;
+        return YES;
+    };
+
+    [self simulateViewControllerLayoutCycle];
+    [self.viewController viewDidAppear:YES];
+
+    __block NSUInteger renderCount = 0;
+    __weak XCTestExpectation * const expectation = [self expectationWithDescription:@"Waiting for render"];
+    self.viewControllerDidFinishRenderingBlock = ^{
+        renderCount++;
+        [expectation fulfill];
+    };
+
+    // The second view model is loaded before the diff for the first one has been calculated
+    [self.viewController reload];
+    [self.viewController reload];
+
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+
+    XCTAssertEqual(renderCount, 1u);
+    XCTAssertEqualObjects(self.viewController.viewModel.bodyComponentModels[0].title, @"2");
+}
+
 - (void)testLoadingPaginatedContentWhenScrollingIsAboutToReachBottom
 {
     HUBComponentFactoryMock * const componentFactory = [[HUBComponentFactoryMock alloc] initWithBlock:^(NSString *name) {
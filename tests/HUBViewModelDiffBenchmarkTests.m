@@ -0,0 +1,382 @@
+/*
+ *  Copyright (c) 2016 Spotify AB.
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ */
+
+
+#import "HUBViewModelDiff.h"
+#import "HUBComponentModel.h"
+#import "HUBViewModel.h"
+#import "HUBViewModelUtilities.h"
+#import "HUBAllocationCounter.h"
+
+#import <XCTest/XCTest.h>
+#import <UIKit/UIKit.h>
+
+/// The environment variable that enables the benchmark report, which is too slow to run as a part of the regular suite
+static NSString * const HUBViewModelDiffBenchmarkEnvironmentKey = @"HUB_DIFF_BENCHMARK";
+
+/// The kinds of changes that are applied to a synthetic view model when generating the one to diff it against
+typedef NS_ENUM(NSUInteger, HUBViewModelDiffScenario) {
+    /// Components are replaced or modified in place
+    HUBViewModelDiffScenarioEdits,
+    /// Components are moved to random positions
+    HUBViewModelDiffScenarioShuffle,
+    /// A page of components is appended
+    HUBViewModelDiffScenarioAppend
+};
+
+/// A small xorshift generator, so that every randomized run can be reproduced from its seed
+static uint64_t HUBViewModelDiffNextRandom(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+static NSUInteger HUBViewModelDiffRandomIndex(uint64_t *state, NSUInteger count) {
+    return count > 0 ? (NSUInteger)(HUBViewModelDiffNextRandom(state) % count) : 0;
+}
+
+@interface HUBViewModelDiffBenchmarkTests : XCTestCase
+
+@property (nonatomic, assign) NSUInteger identifierCount;
+
+@end
+
+@implementation HUBViewModelDiffBenchmarkTests
+
+#pragma mark - XCTestCase
+
+- (void)setUp
+{
+    [super setUp];
+    self.identifierCount = 0;
+}
+
+#pragma mark - Randomized tests
+
+- (void)testRandomizedDiffsReproduceTargetMyers
+{
+    [self runRandomizedTestWithAlgorithm:HUBDiffMyersAlgorithm isMinimal:YES];
+}
+
+- (void)testRandomizedDiffsReproduceTargetLCS
+{
+    [self runRandomizedTestWithAlgorithm:HUBDiffLCSAlgorithm isMinimal:YES];
+}
+
+- (void)testRandomizedDiffsReproduceTargetHeckel
+{
+    [self runRandomizedTestWithAlgorithm:HUBDiffHeckelAlgorithm isMinimal:NO];
+}
+
+- (void)runRandomizedTestWithAlgorithm:(HUBDiffAlgorithm)algorithm isMinimal:(BOOL)isMinimal
+{
+    for (uint64_t seed = 1; seed <= 200; seed++) {
+        uint64_t state = seed * 0x9E3779B97F4A7C15ull;
+        NSArray<id<HUBComponentModel>> * const fromModels = [self componentModelsWithCount:HUBViewModelDiffRandomIndex(&state, 120)];
+        NSArray<id<HUBComponentModel>> * const toModels = [self randomlyMutatedComponentModels:fromModels randomState:&state];
+
+        id<HUBViewModel> const fromViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test" components:fromModels];
+        id<HUBViewModel> const toViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test" components:toModels];
+
+        HUBViewModelDiff * const diff = [HUBViewModelDiff diffFromViewModel:fromViewModel toViewModel:toViewModel algorithm:algorithm];
+        [self assertDiff:diff transformsComponentModels:fromModels intoComponentModels:toModels seed:seed];
+
+        NSUInteger const editDistance = diff.insertedBodyComponentIndexPaths.count
+                                      + diff.deletedBodyComponentIndexPaths.count
+                                      + diff.movedBodyComponentIndexPaths.count * 2;
+
+        XCTAssertNotNil([HUBViewModelDiff diffFromViewModel:fromViewModel toViewModel:toViewModel algorithm:algorithm maximumEditDistance:editDistance],
+                        @"A diff within the maximum edit distance was discarded (seed %@)", @(seed));
+
+        // Only an algorithm that finds the shortest edit script can guarantee that no cheaper diff exists
+        if (isMinimal && editDistance > 0) {
+            XCTAssertNil([HUBViewModelDiff diffFromViewModel:fromViewModel toViewModel:toViewModel algorithm:algorithm maximumEditDistance:editDistance - 1],
+                         @"A diff exceeding the maximum edit distance was returned (seed %@)", @(seed));
+        }
+    }
+}
+
+#pragma mark - Benchmarks
+
+- (void)testMyersPerformanceWithFiftyThousandComponentsAppend
+{
+    [self runPerformanceTestWithAlgorithm:HUBDiffMyersAlgorithm scenario:HUBViewModelDiffScenarioAppend componentCount:50000];
+}
+
+- (void)testHeckelPerformanceWithFiftyThousandComponentsAppend
+{
+    [self runPerformanceTestWithAlgorithm:HUBDiffHeckelAlgorithm scenario:HUBViewModelDiffScenarioAppend componentCount:50000];
+}
+
+- (void)testMyersPerformanceWithFiftyThousandComponentsShuffle
+{
+    [self runPerformanceTestWithAlgorithm:HUBDiffMyersAlgorithm scenario:HUBViewModelDiffScenarioShuffle componentCount:50000];
+}
+
+- (void)testHeckelPerformanceWithFiftyThousandComponentsShuffle
+{
+    [self runPerformanceTestWithAlgorithm:HUBDiffHeckelAlgorithm scenario:HUBViewModelDiffScenarioShuffle componentCount:50000];
+}
+
+- (void)runPerformanceTestWithAlgorithm:(HUBDiffAlgorithm)algorithm
+                               scenario:(HUBViewModelDiffScenario)scenario
+                         componentCount:(NSUInteger)componentCount
+{
+    uint64_t state = 42;
+    NSArray<id<HUBComponentModel>> * const fromModels = [self componentModelsWithCount:componentCount];
+    NSArray<id<HUBComponentModel>> * const toModels = [self componentModels:fromModels changedForScenario:scenario randomState:&state];
+
+    id<HUBViewModel> const fromViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test" components:fromModels];
+    id<HUBViewModel> const toViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test" components:toModels];
+
+    [self measureBlock:^{
+        HUBViewModelDiff * const diff = [HUBViewModelDiff diffFromViewModel:fromViewModel toViewModel:toViewModel algorithm:algorithm];
+        XCTAssertTrue(diff.hasChanges);
+    }];
+}
+
+/**
+ *  Logs the time it takes for each algorithm to diff every combination of model size and scenario
+ *
+ *  Along with the time, the number of heap allocations made by each diff is logged. Since the larger sizes take a long
+ *  time to run, the report is only generated when the HUB_DIFF_BENCHMARK environment variable is set.
+ */
+- (void)testBenchmarkReport
+{
+    if (NSProcessInfo.processInfo.environment[HUBViewModelDiffBenchmarkEnvironmentKey] == nil) {
+        return;
+    }
+
+    HUBDiffAlgorithm * const algorithms[] = {HUBDiffMyersAlgorithm, HUBDiffHeckelAlgorithm, HUBDiffLCSAlgorithm};
+    NSArray<NSString *> * const algorithmNames = @[@"Myers", @"Heckel", @"LCS"];
+    NSArray<NSString *> * const scenarioNames = @[@"edits", @"shuffle", @"append"];
+    NSArray<NSNumber *> * const componentCounts = @[@100, @1000, @10000, @50000];
+    NSUInteger const iterationCount = 5;
+
+    for (NSNumber * const componentCount in componentCounts) {
+        for (HUBViewModelDiffScenario scenario = HUBViewModelDiffScenarioEdits; scenario <= HUBViewModelDiffScenarioAppend; scenario++) {
+            uint64_t state = 42;
+            NSArray<id<HUBComponentModel>> * const fromModels = [self componentModelsWithCount:componentCount.unsignedIntegerValue];
+            NSArray<id<HUBComponentModel>> * const toModels = [self componentModels:fromModels changedForScenario:scenario randomState:&state];
+            id<HUBViewModel> const fromViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test" components:fromModels];
+            id<HUBViewModel> const toViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test" components:toModels];
+
+            for (NSUInteger algorithmIndex = 0; algorithmIndex < algorithmNames.count; algorithmIndex++) {
+                HUBDiffAlgorithm * const algorithm = algorithms[algorithmIndex];
+                NSString * const algorithmName = algorithmNames[algorithmIndex];
+
+                // The O(N * M) matrix of the LCS algorithm doesn't fit in memory for the larger sizes
+                if (algorithm == HUBDiffLCSAlgorithm && componentCount.unsignedIntegerValue > 1000) {
+                    continue;
+                }
+
+                CFAbsoluteTime const startTime = CFAbsoluteTimeGetCurrent();
+
+                for (NSUInteger iteration = 0; iteration < iterationCount; iteration++) {
+                    @autoreleasepool {
+                        [HUBViewModelDiff diffFromViewModel:fromViewModel toViewModel:toViewModel algorithm:algorithm];
+                    }
+                }
+
+                CFAbsoluteTime const averageTime = (CFAbsoluteTimeGetCurrent() - startTime) / iterationCount;
+
+                // Counted separately, since counting slows down every allocation
+                NSUInteger allocationCount = 0;
+                @autoreleasepool {
+                    allocationCount = [HUBAllocationCounter countAllocationsInBlock:^{
+                        [HUBViewModelDiff diffFromViewModel:fromViewModel toViewModel:toViewModel algorithm:algorithm];
+                    }];
+                }
+
+                NSLog(@"[HUBViewModelDiff] %@ components, %@: %@ took %.3f ms (%@ allocations)",
+                      componentCount, scenarioNames[scenario], algorithmName, averageTime * 1000, @(allocationCount));
+            }
+        }
+    }
+}
+
+#pragma mark - Utilities
+
+- (id<HUBComponentModel>)newComponentModel
+{
+    NSString * const identifier = [NSString stringWithFormat:@"component-%@", @(self.identifierCount++)];
+    return [HUBViewModelUtilities createComponentModelWithIdentifier:identifier customData:nil];
+}
+
+- (NSArray<id<HUBComponentModel>> *)componentModelsWithCount:(NSUInteger)count
+{
+    NSMutableArray<id<HUBComponentModel>> * const componentModels = [NSMutableArray arrayWithCapacity:count];
+
+    for (NSUInteger index = 0; index < count; index++) {
+        [componentModels addObject:[self newComponentModel]];
+    }
+
+    return [componentModels copy];
+}
+
+- (id<HUBComponentModel>)modifiedComponentModel:(id<HUBComponentModel>)componentModel randomState:(uint64_t *)state
+{
+    NSDictionary * const customData = @{@"revision": @(HUBViewModelDiffNextRandom(state))};
+    return [HUBViewModelUtilities createComponentModelWithIdentifier:componentModel.identifier customData:customData];
+}
+
+- (NSArray<id<HUBComponentModel>> *)randomlyMutatedComponentModels:(NSArray<id<HUBComponentModel>> *)componentModels
+                                                        randomState:(uint64_t *)state
+{
+    NSMutableArray<id<HUBComponentModel>> * const mutatedModels = [componentModels mutableCopy];
+    NSUInteger const mutationCount = HUBViewModelDiffRandomIndex(state, 30);
+
+    for (NSUInteger mutation = 0; mutation < mutationCount; mutation++) {
+        NSUInteger const index = HUBViewModelDiffRandomIndex(state, mutatedModels.count);
+
+        switch (HUBViewModelDiffRandomIndex(state, 5)) {
+            case 0:
+                [mutatedModels insertObject:[self newComponentModel] atIndex:HUBViewModelDiffRandomIndex(state, mutatedModels.count + 1)];
+                break;
+            case 1:
+                if (mutatedModels.count > 0) {
+                    [mutatedModels removeObjectAtIndex:index];
+                }
+                break;
+            case 2:
+                if (mutatedModels.count > 0) {
+                    mutatedModels[index] = [self modifiedComponentModel:mutatedModels[index] randomState:state];
+                }
+                break;
+            case 3:
+                if (mutatedModels.count > 0) {
+                    id<HUBComponentModel> const movedModel = mutatedModels[index];
+                    [mutatedModels removeObjectAtIndex:index];
+                    [mutatedModels insertObject:movedModel atIndex:HUBViewModelDiffRandomIndex(state, mutatedModels.count + 1)];
+                }
+                break;
+            default:
+                [mutatedModels addObjectsFromArray:[self componentModelsWithCount:HUBViewModelDiffRandomIndex(state, 20)]];
+                break;
+        }
+    }
+
+    return [mutatedModels copy];
+}
+
+- (NSArray<id<HUBComponentModel>> *)componentModels:(NSArray<id<HUBComponentModel>> *)componentModels
+                                 changedForScenario:(HUBViewModelDiffScenario)scenario
+                                        randomState:(uint64_t *)state
+{
+    NSMutableArray<id<HUBComponentModel>> * const changedModels = [componentModels mutableCopy];
+    NSUInteger const count = componentModels.count;
+
+    switch (scenario) {
+        case HUBViewModelDiffScenarioEdits:
+            // 1% of the components are replaced, and another 2% are modified
+            for (NSUInteger index = 0; index < count; index++) {
+                if (index % 100 == 0) {
+                    changedModels[index] = [self newComponentModel];
+                } else if (index % 50 == 0) {
+                    changedModels[index] = [self modifiedComponentModel:changedModels[index] randomState:state];
+                }
+            }
+            break;
+        case HUBViewModelDiffScenarioShuffle:
+            // 1% of the components are moved to random positions
+            for (NSUInteger move = 0; move < MAX(count / 100, 1u); move++) {
+                NSUInteger const index = HUBViewModelDiffRandomIndex(state, count);
+                id<HUBComponentModel> const movedModel = changedModels[index];
+                [changedModels removeObjectAtIndex:index];
+                [changedModels insertObject:movedModel atIndex:HUBViewModelDiffRandomIndex(state, count)];
+            }
+            break;
+        case HUBViewModelDiffScenarioAppend:
+            // A page of 10% of the components is appended
+            [changedModels addObjectsFromArray:[self componentModelsWithCount:MAX(count / 10, 1u)]];
+            break;
+    }
+
+    return [changedModels copy];
+}
+
+/**
+ *  Replays a diff the way a collection view performs batch updates, and asserts that the result equals the target
+ *
+ *  Deletions, reloads and the sources of moves refer to the original indexes, while insertions and the destinations of
+ *  moves refer to the final ones. The remaining components keep their relative order.
+ */
+- (void)assertDiff:(HUBViewModelDiff *)diff
+    transformsComponentModels:(NSArray<id<HUBComponentModel>> *)fromModels
+          intoComponentModels:(NSArray<id<HUBComponentModel>> *)toModels
+                         seed:(uint64_t)seed
+{
+    NSMutableIndexSet * const removedIndexes = [NSMutableIndexSet indexSet];
+    NSMutableIndexSet * const reloadedIndexes = [NSMutableIndexSet indexSet];
+    NSMutableArray * const replayedModels = [NSMutableArray arrayWithCapacity:toModels.count];
+
+    for (NSUInteger index = 0; index < toModels.count; index++) {
+        [replayedModels addObject:[NSNull null]];
+    }
+
+    for (NSIndexPath * const indexPath in diff.deletedBodyComponentIndexPaths) {
+        [removedIndexes addIndex:(NSUInteger)indexPath.item];
+    }
+
+    for (NSIndexPath * const indexPath in diff.reloadedBodyComponentIndexPaths) {
+        [reloadedIndexes addIndex:(NSUInteger)indexPath.item];
+    }
+
+    for (NSIndexPath * const indexPath in diff.insertedBodyComponentIndexPaths) {
+        NSUInteger const index = (NSUInteger)indexPath.item;
+        XCTAssertLessThan(index, toModels.count, @"Insertion out of bounds (seed %@)", @(seed));
+        replayedModels[index] = toModels[index];
+    }
+
+    [diff.movedBodyComponentIndexPaths enumerateKeysAndObjectsUsingBlock:^(NSIndexPath *fromIndexPath, NSIndexPath *toIndexPath, BOOL *stop) {
+        [removedIndexes addIndex:(NSUInteger)fromIndexPath.item];
+        replayedModels[(NSUInteger)toIndexPath.item] = fromModels[(NSUInteger)fromIndexPath.item];
+    }];
+
+    XCTAssertFalse([reloadedIndexes intersectsIndexSet:removedIndexes],
+                   @"Components can't be reloaded and deleted or moved in the same batch (seed %@)", @(seed));
+
+    NSUInteger toIndex = 0;
+
+    for (NSUInteger fromIndex = 0; fromIndex < fromModels.count; fromIndex++) {
+        if ([removedIndexes containsIndex:fromIndex]) {
+            continue;
+        }
+
+        while (toIndex < replayedModels.count && replayedModels[toIndex] != [NSNull null]) {
+            toIndex++;
+        }
+
+        if (toIndex >= replayedModels.count) {
+            XCTFail(@"More components remain than fit in the target (seed %@)", @(seed));
+            return;
+        }
+
+        replayedModels[toIndex] = [reloadedIndexes containsIndex:fromIndex] ? toModels[toIndex] : fromModels[fromIndex];
+    }
+
+    XCTAssertEqualObjects(replayedModels, toModels, @"Replaying the diff didn't reproduce the target (seed %@)", @(seed));
+}
+
+@end
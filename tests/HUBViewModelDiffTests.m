@@ -44,6 +44,11 @@
     [self runIdenticalModelTestWithAlgorithm:HUBDiffLCSAlgorithm];
 }
 
+- (void)testIdenticalModelHeckel
+{
+    [self runIdenticalModelTestWithAlgorithm:HUBDiffHeckelAlgorithm];
+}
+
 - (void)runIdenticalModelTestWithAlgorithm:(HUBDiffAlgorithm)algorithm
 {
     NSArray<id<HUBComponentModel>> *components = @[
@@ -71,6 +76,11 @@
     [self runInsertionsTestWithAlgorithm:HUBDiffLCSAlgorithm];
 }
 
+- (void)testInsertionsHeckel
+{
+    [self runInsertionsTestWithAlgorithm:HUBDiffHeckelAlgorithm];
+}
+
 - (void)runInsertionsTestWithAlgorithm:(HUBDiffAlgorithm)algorithm
 {
     id<HUBViewModel> firstViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test"
@@ -105,6 +115,11 @@
     [self runReloadsTestWithAlgorithm:HUBDiffLCSAlgorithm];
 }
 
+- (void)testReloadsHeckel
+{
+    [self runReloadsTestWithAlgorithm:HUBDiffHeckelAlgorithm];
+}
+
 - (void)runReloadsTestWithAlgorithm:(HUBDiffAlgorithm)algorithm
 {
     NSArray<id<HUBComponentModel>> *firstComponents = @[
@@ -144,6 +159,11 @@
     [self runDeletionsTestWithAlgorithm:HUBDiffLCSAlgorithm];
 }
 
+- (void)testDeletionsHeckel
+{
+    [self runDeletionsTestWithAlgorithm:HUBDiffHeckelAlgorithm];
+}
+
 - (void)runDeletionsTestWithAlgorithm:(HUBDiffAlgorithm)algorithm
 {
     NSArray<id<HUBComponentModel>> *firstComponents = @[
@@ -180,6 +200,11 @@
     [self runComplextChangeSetTestWithAlgorithm:HUBDiffLCSAlgorithm];
 }
 
+- (void)testComplexChangeSetHeckel
+{
+    [self runComplextChangeSetTestWithAlgorithm:HUBDiffHeckelAlgorithm];
+}
+
 - (void)runComplextChangeSetTestWithAlgorithm:(HUBDiffAlgorithm)algorithm
 {
     NSArray<id<HUBComponentModel>> *firstComponents = @[
@@ -234,6 +259,11 @@
     [self runInsertionOfSingleComponentModelAtStartWithDataChangesTestWithAlgorithm:HUBDiffLCSAlgorithm];
 }
 
+- (void)testInsertionOfSingleComponentModelAtStartWithDataChangesHeckel
+{
+    [self runInsertionOfSingleComponentModelAtStartWithDataChangesTestWithAlgorithm:HUBDiffHeckelAlgorithm];
+}
+
 - (void)runInsertionOfSingleComponentModelAtStartWithDataChangesTestWithAlgorithm:(HUBDiffAlgorithm)algorithm
 {
     NSArray<id<HUBComponentModel>> *firstComponents = @[
@@ -273,6 +303,11 @@
     [self runInsertionOfMultipleComponentModelsAtStartWithDataChangesTestWithAlgorithm:HUBDiffLCSAlgorithm];
 }
 
+- (void)testInsertionOfMultipleComponentModelsAtStartWithDataChangesHeckel
+{
+    [self runInsertionOfMultipleComponentModelsAtStartWithDataChangesTestWithAlgorithm:HUBDiffHeckelAlgorithm];
+}
+
 - (void)runInsertionOfMultipleComponentModelsAtStartWithDataChangesTestWithAlgorithm:(HUBDiffAlgorithm)algorithm
 {
     NSArray<id<HUBComponentModel>> *firstComponents = @[
@@ -304,6 +339,387 @@
     XCTAssert([diff.reloadedBodyComponentIndexPaths containsObject:[NSIndexPath indexPathForItem:2 inSection:0]]);
 }
 
+- (void)testMovesMyers
+{
+    [self runMovesTestWithAlgorithm:HUBDiffMyersAlgorithm];
+}
+
+- (void)testMovesLCS
+{
+    [self runMovesTestWithAlgorithm:HUBDiffLCSAlgorithm];
+}
+
+- (void)testMovesHeckel
+{
+    [self runMovesTestWithAlgorithm:HUBDiffHeckelAlgorithm];
+}
+
+- (void)runMovesTestWithAlgorithm:(HUBDiffAlgorithm)algorithm
+{
+    NSArray<id<HUBComponentModel>> *firstComponents = @[
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-1" customData:nil],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-2" customData:nil],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-3" customData:nil],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-4" customData:nil]
+    ];
+    id<HUBViewModel> firstViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test"
+                                                                                components:firstComponents];
+    NSArray<id<HUBComponentModel>> *secondComponents = @[
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-4" customData:nil],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-1" customData:nil],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-2" customData:nil],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-3" customData:nil]
+    ];
+    id<HUBViewModel> secondViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test"
+                                                                                 components:secondComponents];
+
+    HUBViewModelDiff *diff = [HUBViewModelDiff diffFromViewModel:firstViewModel toViewModel:secondViewModel algorithm:algorithm];
+    XCTAssertEqual(diff.movedBodyComponentIndexPaths.count, 1u);
+    XCTAssertEqualObjects(diff.movedBodyComponentIndexPaths[[NSIndexPath indexPathForItem:3 inSection:0]], [NSIndexPath indexPathForItem:0 inSection:0]);
+    XCTAssert(diff.reloadedBodyComponentIndexPaths.count == 0);
+    XCTAssert(diff.insertedBodyComponentIndexPaths.count == 0);
+    XCTAssert(diff.deletedBodyComponentIndexPaths.count == 0);
+    XCTAssertTrue(diff.hasChanges);
+}
+
+- (void)testModifiedComponentIsNotMovedMyers
+{
+    [self runModifiedComponentIsNotMovedTestWithAlgorithm:HUBDiffMyersAlgorithm];
+}
+
+- (void)testModifiedComponentIsNotMovedLCS
+{
+    [self runModifiedComponentIsNotMovedTestWithAlgorithm:HUBDiffLCSAlgorithm];
+}
+
+- (void)testModifiedComponentIsNotMovedHeckel
+{
+    [self runModifiedComponentIsNotMovedTestWithAlgorithm:HUBDiffHeckelAlgorithm];
+}
+
+- (void)runModifiedComponentIsNotMovedTestWithAlgorithm:(HUBDiffAlgorithm)algorithm
+{
+    NSArray<id<HUBComponentModel>> *firstComponents = @[
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-1" customData:nil],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-2" customData:nil],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-3" customData:nil]
+    ];
+    id<HUBViewModel> firstViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test"
+                                                                                components:firstComponents];
+    NSArray<id<HUBComponentModel>> *secondComponents = @[
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-3" customData:@{@"test": @1}],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-1" customData:nil],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-2" customData:nil]
+    ];
+    id<HUBViewModel> secondViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test"
+                                                                                 components:secondComponents];
+
+    HUBViewModelDiff *diff = [HUBViewModelDiff diffFromViewModel:firstViewModel toViewModel:secondViewModel algorithm:algorithm];
+    XCTAssertEqual(diff.movedBodyComponentIndexPaths.count, 0u);
+    XCTAssert([diff.deletedBodyComponentIndexPaths containsObject:[NSIndexPath indexPathForItem:2 inSection:0]]);
+    XCTAssert([diff.insertedBodyComponentIndexPaths containsObject:[NSIndexPath indexPathForItem:0 inSection:0]]);
+    XCTAssert(diff.insertedBodyComponentIndexPaths.count == 1);
+    XCTAssert(diff.deletedBodyComponentIndexPaths.count == 1);
+    XCTAssertTrue(diff.hasChanges);
+}
+
+#pragma mark - Pagination tests
+
+- (void)testAppendedPageMyers
+{
+    [self runAppendedPageTestWithAlgorithm:HUBDiffMyersAlgorithm];
+}
+
+- (void)testAppendedPageLCS
+{
+    [self runAppendedPageTestWithAlgorithm:HUBDiffLCSAlgorithm];
+}
+
+- (void)testAppendedPageHeckel
+{
+    [self runAppendedPageTestWithAlgorithm:HUBDiffHeckelAlgorithm];
+}
+
+- (void)runAppendedPageTestWithAlgorithm:(HUBDiffAlgorithm)algorithm
+{
+    NSMutableArray<id<HUBComponentModel>> *firstComponents = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 20; i++) {
+        NSString *identifier = [NSString stringWithFormat:@"component-%@", @(i)];
+        [firstComponents addObject:[HUBViewModelUtilities createComponentModelWithIdentifier:identifier customData:nil]];
+    }
+    id<HUBViewModel> firstViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test"
+                                                                                components:firstComponents];
+
+    NSMutableArray<id<HUBComponentModel>> *secondComponents = [firstComponents mutableCopy];
+    for (NSUInteger i = 20; i < 30; i++) {
+        NSString *identifier = [NSString stringWithFormat:@"component-%@", @(i)];
+        [secondComponents addObject:[HUBViewModelUtilities createComponentModelWithIdentifier:identifier customData:nil]];
+    }
+    id<HUBViewModel> secondViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test"
+                                                                                 components:secondComponents];
+
+    HUBViewModelDiff *diff = [HUBViewModelDiff diffFromViewModel:firstViewModel toViewModel:secondViewModel algorithm:algorithm];
+    XCTAssertEqual(diff.insertedBodyComponentIndexPaths.count, 10u);
+    XCTAssertEqualObjects(diff.insertedBodyComponentIndexPaths.firstObject, [NSIndexPath indexPathForItem:20 inSection:0]);
+    XCTAssertEqualObjects(diff.insertedBodyComponentIndexPaths.lastObject, [NSIndexPath indexPathForItem:29 inSection:0]);
+    XCTAssert(diff.deletedBodyComponentIndexPaths.count == 0);
+    XCTAssert(diff.reloadedBodyComponentIndexPaths.count == 0);
+    XCTAssert(diff.movedBodyComponentIndexPaths.count == 0);
+
+    // Appending more components than the budget allows
+    XCTAssertNil([HUBViewModelDiff diffFromViewModel:firstViewModel
+                                         toViewModel:secondViewModel
+                                           algorithm:algorithm
+                                 maximumEditDistance:9]);
+}
+
+- (void)testAppendedPageWithRebuiltComponentModels
+{
+    NSMutableArray<id<HUBComponentModel>> *firstComponents = [NSMutableArray array];
+    NSMutableArray<id<HUBComponentModel>> *secondComponents = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 30; i++) {
+        NSString *identifier = [NSString stringWithFormat:@"component-%@", @(i)];
+        NSDictionary *customData = (i == 5) ? @{@"test": @1} : nil;
+        [secondComponents addObject:[HUBViewModelUtilities createComponentModelWithIdentifier:identifier customData:customData]];
+
+        if (i < 20) {
+            [firstComponents addObject:[HUBViewModelUtilities createComponentModelWithIdentifier:identifier customData:nil]];
+        }
+    }
+    id<HUBViewModel> firstViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test"
+                                                                                components:firstComponents];
+    id<HUBViewModel> secondViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test"
+                                                                                 components:secondComponents];
+
+    // Previous components that aren't the same instances still need to be checked for changes
+    HUBViewModelDiff *diff = [HUBViewModelDiff diffFromViewModel:firstViewModel toViewModel:secondViewModel];
+    XCTAssertEqual(diff.insertedBodyComponentIndexPaths.count, 10u);
+    XCTAssertEqualObjects(diff.insertedBodyComponentIndexPaths.firstObject, [NSIndexPath indexPathForItem:20 inSection:0]);
+    XCTAssertEqualObjects(diff.reloadedBodyComponentIndexPaths, @[[NSIndexPath indexPathForItem:5 inSection:0]]);
+    XCTAssert(diff.deletedBodyComponentIndexPaths.count == 0);
+}
+
+- (void)testChangesBetweenCommonPrefixAndSuffixMyers
+{
+    [self runChangesBetweenCommonPrefixAndSuffixTestWithAlgorithm:HUBDiffMyersAlgorithm];
+}
+
+- (void)testChangesBetweenCommonPrefixAndSuffixLCS
+{
+    [self runChangesBetweenCommonPrefixAndSuffixTestWithAlgorithm:HUBDiffLCSAlgorithm];
+}
+
+- (void)testChangesBetweenCommonPrefixAndSuffixHeckel
+{
+    [self runChangesBetweenCommonPrefixAndSuffixTestWithAlgorithm:HUBDiffHeckelAlgorithm];
+}
+
+- (void)runChangesBetweenCommonPrefixAndSuffixTestWithAlgorithm:(HUBDiffAlgorithm)algorithm
+{
+    NSArray<id<HUBComponentModel>> *firstComponents = @[
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-1" customData:nil],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-2" customData:nil],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-3" customData:nil],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-4" customData:nil],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-5" customData:nil]
+    ];
+    id<HUBViewModel> firstViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test"
+                                                                                components:firstComponents];
+    NSArray<id<HUBComponentModel>> *secondComponents = @[
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-1" customData:@{@"test": @1}],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-2" customData:nil],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-6" customData:nil],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-4" customData:@{@"test": @2}],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-5" customData:@{@"test": @3}]
+    ];
+    id<HUBViewModel> secondViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test"
+                                                                                 components:secondComponents];
+
+    HUBViewModelDiff *diff = [HUBViewModelDiff diffFromViewModel:firstViewModel toViewModel:secondViewModel algorithm:algorithm];
+    XCTAssertEqualObjects(diff.deletedBodyComponentIndexPaths, @[[NSIndexPath indexPathForItem:2 inSection:0]]);
+    XCTAssertEqualObjects(diff.insertedBodyComponentIndexPaths, @[[NSIndexPath indexPathForItem:2 inSection:0]]);
+    XCTAssert([diff.reloadedBodyComponentIndexPaths containsObject:[NSIndexPath indexPathForItem:0 inSection:0]]);
+    XCTAssert([diff.reloadedBodyComponentIndexPaths containsObject:[NSIndexPath indexPathForItem:3 inSection:0]]);
+    XCTAssert([diff.reloadedBodyComponentIndexPaths containsObject:[NSIndexPath indexPathForItem:4 inSection:0]]);
+    XCTAssert(diff.reloadedBodyComponentIndexPaths.count == 3);
+    XCTAssert(diff.movedBodyComponentIndexPaths.count == 0);
+}
+
+#pragma mark - Edit distance tests
+
+- (void)testMaximumEditDistanceMyers
+{
+    [self runMaximumEditDistanceTestWithAlgorithm:HUBDiffMyersAlgorithm];
+}
+
+- (void)testMaximumEditDistanceLCS
+{
+    [self runMaximumEditDistanceTestWithAlgorithm:HUBDiffLCSAlgorithm];
+}
+
+- (void)testMaximumEditDistanceHeckel
+{
+    [self runMaximumEditDistanceTestWithAlgorithm:HUBDiffHeckelAlgorithm];
+}
+
+- (void)runMaximumEditDistanceTestWithAlgorithm:(HUBDiffAlgorithm)algorithm
+{
+    NSArray<id<HUBComponentModel>> *firstComponents = @[
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-1" customData:nil],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-2" customData:nil],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-3" customData:nil],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-4" customData:nil]
+    ];
+    id<HUBViewModel> firstViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test"
+                                                                                components:firstComponents];
+    NSArray<id<HUBComponentModel>> *secondComponents = @[
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-1" customData:@{@"test": @1}],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-5" customData:nil],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-3" customData:nil],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-4" customData:nil],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-6" customData:nil]
+    ];
+    id<HUBViewModel> secondViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test"
+                                                                                 components:secondComponents];
+
+    // One deletion and two insertions, while reloads don't count towards the edit distance
+    HUBViewModelDiff *diff = [HUBViewModelDiff diffFromViewModel:firstViewModel
+                                                     toViewModel:secondViewModel
+                                                       algorithm:algorithm
+                                             maximumEditDistance:3];
+    XCTAssertNotNil(diff);
+    XCTAssertEqual(diff.reloadedBodyComponentIndexPaths.count, 1u);
+
+    XCTAssertNil([HUBViewModelDiff diffFromViewModel:firstViewModel
+                                         toViewModel:secondViewModel
+                                           algorithm:algorithm
+                                 maximumEditDistance:2]);
+
+    // The difference in length alone exceeds the maximum
+    XCTAssertNil([HUBViewModelDiff diffFromViewModel:firstViewModel
+                                         toViewModel:[HUBViewModelUtilities createViewModelWithIdentifier:@"Test" components:@[]]
+                                           algorithm:algorithm
+                                 maximumEditDistance:3]);
+}
+
+#pragma mark - Child component tests
+
+- (id<HUBComponentModel>)componentModelWithIdentifier:(NSString *)identifier
+                                           customData:(NSDictionary *)customData
+                                     childIdentifiers:(NSArray<NSString *> *)childIdentifiers
+{
+    HUBComponentModelImplementation * const componentModel = (HUBComponentModelImplementation *)[HUBViewModelUtilities createComponentModelWithIdentifier:identifier customData:customData];
+    NSMutableArray<id<HUBComponentModel>> * const children = [NSMutableArray new];
+
+    for (NSString * const childIdentifier in childIdentifiers) {
+        [children addObject:[HUBViewModelUtilities createComponentModelWithIdentifier:childIdentifier customData:nil]];
+    }
+
+    componentModel.children = children;
+    return componentModel;
+}
+
+- (void)testChildChangesMyers
+{
+    [self runChildChangesTestWithAlgorithm:HUBDiffMyersAlgorithm];
+}
+
+- (void)testChildChangesHeckel
+{
+    [self runChildChangesTestWithAlgorithm:HUBDiffHeckelAlgorithm];
+}
+
+- (void)runChildChangesTestWithAlgorithm:(HUBDiffAlgorithm)algorithm
+{
+    NSArray<id<HUBComponentModel>> *firstComponents = @[
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-1" customData:nil],
+        [self componentModelWithIdentifier:@"carousel" customData:nil childIdentifiers:@[@"child-1", @"child-2", @"child-3"]]
+    ];
+    id<HUBViewModel> firstViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test"
+                                                                                components:firstComponents];
+    id<HUBComponentModel> const carousel = [self componentModelWithIdentifier:@"carousel" customData:nil childIdentifiers:@[@"child-1", @"child-3", @"child-4"]];
+    NSArray<id<HUBComponentModel>> *secondComponents = @[
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-1" customData:nil],
+        carousel
+    ];
+    id<HUBViewModel> secondViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test"
+                                                                                 components:secondComponents];
+
+    HUBViewModelDiff *diff = [HUBViewModelDiff diffFromViewModel:firstViewModel toViewModel:secondViewModel algorithm:algorithm];
+    NSIndexPath * const carouselIndexPath = [NSIndexPath indexPathForItem:1 inSection:0];
+    XCTAssertEqualObjects(diff.reloadedBodyComponentIndexPaths, @[carouselIndexPath]);
+    XCTAssertEqual(diff.childComponentDiffs.count, 1u);
+
+    HUBViewModelDiff *childDiff = diff.childComponentDiffs[carouselIndexPath];
+    XCTAssertEqual(childDiff.parentComponentModel, carousel);
+    XCTAssertEqualObjects(childDiff.deletedBodyComponentIndexPaths, @[[NSIndexPath indexPathForItem:1 inSection:0]]);
+    XCTAssertEqualObjects(childDiff.insertedBodyComponentIndexPaths, @[[NSIndexPath indexPathForItem:2 inSection:0]]);
+    XCTAssertEqual(childDiff.reloadedBodyComponentIndexPaths.count, 0u);
+    XCTAssertTrue(childDiff.hasChanges);
+}
+
+- (void)testChildChangesAreNotDiffedForModifiedParentMyers
+{
+    [self runChildChangesAreNotDiffedForModifiedParentTestWithAlgorithm:HUBDiffMyersAlgorithm];
+}
+
+- (void)testChildChangesAreNotDiffedForModifiedParentHeckel
+{
+    [self runChildChangesAreNotDiffedForModifiedParentTestWithAlgorithm:HUBDiffHeckelAlgorithm];
+}
+
+- (void)runChildChangesAreNotDiffedForModifiedParentTestWithAlgorithm:(HUBDiffAlgorithm)algorithm
+{
+    NSArray<id<HUBComponentModel>> *firstComponents = @[
+        [self componentModelWithIdentifier:@"carousel" customData:nil childIdentifiers:@[@"child-1", @"child-2"]]
+    ];
+    id<HUBViewModel> firstViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test"
+                                                                                components:firstComponents];
+    NSArray<id<HUBComponentModel>> *secondComponents = @[
+        [self componentModelWithIdentifier:@"carousel" customData:@{@"test": @1} childIdentifiers:@[@"child-2"]]
+    ];
+    id<HUBViewModel> secondViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test"
+                                                                                 components:secondComponents];
+
+    HUBViewModelDiff *diff = [HUBViewModelDiff diffFromViewModel:firstViewModel toViewModel:secondViewModel algorithm:algorithm];
+    XCTAssertEqualObjects(diff.reloadedBodyComponentIndexPaths, @[[NSIndexPath indexPathForItem:0 inSection:0]]);
+    XCTAssertEqual(diff.childComponentDiffs.count, 0u);
+}
+
+#pragma mark - Overlay changes tests
+
+- (id<HUBViewModel>)viewModelWithOverlayComponents:(NSArray<id<HUBComponentModel>> *)overlayComponents
+{
+    return [[HUBViewModelImplementation alloc] initWithIdentifier:@"Test"
+                                                   navigationItem:nil
+                                             headerComponentModel:nil
+                                              bodyComponentModels:@[]
+                                           overlayComponentModels:overlayComponents
+                                                       customData:nil];
+}
+
+- (void)testOverlayChanges
+{
+    id<HUBViewModel> const fromViewModel = [self viewModelWithOverlayComponents:@[
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"overlay-1" customData:nil],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"overlay-2" customData:nil]
+    ]];
+    id<HUBViewModel> const toViewModel = [self viewModelWithOverlayComponents:@[
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"overlay-1" customData:nil],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"overlay-2" customData:@{@"test": @1}],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"overlay-3" customData:nil]
+    ]];
+
+    HUBViewModelDiff *diff = [HUBViewModelDiff diffFromViewModel:fromViewModel toViewModel:toViewModel];
+    XCTAssertEqualObjects(diff.reloadedOverlayComponentIndexes, [NSIndexSet indexSetWithIndex:1]);
+    XCTAssertEqualObjects(diff.insertedOverlayComponentIndexes, [NSIndexSet indexSetWithIndex:2]);
+    XCTAssertEqual(diff.deletedOverlayComponentIndexes.count, 0u);
+
+    HUBViewModelDiff *reverseDiff = [HUBViewModelDiff diffFromViewModel:toViewModel toViewModel:fromViewModel];
+    XCTAssertEqualObjects(reverseDiff.deletedOverlayComponentIndexes, [NSIndexSet indexSetWithIndex:2]);
+    XCTAssertEqual(reverseDiff.insertedOverlayComponentIndexes.count, 0u);
+}
+
 #pragma mark - Header changes tests
 
 - (id<HUBViewModel>)viewModelWithHeaderComponentName:(NSString *)headerComponentIdentifierName
@@ -359,4 +775,48 @@
     XCTAssertTrue(diff.hasChanges);
 }
 
+#pragma mark - Performance tests
+
+- (void)testMyersPerformanceWithTenThousandComponents
+{
+    [self runPerformanceTestWithAlgorithm:HUBDiffMyersAlgorithm componentCount:10000];
+}
+
+- (void)testHeckelPerformanceWithTenThousandComponents
+{
+    [self runPerformanceTestWithAlgorithm:HUBDiffHeckelAlgorithm componentCount:10000];
+}
+
+// The LCS algorithm is left out, since its O(N * M) matrix doesn't fit in memory for models of this size.
+- (void)runPerformanceTestWithAlgorithm:(HUBDiffAlgorithm)algorithm componentCount:(NSUInteger)componentCount
+{
+    NSMutableArray<id<HUBComponentModel>> *firstComponents = [NSMutableArray arrayWithCapacity:componentCount];
+    NSMutableArray<id<HUBComponentModel>> *secondComponents = [NSMutableArray arrayWithCapacity:componentCount];
+
+    // Every 100th component is removed and replaced by a new one, and every 50th component is modified.
+    for (NSUInteger index = 0; index < componentCount; index++) {
+        NSString * const identifier = [NSString stringWithFormat:@"component-%@", @(index)];
+        [firstComponents addObject:[HUBViewModelUtilities createComponentModelWithIdentifier:identifier customData:nil]];
+
+        if (index % 100 == 0) {
+            NSString * const newIdentifier = [NSString stringWithFormat:@"new-component-%@", @(index)];
+            [secondComponents addObject:[HUBViewModelUtilities createComponentModelWithIdentifier:newIdentifier customData:nil]];
+        } else if (index % 50 == 0) {
+            [secondComponents addObject:[HUBViewModelUtilities createComponentModelWithIdentifier:identifier customData:@{@"test": @1}]];
+        } else {
+            [secondComponents addObject:[HUBViewModelUtilities createComponentModelWithIdentifier:identifier customData:nil]];
+        }
+    }
+
+    id<HUBViewModel> firstViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test" components:firstComponents];
+    id<HUBViewModel> secondViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test" components:secondComponents];
+
+    [self measureBlock:^{
+        HUBViewModelDiff *diff = [HUBViewModelDiff diffFromViewModel:firstViewModel toViewModel:secondViewModel algorithm:algorithm];
+        XCTAssertEqual(diff.insertedBodyComponentIndexPaths.count, componentCount / 100);
+        XCTAssertEqual(diff.deletedBodyComponentIndexPaths.count, componentCount / 100);
+        XCTAssertEqual(diff.reloadedBodyComponentIndexPaths.count, componentCount / 100);
+    }];
+}
+
 @end
@@ -28,12 +28,18 @@
 #import "HUBViewModelRenderer.h"
 #import "HUBViewModelUtilities.h"
 
+@interface HUBViewModelRenderer (HUBExposeInternalsForTesting)
+
+@property (nonatomic, strong, readonly) dispatch_queue_t diffQueue;
+
+@end
+
 /**
  *  We don't want these tests to be concerned with the inner workings of the batch update process, as this invokes
  *  a lot of collection view logic that over-complicates the test (e.g. checking that the items rendered before
  *  the batch update tallies with the number of items after the batch update).
  *
- *  To get around this, we override the insert, delete and reload methods to do nothing.
+ *  To get around this, we override the insert, delete, reload and move methods to do nothing.
  */
 @interface HUBCollectionViewMockWithoutBatchUpdates : HUBCollectionViewMock
 
@@ -53,6 +59,10 @@
 {
 }
 
+- (void)moveItemAtIndexPath:(NSIndexPath *)indexPath toIndexPath:(NSIndexPath *)newIndexPath
+{
+}
+
 @end
 
 @interface HUBViewModelRendererTests : XCTestCase
@@ -98,9 +108,9 @@
 
     __weak XCTestExpectation * const expectation = [self expectationWithDescription:@"Waiting for render"];
 
-    [self.viewModelRenderer renderViewModel:firstViewModel inCollectionView:self.collectionView usingBatchUpdates:YES animated:YES addHeaderMargin:YES completion:^{
+    [self.viewModelRenderer renderViewModel:firstViewModel inCollectionView:self.collectionView usingBatchUpdates:YES animated:YES addHeaderMargin:YES completion:^(BOOL rendered) {
         // Immediately trigger another render.
-        [self.viewModelRenderer renderViewModel:secondViewModel inCollectionView:self.collectionView usingBatchUpdates:YES animated:YES addHeaderMargin:YES completion:^{
+        [self.viewModelRenderer renderViewModel:secondViewModel inCollectionView:self.collectionView usingBatchUpdates:YES animated:YES addHeaderMargin:YES completion:^(BOOL rendered) {
             [expectation fulfill];
         }];
     }];
@@ -123,4 +133,157 @@
     XCTAssertEqual(diff.reloadedBodyComponentIndexPaths.count, 0u);
 }
 
+- (void)testCollectionViewIsReloadedWhenDiffExceedsMaximumChangedFraction
+{
+    NSArray<id<HUBComponentModel>> *firstComponents = @[
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-1" customData:nil],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-2" customData:nil],
+    ];
+    id<HUBViewModel> firstViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test" components:firstComponents];
+
+    NSArray<id<HUBComponentModel>> *secondComponents = @[
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-3" customData:nil],
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-2" customData:nil],
+    ];
+    id<HUBViewModel> secondViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test2" components:secondComponents];
+
+    self.viewModelRenderer.maximumChangedFraction = 0.25;
+
+    __weak XCTestExpectation * const expectation = [self expectationWithDescription:@"Waiting for render"];
+
+    [self.viewModelRenderer renderViewModel:firstViewModel inCollectionView:self.collectionView usingBatchUpdates:YES animated:NO addHeaderMargin:YES completion:^(BOOL rendered) {
+        XCTAssertEqual(self.viewModelRenderer.lastRenderMode, HUBViewModelRenderModeReload);
+
+        [self.viewModelRenderer renderViewModel:secondViewModel inCollectionView:self.collectionView usingBatchUpdates:YES animated:NO addHeaderMargin:YES completion:^(BOOL rendered) {
+            [expectation fulfill];
+        }];
+    }];
+
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+
+    // Replacing one out of two components exceeds the maximum fraction, so no diff should be used
+    XCTAssertEqual(self.viewModelRenderer.lastRenderMode, HUBViewModelRenderModeReloadForExceededDiffBudget);
+    XCTAssertEqual([self.collectionViewLayout numberOfInvocations], 2u);
+    XCTAssertEqualObjects([self.collectionViewLayout capturedViewModelDiffAtIndex:1], [NSNull null]);
+}
+
+- (void)testRenderModeIsReloadWithoutBatchUpdatesWhenDiffExceedsMaximumChangedFraction
+{
+    NSArray<id<HUBComponentModel>> *firstComponents = @[
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-1" customData:nil],
+    ];
+    id<HUBViewModel> firstViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test" components:firstComponents];
+
+    NSArray<id<HUBComponentModel>> *secondComponents = @[
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-2" customData:nil],
+    ];
+    id<HUBViewModel> secondViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test2" components:secondComponents];
+
+    self.viewModelRenderer.maximumChangedFraction = 0.25;
+
+    [self.viewModelRenderer renderViewModel:firstViewModel inCollectionView:self.collectionView usingBatchUpdates:NO animated:NO addHeaderMargin:YES completion:^(BOOL rendered) {}];
+    [self.viewModelRenderer renderViewModel:secondViewModel inCollectionView:self.collectionView usingBatchUpdates:NO animated:NO addHeaderMargin:YES completion:^(BOOL rendered) {}];
+
+    // The collection view is reloaded regardless of the budget when batch updates aren't used
+    XCTAssertEqual(self.viewModelRenderer.lastRenderMode, HUBViewModelRenderModeReload);
+}
+
+- (void)testStaleDiffIsDiscardedWhenNewerViewModelIsRendered
+{
+    NSArray<id<HUBComponentModel>> *firstComponents = @[
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-1" customData:nil],
+    ];
+    id<HUBViewModel> firstViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test" components:firstComponents];
+
+    NSArray<id<HUBComponentModel>> *secondComponents = @[
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-2" customData:nil],
+    ];
+    id<HUBViewModel> secondViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test2" components:secondComponents];
+
+    NSArray<id<HUBComponentModel>> *thirdComponents = @[
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-3" customData:nil],
+    ];
+    id<HUBViewModel> thirdViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test3" components:thirdComponents];
+
+    __weak XCTestExpectation * const secondExpectation = [self expectationWithDescription:@"Waiting for stale render"];
+    __weak XCTestExpectation * const thirdExpectation = [self expectationWithDescription:@"Waiting for render"];
+
+    [self.viewModelRenderer renderViewModel:firstViewModel inCollectionView:self.collectionView usingBatchUpdates:YES animated:NO addHeaderMargin:YES completion:^(BOOL rendered) {}];
+
+    // Render two view models before the diff of the first one has been calculated
+    [self.viewModelRenderer renderViewModel:secondViewModel inCollectionView:self.collectionView usingBatchUpdates:YES animated:NO addHeaderMargin:YES completion:^(BOOL rendered) {
+        XCTAssertFalse(rendered);
+        [secondExpectation fulfill];
+    }];
+
+    [self.viewModelRenderer renderViewModel:thirdViewModel inCollectionView:self.collectionView usingBatchUpdates:YES animated:NO addHeaderMargin:YES completion:^(BOOL rendered) {
+        XCTAssertTrue(rendered);
+        [thirdExpectation fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+
+    XCTAssertEqual([self.collectionViewLayout numberOfInvocations], 2u);
+    XCTAssertEqualObjects([self.collectionViewLayout capturedViewModelAtIndex:0], firstViewModel);
+    XCTAssertEqualObjects([self.collectionViewLayout capturedViewModelAtIndex:1], thirdViewModel);
+
+    // The applied diff should be calculated from the last view model that was actually rendered
+    HUBViewModelDiff *diff = [self.collectionViewLayout capturedViewModelDiffAtIndex:1];
+    XCTAssertEqual(diff.insertedBodyComponentIndexPaths.count, 1u);
+    XCTAssertEqual(diff.deletedBodyComponentIndexPaths.count, 1u);
+}
+
+- (void)testDiscardingPendingRender
+{
+    NSArray<id<HUBComponentModel>> *firstComponents = @[
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-1" customData:nil],
+    ];
+    id<HUBViewModel> firstViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test" components:firstComponents];
+
+    NSArray<id<HUBComponentModel>> *secondComponents = @[
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-2" customData:nil],
+    ];
+    id<HUBViewModel> secondViewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test2" components:secondComponents];
+
+    [self.viewModelRenderer renderViewModel:firstViewModel inCollectionView:self.collectionView usingBatchUpdates:YES animated:NO addHeaderMargin:YES completion:^(BOOL rendered) {}];
+
+    __block BOOL completionCalled = NO;
+    [self.viewModelRenderer renderViewModel:secondViewModel inCollectionView:self.collectionView usingBatchUpdates:YES animated:NO addHeaderMargin:YES completion:^(BOOL rendered) {
+        XCTAssertFalse(rendered);
+        completionCalled = YES;
+    }];
+
+    [self.viewModelRenderer discardPendingRender];
+    XCTAssertTrue(completionCalled);
+
+    // Wait for the discarded diff to arrive on the main queue, where it should be ignored
+    __weak XCTestExpectation * const expectation = [self expectationWithDescription:@"Waiting for diff"];
+    dispatch_async(self.viewModelRenderer.diffQueue, ^{
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [expectation fulfill];
+        });
+    });
+    [self waitForExpectationsWithTimeout:2 handler:nil];
+
+    XCTAssertEqual([self.collectionViewLayout numberOfInvocations], 1u);
+}
+
+- (void)testRenderingSameViewModelAgainIsSynchronous
+{
+    NSArray<id<HUBComponentModel>> *components = @[
+        [HUBViewModelUtilities createComponentModelWithIdentifier:@"component-1" customData:nil],
+    ];
+    id<HUBViewModel> viewModel = [HUBViewModelUtilities createViewModelWithIdentifier:@"Test" components:components];
+
+    [self.viewModelRenderer renderViewModel:viewModel inCollectionView:self.collectionView usingBatchUpdates:YES animated:NO addHeaderMargin:YES completion:^(BOOL rendered) {}];
+
+    __block BOOL rendered = NO;
+    [self.viewModelRenderer renderViewModel:viewModel inCollectionView:self.collectionView usingBatchUpdates:YES animated:NO addHeaderMargin:YES completion:^(BOOL didRender) {
+        rendered = didRender;
+    }];
+
+    XCTAssertTrue(rendered);
+    XCTAssertEqual([self.collectionViewLayout numberOfInvocations], 2u);
+}
+
 @end
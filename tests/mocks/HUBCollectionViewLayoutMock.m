@@ -55,6 +55,15 @@ NS_ASSUME_NONNULL_BEGIN
     [self.capturedViewModelDiffs addObject:nonNullDiff];
 }
 
+- (nullable HUBCollectionViewLayoutCalculator *)backgroundCalculatorForCollectionViewSize:(CGSize)collectionViewSize
+                                                                                viewModel:(id<HUBViewModel>)viewModel
+                                                                        previousViewModel:(nullable id<HUBViewModel>)previousViewModel
+                                                                          addHeaderMargin:(BOOL)addHeaderMargin
+{
+    // Always compute the layout on the main queue, so that all computations are captured
+    return nil;
+}
+
 - (NSUInteger)numberOfInvocations
 {
     return self.capturedViewModels.count;
@@ -79,6 +79,9 @@ NS_ASSUME_NONNULL_BEGIN
 /// The data for any background image the component is currently displaying
 @property (nonatomic, strong, readonly, nullable) id<HUBComponentImageData> backgroundImageData;
 
+/// The number of times `preferredViewSizeForDisplayingModel:containerViewSize:` has been called on this component
+@property (nonatomic, readonly) NSUInteger numberOfPreferredViewSizeRequests;
+
 /// The number of times `viewDidResize` has been called on this component
 @property (nonatomic, readonly) NSUInteger numberOfResizes;
 
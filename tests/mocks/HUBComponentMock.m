@@ -28,6 +28,7 @@
 @property (nonatomic, strong, readwrite, nullable) id<HUBComponentModel> model;
 @property (nonatomic, strong, readwrite, nullable) id<HUBComponentImageData> mainImageData;
 @property (nonatomic, strong, readwrite, nullable) id<HUBComponentImageData> backgroundImageData;
+@property (nonatomic, readwrite) NSUInteger numberOfPreferredViewSizeRequests;
 @property (nonatomic, readwrite) NSUInteger numberOfResizes;
 @property (nonatomic, readwrite) NSUInteger numberOfAppearances;
 @property (nonatomic, readwrite) NSUInteger numberOfReuses;
@@ -74,6 +75,7 @@
 
 - (CGSize)preferredViewSizeForDisplayingModel:(id<HUBComponentModel>)model containerViewSize:(CGSize)containerViewSize
 {
+    self.numberOfPreferredViewSizeRequests++;
     return self.preferredViewSize;
 }
 
@@ -0,0 +1,42 @@
+/*
+ *  Copyright (c) 2016 Spotify AB.
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Utility used by benchmarks to count the heap allocations made by a piece of code
+@interface HUBAllocationCounter : NSObject
+
+/**
+ *  Count the heap allocations made by the calling thread while performing a block
+ *
+ *  @param block The block to perform
+ *
+ *  Every `malloc`, `calloc`, `realloc` and `valloc` call made by the calling thread is counted, including those for
+ *  memory that is freed again before the block returns. Allocations made by other threads are not counted, and
+ *  neither are any made by the caller before or after the block, such as for objects that the caller retains.
+ */
++ (NSUInteger)countAllocationsInBlock:(void(^)(void))block;
+
+@end
+
+NS_ASSUME_NONNULL_END
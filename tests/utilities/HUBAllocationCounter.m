@@ -0,0 +1,69 @@
+/*
+ *  Copyright (c) 2016 Spotify AB.
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ */
+
+#import "HUBAllocationCounter.h"
+
+#import <pthread.h>
+#import <stdatomic.h>
+
+/// The type of the hook that libmalloc calls for every allocation and deallocation
+typedef void (HUBMallocLogger)(uint32_t type, uintptr_t arg1, uintptr_t arg2, uintptr_t arg3, uintptr_t result, uint32_t numberOfHotFramesToSkip);
+
+/// The hook itself, which is also used by malloc stack logging. Exported by libmalloc, but not declared in its headers.
+extern HUBMallocLogger * _Nullable malloc_logger;
+
+/// The flag that libmalloc sets in the type passed to the hook for allocations, including reallocations
+static uint32_t const HUBMallocLogTypeAllocate = 2;
+
+static HUBMallocLogger * _Nullable HUBAllocationCounterPreviousLogger;
+static pthread_t HUBAllocationCounterThread;
+static _Atomic(NSUInteger) HUBAllocationCounterCount;
+
+/// Called on the allocating thread, sometimes with a malloc zone locked, so it must not allocate itself
+static void HUBAllocationCounterLogger(uint32_t type, uintptr_t arg1, uintptr_t arg2, uintptr_t arg3, uintptr_t result, uint32_t numberOfHotFramesToSkip)
+{
+    if ((type & HUBMallocLogTypeAllocate) != 0 && pthread_equal(pthread_self(), HUBAllocationCounterThread)) {
+        atomic_fetch_add_explicit(&HUBAllocationCounterCount, 1, memory_order_relaxed);
+    }
+
+    if (HUBAllocationCounterPreviousLogger != NULL) {
+        HUBAllocationCounterPreviousLogger(type, arg1, arg2, arg3, result, numberOfHotFramesToSkip + 1);
+    }
+}
+
+@implementation HUBAllocationCounter
+
++ (NSUInteger)countAllocationsInBlock:(void(^)(void))block
+{
+    NSAssert(malloc_logger != HUBAllocationCounterLogger, @"Allocations can't be counted by nested blocks");
+
+    HUBAllocationCounterThread = pthread_self();
+    HUBAllocationCounterPreviousLogger = malloc_logger;
+    atomic_store_explicit(&HUBAllocationCounterCount, 0, memory_order_relaxed);
+
+    malloc_logger = HUBAllocationCounterLogger;
+    block();
+    malloc_logger = HUBAllocationCounterPreviousLogger;
+
+    return atomic_load_explicit(&HUBAllocationCounterCount, memory_order_relaxed);
+}
+
+@end